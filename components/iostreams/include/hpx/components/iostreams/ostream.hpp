@@ -16,11 +16,14 @@
 #include <hpx/components/iostreams/server/output_stream.hpp>
 #include <hpx/lock_registration/detail/register_locks.hpp>
 #include <hpx/modules/async_distributed.hpp>
+#include <hpx/synchronization/condition_variable.hpp>
 #include <hpx/type_support/unused.hpp>
 
 #include <boost/iostreams/stream.hpp>
 
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <ios>
 #include <iterator>
@@ -153,6 +156,17 @@ namespace hpx { namespace iostreams {
             release_ostream(get_outstream_name(tag), id);
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // Output aggregation: if enabled (hpx.iostreams.aggregation_size is
+        // not zero), asynchronously flushed output is not sent to the console
+        // right away. Instead it is collected on the sending locality until
+        // either the given number of bytes have been buffered or the
+        // aggregation interval (hpx.iostreams.aggregation_interval, in
+        // microseconds) has expired. The console reassembles the batches
+        // based on their per-locality sequence numbers.
+        HPX_IOSTREAMS_EXPORT std::size_t get_aggregation_size();
+        HPX_IOSTREAMS_EXPORT std::int64_t get_aggregation_interval();
+
         ///////////////////////////////////////////////////////////////////////
         void register_ostreams();
         void unregister_ostreams();
@@ -184,6 +198,92 @@ namespace hpx { namespace iostreams {
         using detail::buffer::mtx_;
         std::atomic<std::uint64_t> generational_count_;
 
+        // output aggregation settings, protected by mtx_
+        std::size_t aggregation_size_;
+        std::int64_t aggregation_interval_;
+        bool aggregated_flush_scheduled_;
+
+        // wakes up the pending aggregated flush once the buffered data has
+        // been sent or aggregation has been disabled
+        hpx::condition_variable_any aggregated_flush_cond_;
+
+        // Send the currently buffered data asynchronously to the console,
+        // unlocks the given lock.
+        template <typename Lock>
+        void send_async(Lock& l)
+        {
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+            // Create the next buffer, returns the previous buffer
+            buffer next = this->detail::buffer::init_locked();
+
+            // the pending aggregated flush has nothing left to do
+            if (aggregated_flush_scheduled_)
+            {
+                aggregated_flush_cond_.notify_all();
+            }
+
+            // Unlock the mutex before we cleanup.
+            l.unlock();
+
+            // since mtx_ is recursive and apply will do an AGAS lookup,
+            // we need to ignore the lock here in case we are called
+            // recursively
+            hpx::util::ignore_while_checking il(&l);
+            HPX_UNUSED(il);
+
+            // Perform the write operation, then destroy the old buffer and
+            // stream.
+            typedef server::output_stream::write_async_action action_type;
+            hpx::apply<action_type>(this->get_id(), hpx::get_locality_id(),
+                generational_count_++, next);
+#else
+            HPX_ASSERT(false);
+            HPX_UNUSED(l);
+#endif
+        }
+
+        // Decide whether the buffered data should be sent right away. If
+        // output aggregation is enabled this holds back the data until
+        // enough of it was collected, making sure that it will be sent after
+        // the aggregation interval at the latest.
+        bool send_now_locked()
+        {
+            if (aggregation_size_ == 0 ||
+                this->detail::buffer::size_locked() >= aggregation_size_)
+            {
+                return true;
+            }
+
+            if (!aggregated_flush_scheduled_)
+            {
+                aggregated_flush_scheduled_ = true;
+                hpx::apply(&ostream::aggregated_flush, this);
+            }
+            return false;
+        }
+
+        // Executed as a separate HPX thread, sends the buffered data once the
+        // aggregation interval has expired. Returns early if the data was
+        // sent in the meantime or if the stream is being uninitialized.
+        void aggregated_flush()
+        {
+            std::unique_lock<mutex_type> l(*mtx_);
+            aggregated_flush_cond_.wait_for(l,
+                std::chrono::microseconds(aggregation_interval_), [this]() {
+                    return aggregation_size_ == 0 ||
+                        this->detail::buffer::empty_locked();
+                });
+
+            aggregated_flush_scheduled_ = false;
+
+            // aggregation is disabled once the stream is being uninitialized
+            if (aggregation_size_ != 0 &&
+                !this->detail::buffer::empty_locked())
+            {
+                send_async(l);    // unlocks
+            }
+        }
+
         // Performs a lazy streaming operation.
         template <typename T>
         ostream& streaming_operator_lazy(T const& subject)
@@ -203,19 +303,9 @@ namespace hpx { namespace iostreams {
 
             // If the buffer isn't empty, send it asynchronously to the
             // destination.
-            if (!this->detail::buffer::empty_locked())
+            if (!this->detail::buffer::empty_locked() && send_now_locked())
             {
-                // Create the next buffer, returns the previous buffer
-                buffer next = this->detail::buffer::init_locked();
-
-                // Unlock the mutex before we cleanup.
-                l.unlock();
-
-                // Perform the write operation, then destroy the old buffer and
-                // stream.
-                typedef server::output_stream::write_async_action action_type;
-                hpx::apply<action_type>(this->get_id(), hpx::get_locality_id(),
-                    generational_count_++, next);
+                send_async(l);    // unlocks
             }
 #else
             HPX_ASSERT(false);
@@ -264,25 +354,9 @@ namespace hpx { namespace iostreams {
         {
 #if !defined(HPX_COMPUTE_DEVICE_CODE)
             std::unique_lock<mutex_type> l(*mtx_);
-            if (!this->detail::buffer::empty_locked())
+            if (!this->detail::buffer::empty_locked() && send_now_locked())
             {
-                // Create the next buffer, returns the previous buffer
-                buffer next = this->detail::buffer::init_locked();
-
-                // Unlock the mutex before we cleanup.
-                l.unlock();
-
-                // since mtx_ is recursive and apply will do an AGAS lookup,
-                // we need to ignore the lock here in case we are called
-                // recursively
-                hpx::util::ignore_while_checking il(&l);
-                HPX_UNUSED(il);
-
-                // Perform the write operation, then destroy the old buffer and
-                // stream.
-                typedef server::output_stream::write_async_action action_type;
-                hpx::apply<action_type>(this->get_id(), hpx::get_locality_id(),
-                    generational_count_++, next);
+                send_async(l);    // unlocks
             }
             return true;
 #else
@@ -300,18 +374,27 @@ namespace hpx { namespace iostreams {
         void initialize(Tag tag)
         {
             *static_cast<base_type*>(this) = detail::create_ostream(tag);
+
+            std::lock_guard<mutex_type> l(*mtx_);
+            aggregation_size_ = detail::get_aggregation_size();
+            aggregation_interval_ = detail::get_aggregation_interval();
         }
 
         // reset this object during runtime system shutdown
         template <typename Tag>
         void uninitialize(Tag tag)
         {
-            std::unique_lock<mutex_type> l(*mtx_, std::try_to_lock);
-            if (l)
-            {
-                streaming_operator_sync(
-                    hpx::iostreams::flush_type(), l);    // unlocks
-            }
+            // the lock is acquired unconditionally, otherwise aggregated
+            // output could be lost
+            std::unique_lock<mutex_type> l(*mtx_);
+
+            // stop aggregating output, the synchronous flush below sends
+            // everything that is still buffered
+            aggregation_size_ = 0;
+            aggregated_flush_cond_.notify_all();
+
+            streaming_operator_sync(
+                hpx::iostreams::flush_type(), l);    // unlocks
 
             // FIXME: find a later spot to invoke this
             detail::release_ostream(tag, this->get_id());
@@ -324,6 +407,9 @@ namespace hpx { namespace iostreams {
           , buffer()
           , stream_base_type(*this)
           , generational_count_(0)
+          , aggregation_size_(0)
+          , aggregation_interval_(0)
+          , aggregated_flush_scheduled_(false)
         {
         }
 
@@ -13,6 +13,7 @@
 #include <hpx/components/iostreams/export_definitions.hpp>
 #include <hpx/components/iostreams/write_functions.hpp>
 
+#include <cstddef>
 #include <iosfwd>
 #include <memory>
 #include <mutex>
@@ -75,6 +76,11 @@ namespace hpx { namespace iostreams { namespace detail {
             return !data_.get() || data_->empty();
         }
 
+        std::size_t size_locked() const
+        {
+            return data_.get() ? data_->size() : 0;
+        }
+
         buffer init()
         {
             std::lock_guard<mutex_type> l(*mtx_);
@@ -15,10 +15,14 @@
 #include <hpx/functional/bind_back.hpp>
 #include <hpx/modules/execution.hpp>
 #include <hpx/runtime_distributed/runtime_fwd.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
+#include <hpx/util/from_string.hpp>
 
 #include <hpx/components/iostreams/ostream.hpp>
 #include <hpx/components/iostreams/standard_streams.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <sstream>
@@ -74,6 +78,21 @@ namespace hpx { namespace iostreams { namespace detail {
         return agas::on_symbol_namespace_event(cout_name, true);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t get_aggregation_size()
+    {
+        return hpx::util::from_string<std::size_t>(
+            get_config_entry("hpx.iostreams.aggregation_size", "0"),
+            std::size_t(0));
+    }
+
+    std::int64_t get_aggregation_interval()
+    {
+        return hpx::util::from_string<std::int64_t>(
+            get_config_entry("hpx.iostreams.aggregation_interval", "10000"),
+            std::int64_t(10000));
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     void release_ostream(char const* name, hpx::id_type const& /* id */)
     {
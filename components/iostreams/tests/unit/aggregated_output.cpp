@@ -0,0 +1,132 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that output written with output aggregation enabled arrives
+// completely and in order at the console.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/iostream.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+constexpr std::size_t num_lines = 1000;
+
+std::string expected_output(std::uint32_t locality_id)
+{
+    std::string result;
+    for (std::size_t i = 0; i != num_lines; ++i)
+    {
+        result += "locality " + std::to_string(locality_id) + ": line " +
+            std::to_string(i) + "\n";
+    }
+    return result;
+}
+
+std::uint32_t locality_id = std::uint32_t(-1);
+
+void worker()
+{
+    locality_id = hpx::get_locality_id();
+
+    for (std::size_t i = 0; i != num_lines; ++i)
+    {
+        // std::endl triggers an asynchronous flush which is subject to
+        // output aggregation
+        hpx::consolestream << "locality " << locality_id << ": line " << i
+                           << std::endl;
+    }
+
+    // any output still being aggregated is sent at the latest when the
+    // stream is uninitialized during shutdown
+    hpx::consolestream << std::flush;
+}
+HPX_PLAIN_ACTION(worker, worker_action)
+
+///////////////////////////////////////////////////////////////////////////////
+// set on the console only
+std::size_t num_localities = 0;
+
+void check_output()
+{
+    std::string const output = hpx::get_consolestream().str();
+
+    // output from different localities may be interleaved, but the output of
+    // each locality has to be complete and in order
+    std::size_t total_size = 0;
+    for (std::uint32_t l = 0; l != num_localities; ++l)
+    {
+        std::istringstream in(output);
+        std::string line;
+        std::string prefix = "locality " + std::to_string(l) + ": ";
+
+        std::string received;
+        while (std::getline(in, line))
+        {
+            if (line.compare(0, prefix.size(), prefix) == 0)
+            {
+                received += line + "\n";
+            }
+        }
+
+        std::string const expected = expected_output(l);
+        HPX_TEST_EQ(received, expected);
+        total_size += expected.size();
+    }
+
+    HPX_TEST_EQ(output.size(), total_size);
+}
+
+int hpx_main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    num_localities = localities.size();
+
+    std::vector<hpx::future<void>> futures;
+    futures.reserve(localities.size());
+    for (hpx::id_type const& l : localities)
+    {
+        futures.push_back(hpx::async(worker_action(), l));
+    }
+
+    hpx::wait_all(futures);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // enable output aggregation
+    std::vector<std::string> const cfg = {
+        "hpx.iostreams.aggregation_size=4096",
+        "hpx.iostreams.aggregation_interval=1000",
+    };
+
+    hpx::init_params init_args;
+    init_args.cfg = cfg;
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, init_args), 0,
+        "HPX main exited with non-zero status");
+
+    HPX_TEST_NEQ(std::uint32_t(-1), locality_id);
+
+    // all output has arrived at the console once the runtime has stopped
+    if (num_localities != 0)
+    {
+        check_output();
+    }
+
+    return hpx::util::report_errors();
+}
+#endif
@@ -78,4 +78,14 @@ namespace hpx { namespace execution { namespace experimental {
       : detail::property_base<get_annotation_t>
     {
     } get_annotation{};
+
+    inline constexpr struct with_bulk_affinity_t final
+      : detail::property_base<with_bulk_affinity_t>
+    {
+    } with_bulk_affinity{};
+
+    inline constexpr struct get_bulk_affinity_t final
+      : detail::property_base<get_bulk_affinity_t>
+    {
+    } get_bulk_affinity{};
 }}}    // namespace hpx::execution::experimental
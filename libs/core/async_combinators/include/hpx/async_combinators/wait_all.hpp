@@ -140,6 +140,7 @@ namespace hpx {
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <functional>
 #include <iterator>
@@ -254,73 +255,80 @@ namespace hpx {
             }
 
         protected:
-            // Current element is a range (vector or array) of futures
-            template <std::size_t I, typename Iter>
-            void await_range(Iter&& next, Iter&& end)
+            // Current element is a range (vector or array) of futures. All
+            // futures that are not ready yet are attached to at once, each
+            // with a callback that only captures this frame (which avoids
+            // allocating the callback). The last of those callbacks to run
+            // proceeds to the next argument.
+            template <std::size_t I>
+            void await_range()
             {
+                // the additional count prevents completing the range before
+                // all callbacks have been attached
+                pending_.store(1, std::memory_order_relaxed);
+
+                // keep this frame alive until the range is done
                 hpx::intrusive_ptr<wait_all_frame> this_(this);
-                for (/**/; next != end; ++next)
+
+                for (auto const& f :
+                    hpx::util::unwrap_ref(hpx::get<I>(t_)))
                 {
-                    auto next_future_data =
-                        hpx::traits::detail::get_shared_state(*next);
+                    auto const& next_future_data =
+                        hpx::traits::detail::get_shared_state(f);
 
-                    if (next_future_data)
+                    if (next_future_data && !next_future_data->is_ready())
                     {
+                        next_future_data->execute_deferred();
+
+                        // execute_deferred might have made the future ready
                         if (!next_future_data->is_ready())
                         {
-                            next_future_data->execute_deferred();
-
-                            // execute_deferred might have made the future ready
-                            if (!next_future_data->is_ready())
-                            {
-                                // Attach a continuation to this future which will
-                                // re-evaluate it and continue to the next element
-                                // in the sequence (if any).
-                                next_future_data->set_on_completed(
-                                    [this_ = HPX_MOVE(this_),
-                                        next = HPX_FORWARD(Iter, next),
-                                        end = HPX_FORWARD(
-                                            Iter, end)]() mutable -> void {
-                                        this_->template await_range<I>(
-                                            HPX_MOVE(next), HPX_MOVE(end));
-                                    });
-
-                                // explicitly destruct iterators as those might
-                                // become dangling after we make ourselves ready
-                                next = std::decay_t<Iter>{};
-                                end = std::decay_t<Iter>{};
-
-                                return;
-                            }
+                            pending_.fetch_add(1, std::memory_order_relaxed);
+                            next_future_data->set_on_completed(
+                                [this]() -> void {
+                                    this->template range_input_ready<I>();
+                                });
                         }
+                    }
+                }
 
-                        // check whether the current future is exceptional
-                        if (!has_exceptional_results_ &&
+                this_.detach();
+                range_input_ready<I>();
+            }
+
+            template <std::size_t I>
+            void range_input_ready()
+            {
+                if (pending_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                {
+                    return;
+                }
+
+                // release the reference acquired in await_range
+                hpx::intrusive_ptr<wait_all_frame> this_(this, false);
+
+                // all futures of the range are ready now, check whether any
+                // of them is exceptional
+                if (!has_exceptional_results_)
+                {
+                    for (auto const& f :
+                        hpx::util::unwrap_ref(hpx::get<I>(t_)))
+                    {
+                        auto const& next_future_data =
+                            hpx::traits::detail::get_shared_state(f);
+                        if (next_future_data &&
                             next_future_data->has_exception())
                         {
                             has_exceptional_results_ = true;
+                            break;
                         }
                     }
                 }
 
-                // explicitly destruct iterators as those might become dangling
-                // after we make ourselves ready
-                next = std::decay_t<Iter>{};
-                end = std::decay_t<Iter>{};
-
-                // All elements of the sequence are ready now, proceed to the
-                // next argument.
+                // proceed to the next argument
                 do_await<I + 1>();
             }
 
-            template <std::size_t I>
-            HPX_FORCEINLINE void await_range()
-            {
-                await_range<I>(
-                    hpx::util::begin(hpx::util::unwrap_ref(hpx::get<I>(t_))),
-                    hpx::util::end(hpx::util::unwrap_ref(hpx::get<I>(t_))));
-            }
-
             // Current element is a simple future
             template <std::size_t I>
             HPX_FORCEINLINE void await_future()
@@ -409,6 +417,7 @@ namespace hpx {
         private:
             Tuple const& t_;
             bool has_exceptional_results_ = false;
+            std::atomic<std::size_t> pending_;
         };
     }    // namespace detail
 
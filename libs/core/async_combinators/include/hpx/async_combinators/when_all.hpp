@@ -144,8 +144,10 @@ namespace hpx {
 #include <hpx/futures/traits/future_traits.hpp>
 #include <hpx/futures/traits/is_future.hpp>
 #include <hpx/futures/traits/is_future_range.hpp>
+#include <hpx/modules/memory.hpp>
 #include <hpx/pack_traversal/pack_traversal_async.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <iterator>
 #include <type_traits>
@@ -223,10 +225,90 @@ namespace hpx {
             }
         };
 
+        ///////////////////////////////////////////////////////////////////////
+        // Frame used for a single range of futures. Instead of traversing the
+        // range and attaching to one future after the other, this attaches to
+        // all futures that are not ready yet at once. Each of the attached
+        // callbacks captures only the frame, which avoids allocating them.
+        // An atomic countdown determines which callback completes the frame.
+        template <typename Range>
+        class when_all_range_frame : public future_data<Range>
+        {
+        public:
+            using base_type = hpx::lcos::detail::future_data<Range>;
+            using init_no_addref = typename base_type::init_no_addref;
+
+            explicit when_all_range_frame(Range&& values)
+              : base_type(init_no_addref{})
+              , values_(HPX_MOVE(values))
+              , pending_(1)
+            {
+            }
+
+            void attach()
+            {
+                // keep this frame alive until all futures are ready
+                hpx::intrusive_ptr<when_all_range_frame> this_(this);
+
+                for (auto const& f : values_)
+                {
+                    auto const& shared_state =
+                        hpx::traits::detail::get_shared_state(f);
+
+                    if (shared_state && !shared_state->is_ready())
+                    {
+                        shared_state->execute_deferred();
+
+                        // execute_deferred might have made the future ready
+                        if (!shared_state->is_ready())
+                        {
+                            pending_.fetch_add(1, std::memory_order_relaxed);
+                            shared_state->set_on_completed(
+                                [this]() -> void { input_ready(); });
+                        }
+                    }
+                }
+
+                // drop the count protecting against completing the frame
+                // while callbacks are being attached
+                this_.detach();
+                input_ready();
+            }
+
+        private:
+            void input_ready()
+            {
+                if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    // release the reference acquired in attach()
+                    hpx::intrusive_ptr<when_all_range_frame> this_(
+                        this, false);
+                    this->set_value(HPX_MOVE(values_));
+                }
+            }
+
+            Range values_;
+            std::atomic<std::size_t> pending_;
+        };
+
+        template <typename Range>
+        hpx::future<Range> when_all_range_impl(Range&& values)
+        {
+            using frame_type = when_all_range_frame<Range>;
+
+            // frame is initialized with initial reference count
+            hpx::intrusive_ptr<frame_type> frame(
+                new frame_type(HPX_MOVE(values)), false);
+            frame->attach();
+
+            return hpx::traits::future_access<hpx::future<Range>>::create(
+                HPX_MOVE(frame));
+        }
+
         template <typename... T>
         typename async_when_all_frame<
             hpx::tuple<hpx::traits::acquire_future_t<T>...>>::type
-        when_all_impl(T&&... args)
+        when_all_traverse_impl(T&&... args)
         {
             using result_type = hpx::tuple<hpx::traits::acquire_future_t<T>...>;
             using frame_type = async_when_all_frame<result_type>;
@@ -241,6 +323,26 @@ namespace hpx {
             return hpx::traits::future_access<
                 typename frame_type::type>::create(HPX_MOVE(frame));
         }
+
+        template <typename... T>
+        typename async_when_all_frame<
+            hpx::tuple<hpx::traits::acquire_future_t<T>...>>::type
+        when_all_impl(T&&... args)
+        {
+            if constexpr (sizeof...(T) == 1 &&
+                (hpx::traits::is_future_range_v<
+                     hpx::traits::acquire_future_t<T>> &&
+                    ...))
+            {
+                return when_all_range_impl(
+                    hpx::traits::acquire_future_disp()(
+                        HPX_FORWARD(T, args))...);
+            }
+            else
+            {
+                return when_all_traverse_impl(HPX_FORWARD(T, args)...);
+            }
+        }
     }}    // namespace lcos::detail
 
     ///////////////////////////////////////////////////////////////////////////
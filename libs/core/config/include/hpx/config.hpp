@@ -173,6 +173,37 @@
 #   define HPX_PARCEL_SERIALIZATION_OVERHEAD 512
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+// This defines the maximal size (in bytes) of the argument pack of an action
+// for which the transfer_action instances created while decoding parcels are
+// recycled through a thread-local cache instead of being allocated from the
+// heap.
+#if !defined(HPX_ACTIONS_SMALL_ARGUMENTS_SIZE)
+#   define HPX_ACTIONS_SMALL_ARGUMENTS_SIZE 64
+#endif
+
+// This defines the maximal number of cached transfer_action instances per
+// action type and OS-thread.
+#if !defined(HPX_ACTIONS_SMALL_OBJECT_CACHE_SIZE)
+#   define HPX_ACTIONS_SMALL_OBJECT_CACHE_SIZE 256
+#endif
+
+// This defines the maximal number of transfer_action instances per action
+// type which are kept in the pool shared by all OS-threads. This pool
+// receives the instances exceeding the capacity of the per-OS-thread caches.
+#if !defined(HPX_ACTIONS_SMALL_OBJECT_SHARED_CACHE_SIZE)
+#   define HPX_ACTIONS_SMALL_OBJECT_SHARED_CACHE_SIZE 4096
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// This defines the number of component slots a worker thread reserves at once
+// from the heap of a managed component type. Single component instances are
+// then carved out of this per-worker magazine without acquiring any of the
+// heap locks.
+#if !defined(HPX_COMPONENTS_HEAP_MAGAZINE_SIZE)
+#   define HPX_COMPONENTS_HEAP_MAGAZINE_SIZE 64
+#endif
+
 /// This defines the number of AGAS address translations kept in the local
 /// cache. This is just the initial size which may be adjusted depending on the
 /// load of the system (not implemented yet), etc. It must be a minimum of 3 for AGAS v3
@@ -193,6 +224,19 @@
 #  define HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS 4096
 #endif
 
+/// This defines the maximum time (in milliseconds) reference count decrements
+/// are buffered before being sent to AGAS (zero disables the time limit).
+///
+/// This value can be changes at runtime by setting the configuration parameter:
+///
+///   hpx.agas.max_pending_refcnt_delay = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_AGAS_MAX_PENDING_REFCNT_DELAY)
+#if !defined(HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_DELAY)
+#  define HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_DELAY 10
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 /// This defines the initial global reference count associated with any created
 /// object.
@@ -219,6 +263,13 @@
 #  define HPX_SPINLOCK_DEADLOCK_DETECTION_LIMIT 1073741823
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the maximal number of times hpx::mutex::lock will spin while
+/// the owner of the mutex is running before suspending the calling thread.
+#if !defined(HPX_MUTEX_MAX_SPIN_COUNT)
+#  define HPX_MUTEX_MAX_SPIN_COUNT 100
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 /// This defines the default number of coroutine heaps.
 #if !defined(HPX_COROUTINE_NUM_HEAPS)
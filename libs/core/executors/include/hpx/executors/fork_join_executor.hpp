@@ -24,13 +24,16 @@
 #include <hpx/synchronization/spinlock.hpp>
 #include <hpx/threading/thread.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <iosfwd>
+#include <iterator>
 #include <memory>
+#include <numeric>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -52,17 +55,40 @@ namespace hpx { namespace execution { namespace experimental {
     /// worker threads is a slow operation the executor should be reused
     /// whenever possible for multiple adjacent parallel algorithms or
     /// invocations of bulk_(a)sync_execute.
+    ///
+    /// By default the thread scheduling work through the executor starts
+    /// (forks) and waits for (joins) all worker threads directly. Constructing
+    /// the executor with barrier_kind::hierarchical instead forks and joins
+    /// through a tree that has one inner node per NUMA domain, which reduces
+    /// the amount of cross-domain traffic on machines with many cores.
     class fork_join_executor
     {
     public:
         /// Type of loop schedule for use with the fork_join_executor.
         /// loop_schedule::static_ implies no work-stealing;
         /// loop_schedule::dynamic allows stealing when a worker has finished
-        /// its local work.
+        /// its local work; loop_schedule::static_numa is like static_, but
+        /// assigns contiguous ranges of the iteration space to the worker
+        /// threads of each NUMA domain. The same ranges are assigned to the
+        /// same worker threads on every invocation, which allows relying on
+        /// first-touch placement of the data.
         enum class loop_schedule
         {
             static_,
             dynamic,
+            static_numa,
+        };
+
+        /// Type of the barrier used to fork and join the worker threads for
+        /// each parallel region. barrier_kind::flat signals and waits for all
+        /// worker threads from the calling thread; barrier_kind::hierarchical
+        /// signals and waits for one worker thread per NUMA domain, each of
+        /// which in turn signals and waits for the remaining worker threads
+        /// of its domain.
+        enum class barrier_kind
+        {
+            flat,
+            hierarchical,
         };
 
         /// \cond nointernal
@@ -109,6 +135,13 @@ namespace hpx { namespace execution { namespace experimental {
                 void* element_function_;
                 void const* shape_;
                 void* argument_pack_;
+
+                // Members that are fixed for the lifetime of the executor:
+                // the position of this thread in the partitioning of the
+                // iteration space, and the threads this thread forks and
+                // joins.
+                std::size_t rank_ = 0;
+                std::vector<std::size_t> children_;
             };
 
             // Can't apply 'using' here as the type needs to be forward
@@ -119,6 +152,9 @@ namespace hpx { namespace execution { namespace experimental {
                 using base_type =
                     std::vector<hpx::util::cache_aligned_data<region_data>>;
                 using base_type::base_type;
+
+                // inverse of region_data::rank_
+                std::vector<std::size_t> thread_by_rank_;
             };
 
             // Members that are used for all parallel regions executed through
@@ -129,8 +165,13 @@ namespace hpx { namespace execution { namespace experimental {
             threads::thread_stacksize stacksize_ =
                 threads::thread_stacksize::small_;
             loop_schedule schedule_ = loop_schedule::static_;
+            barrier_kind barrier_ = barrier_kind::flat;
             std::uint64_t yield_delay_;
 
+            // The NUMA domain of each worker thread, queried from the thread
+            // pool if empty.
+            std::vector<std::size_t> domains_;
+
             std::size_t main_thread_;
             std::size_t num_threads_;
             hpx::spinlock exception_mutex_;
@@ -177,6 +218,39 @@ namespace hpx { namespace execution { namespace experimental {
                 return current;
             }
 
+            // Hand the data of the current parallel region to all children
+            // of the given thread and signal them to start working.
+            static void fork_children(
+                region_data_type& rdata, region_data const& data) noexcept
+            {
+                for (std::size_t const child : data.children_)
+                {
+                    region_data& child_data = rdata[child].data_;
+
+                    child_data.element_function_ = data.element_function_;
+                    child_data.shape_ = data.shape_;
+                    child_data.argument_pack_ = data.argument_pack_;
+                    child_data.thread_function_helper_ =
+                        data.thread_function_helper_;
+
+                    child_data.state_.store(thread_state::partitioning_work,
+                        std::memory_order_release);
+                }
+            }
+
+            // Wait for all children of the given thread to finish the work
+            // assigned to them (and to their children) in the current
+            // parallel region.
+            static void join_children(region_data_type const& rdata,
+                region_data const& data, std::uint64_t yield_delay) noexcept
+            {
+                for (std::size_t const child : data.children_)
+                {
+                    wait_state_this_thread_while(rdata[child].data_.state_,
+                        thread_state::idle, yield_delay, std::not_equal_to<>());
+                }
+            }
+
             // Entry point for each worker HPX thread. Holds references to the
             // member variables of fork_join_executor.
             struct thread_function
@@ -220,10 +294,15 @@ namespace hpx { namespace execution { namespace experimental {
 
                     while (state != thread_state::stopping)
                     {
+                        fork_children(region_data_, data);
+
                         data.thread_function_helper_(region_data_,
                             thread_index_, num_threads_, queues_,
                             exception_mutex_, exception_);
 
+                        join_children(region_data_, data, yield_delay_);
+                        set_state_this_thread(thread_state::idle);
+
                         // wait as long the state is 'idle'
                         state = shared_data::wait_state_this_thread_while(
                             data.state_, thread_state::idle, yield_delay_,
@@ -262,6 +341,96 @@ namespace hpx { namespace execution { namespace experimental {
                 }
             }
 
+            // Determine the rank of each worker thread and the tree used to
+            // fork and join parallel regions.
+            void init_topology()
+            {
+                region_data_type::base_type& rdata = region_data_;
+                std::vector<std::size_t>& thread_by_rank =
+                    region_data_.thread_by_rank_;
+
+                thread_by_rank.resize(num_threads_);
+                std::iota(thread_by_rank.begin(), thread_by_rank.end(),
+                    std::size_t(0));
+
+                std::vector<std::size_t> domains(num_threads_, 0);
+                if (!domains_.empty())
+                {
+                    domains = domains_;
+                }
+                else if (schedule_ == loop_schedule::static_numa ||
+                    barrier_ == barrier_kind::hierarchical)
+                {
+                    for (std::size_t t = 0; t < num_threads_; ++t)
+                    {
+                        domains[t] = pool_->get_numa_domain(t);
+                    }
+                }
+
+                // Order the worker threads by NUMA domain, keeping their
+                // relative order inside of each domain.
+                std::vector<std::size_t> by_domain = thread_by_rank;
+                std::stable_sort(by_domain.begin(), by_domain.end(),
+                    [&](std::size_t lhs, std::size_t rhs) {
+                        return domains[lhs] < domains[rhs];
+                    });
+
+                if (schedule_ == loop_schedule::static_numa)
+                {
+                    thread_by_rank = by_domain;
+                }
+
+                for (std::size_t r = 0; r < num_threads_; ++r)
+                {
+                    rdata[thread_by_rank[r]].data_.rank_ = r;
+                }
+
+                region_data& main_data = rdata[main_thread_].data_;
+                if (barrier_ == barrier_kind::flat)
+                {
+                    for (std::size_t t = 0; t < num_threads_; ++t)
+                    {
+                        if (t != main_thread_)
+                        {
+                            main_data.children_.push_back(t);
+                        }
+                    }
+                    return;
+                }
+
+                // The first worker thread of each NUMA domain forks and joins
+                // the other worker threads of its domain. The main thread
+                // does so for its own domain and additionally forks and
+                // joins the first thread of every other domain. Remote
+                // domains are signalled first to get them going early.
+                std::vector<std::size_t> local_children;
+                auto it = by_domain.begin();
+                while (it != by_domain.end())
+                {
+                    std::size_t const domain = domains[*it];
+                    auto const end = std::find_if(it, by_domain.end(),
+                        [&](std::size_t t) { return domains[t] != domain; });
+
+                    if (std::find(it, end, main_thread_) != end)
+                    {
+                        std::copy_if(it, end,
+                            std::back_inserter(local_children),
+                            [&](std::size_t t) { return t != main_thread_; });
+                    }
+                    else
+                    {
+                        std::size_t const leader = *it;
+                        main_data.children_.push_back(leader);
+                        rdata[leader].data_.children_.assign(it + 1, end);
+                    }
+
+                    it = end;
+                }
+
+                main_data.children_.insert(main_data.children_.end(),
+                    local_children.begin(), local_children.end());
+            }
+
             void init_threads()
             {
                 main_thread_ = get_local_worker_thread_num();
@@ -271,6 +440,8 @@ namespace hpx { namespace execution { namespace experimental {
                     queues_.resize(num_threads_);
                 }
 
+                init_topology();
+
                 hpx::util::thread_description desc("fork_join_executor");
                 for (std::size_t t = 0; t < num_threads_; ++t)
                 {
@@ -298,32 +469,43 @@ namespace hpx { namespace execution { namespace experimental {
             }
 
             static constexpr void init_local_work_queue(queue_type& queue,
-                std::size_t thread_index, std::size_t num_threads,
+                std::size_t rank, std::size_t num_threads,
                 std::size_t size) noexcept
             {
-                auto const part_begin = static_cast<std::uint32_t>(
-                    (thread_index * size) / num_threads);
+                auto const part_begin =
+                    static_cast<std::uint32_t>((rank * size) / num_threads);
                 auto const part_end = static_cast<std::uint32_t>(
-                    ((thread_index + 1) * size) / num_threads);
+                    ((rank + 1) * size) / num_threads);
                 queue.reset(part_begin, part_end);
             }
 
         public:
             explicit shared_data(threads::thread_priority priority,
                 threads::thread_stacksize stacksize, loop_schedule schedule,
-                std::chrono::nanoseconds yield_delay)
+                std::chrono::nanoseconds yield_delay, barrier_kind barrier,
+                std::vector<std::size_t> domains = {})
               : pool_(this_thread::get_pool())
               , priority_(priority)
               , stacksize_(stacksize)
               , schedule_(schedule)
+              , barrier_(barrier)
               , yield_delay_(std::uint64_t(
                     yield_delay.count() / pool_->timestamp_scale()))
+              , domains_(HPX_MOVE(domains))
               , num_threads_(pool_->get_os_thread_count())
               , exception_mutex_()
               , exception_()
               , region_data_(num_threads_)
             {
                 HPX_ASSERT(pool_);
+                if (!domains_.empty() && domains_.size() != num_threads_)
+                {
+                    HPX_THROW_EXCEPTION(bad_parameter,
+                        "fork_join_executor::fork_join_executor",
+                        "The number of NUMA domains given ({}) does not match "
+                        "the number of worker threads ({})",
+                        domains_.size(), num_threads_);
+                }
                 init_threads();
             }
 
@@ -339,8 +521,9 @@ namespace hpx { namespace execution { namespace experimental {
             {
                 return pool_ == rhs.pool_ && priority_ == rhs.priority_ &&
                     stacksize_ == rhs.stacksize_ &&
-                    schedule_ == rhs.schedule_ &&
-                    yield_delay_ == rhs.yield_delay_;
+                    schedule_ == rhs.schedule_ && barrier_ == rhs.barrier_ &&
+                    yield_delay_ == rhs.yield_delay_ &&
+                    domains_ == rhs.domains_;
             }
 
             bool operator!=(shared_data const& rhs) const noexcept
@@ -397,11 +580,12 @@ namespace hpx { namespace execution { namespace experimental {
 
                         // Set up the local queues and state.
                         std::size_t size = hpx::util::size(shape);
+                        std::size_t const rank = data.rank_;
 
                         auto part_begin = static_cast<std::uint32_t>(
-                            (thread_index * size) / num_threads);
+                            (rank * size) / num_threads);
                         auto const part_end = static_cast<std::uint32_t>(
-                            ((thread_index + 1) * size) / num_threads);
+                            ((rank + 1) * size) / num_threads);
 
                         set_state(data.state_, thread_state::active);
 
@@ -422,8 +606,6 @@ namespace hpx { namespace execution { namespace experimental {
                             exception = std::current_exception();
                         }
                     }
-
-                    set_state(data.state_, thread_state::idle);
                 }
 
                 /// Main entry point for a single parallel region (dynamic
@@ -448,7 +630,7 @@ namespace hpx { namespace execution { namespace experimental {
                         queue_type& local_queue = queues[thread_index].data_;
                         std::size_t size = hpx::util::size(shape);
                         init_local_work_queue(
-                            local_queue, thread_index, num_threads, size);
+                            local_queue, data.rank_, num_threads, size);
 
                         set_state(data.state_, thread_state::active);
 
@@ -468,7 +650,8 @@ namespace hpx { namespace execution { namespace experimental {
                              ++offset)
                         {
                             std::size_t neighbor_index =
-                                (thread_index + offset) % num_threads;
+                                rdata.thread_by_rank_[(data.rank_ + offset) %
+                                    num_threads];
 
                             if (rdata[neighbor_index].data_.state_.load(
                                     std::memory_order_acquire) !=
@@ -497,18 +680,16 @@ namespace hpx { namespace execution { namespace experimental {
                             exception = std::current_exception();
                         }
                     }
-
-                    set_state(data.state_, thread_state::idle);
                 }
             };
 
             template <typename F, typename S, typename Args>
-            thread_function_helper_type* set_all_states_and_region_data(
+            thread_function_helper_type* set_main_thread_region_data(
                 thread_state state, F& f, S const& shape,
                 Args& argument_pack) noexcept
             {
                 thread_function_helper_type* func = nullptr;
-                if (schedule_ == loop_schedule::static_ || num_threads_ == 1)
+                if (schedule_ != loop_schedule::dynamic || num_threads_ == 1)
                 {
                     func = &thread_function_helper<F, S, Args>::call_static;
                 }
@@ -517,17 +698,15 @@ namespace hpx { namespace execution { namespace experimental {
                     func = &thread_function_helper<F, S, Args>::call_dynamic;
                 }
 
-                for (std::size_t t = 0; t < num_threads_; ++t)
-                {
-                    region_data& data = region_data_[t].data_;
+                region_data& data = region_data_[main_thread_].data_;
 
-                    data.element_function_ = &f;
-                    data.shape_ = &shape;
-                    data.argument_pack_ = &argument_pack;
-                    data.thread_function_helper_ = func;
+                data.element_function_ = &f;
+                data.shape_ = &shape;
+                data.argument_pack_ = &argument_pack;
+                data.thread_function_helper_ = func;
+
+                data.state_.store(state, std::memory_order_release);
 
-                    data.state_.store(state, std::memory_order_release);
-                }
                 return func;
             }
 
@@ -547,19 +726,27 @@ namespace hpx { namespace execution { namespace experimental {
                     hpx::forward_as_tuple(HPX_FORWARD(Ts, ts)...);
 
                 // Signal all worker threads to start partitioning work for
-                // themselves, and then starting the actual work.
+                // themselves, and then starting the actual work. Depending on
+                // the barrier this either reaches all worker threads directly
+                // or is propagated further by the children of this thread.
                 thread_function_helper_type* func =
-                    set_all_states_and_region_data(
+                    set_main_thread_region_data(
                         thread_state::partitioning_work, f, shape,
                         argument_pack);
 
+                region_data& data = region_data_[main_thread_].data_;
+                fork_children(region_data_, data);
+
                 // Start work on the main thread.
                 func(region_data_, main_thread_, num_threads_, queues_,
                     exception_mutex_, exception_);
 
+                data.state_.store(
+                    thread_state::idle, std::memory_order_release);
+
                 // Wait for all threads to finish their work assigned to
                 // them in this parallel region.
-                wait_state_all(thread_state::idle);
+                join_children(region_data_, data, yield_delay_);
 
                 std::lock_guard l(exception_mutex_);
                 if (exception_)
@@ -640,6 +827,29 @@ namespace hpx { namespace execution { namespace experimental {
                 threads::thread_stacksize::small_,
             loop_schedule schedule = loop_schedule::static_,
             std::chrono::nanoseconds yield_delay = std::chrono::milliseconds(1))
+          : fork_join_executor(
+                barrier_kind::flat, priority, stacksize, schedule, yield_delay)
+        {
+        }
+
+        /// \brief Construct a fork_join_executor using the given type of
+        ///        barrier to fork and join parallel regions.
+        ///
+        /// \param barrier The type of barrier used to fork and join the
+        ///                worker threads.
+        /// \param priority The priority of the worker threads.
+        /// \param stacksize The stacksize of the worker threads. Must not be
+        ///                  nostack.
+        /// \param schedule The loop schedule of the parallel regions.
+        /// \param yield_delay The time after which the executor yields to
+        ///        other work if it hasn't received any new work for bulk
+        ///        execution.
+        explicit fork_join_executor(barrier_kind barrier,
+            threads::thread_priority priority = threads::thread_priority::high,
+            threads::thread_stacksize stacksize =
+                threads::thread_stacksize::small_,
+            loop_schedule schedule = loop_schedule::static_,
+            std::chrono::nanoseconds yield_delay = std::chrono::milliseconds(1))
         {
             if (stacksize == threads::thread_stacksize::nostack)
             {
@@ -651,12 +861,52 @@ namespace hpx { namespace execution { namespace experimental {
             }
 
             shared_data_ = std::make_shared<shared_data>(
-                priority, stacksize, schedule, yield_delay);
+                priority, stacksize, schedule, yield_delay, barrier);
+        }
+
+        /// \brief Construct a fork_join_executor which groups the worker
+        ///        threads into the given NUMA domains instead of the ones
+        ///        reported by the thread pool.
+        ///
+        /// \param domains The NUMA domain of each worker thread of the
+        ///                current thread pool, used by the hierarchical
+        ///                barrier and by loop_schedule::static_numa.
+        /// \param barrier The type of barrier used to fork and join the
+        ///                worker threads.
+        /// \param priority The priority of the worker threads.
+        /// \param stacksize The stacksize of the worker threads. Must not be
+        ///                  nostack.
+        /// \param schedule The loop schedule of the parallel regions.
+        /// \param yield_delay The time after which the executor yields to
+        ///        other work if it hasn't received any new work for bulk
+        ///        execution.
+        fork_join_executor(std::vector<std::size_t> domains,
+            barrier_kind barrier,
+            threads::thread_priority priority = threads::thread_priority::high,
+            threads::thread_stacksize stacksize =
+                threads::thread_stacksize::small_,
+            loop_schedule schedule = loop_schedule::static_,
+            std::chrono::nanoseconds yield_delay = std::chrono::milliseconds(1))
+        {
+            if (stacksize == threads::thread_stacksize::nostack)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "fork_join_executor::fork_join_executor",
+                    "The fork_join_executor does not support using "
+                    "thread_stacksize::nostack as the stacksize (stackful "
+                    "threads are required to yield correctly when idle)");
+            }
+
+            shared_data_ = std::make_shared<shared_data>(priority, stacksize,
+                schedule, yield_delay, barrier, HPX_MOVE(domains));
         }
     };
 
     HPX_CORE_EXPORT std::ostream& operator<<(
         std::ostream& os, fork_join_executor::loop_schedule const& schedule);
+
+    HPX_CORE_EXPORT std::ostream& operator<<(
+        std::ostream& os, fork_join_executor::barrier_kind const& barrier);
 }}}    // namespace hpx::execution::experimental
 
 namespace hpx { namespace parallel { namespace execution {
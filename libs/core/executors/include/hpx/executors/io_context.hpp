@@ -0,0 +1,327 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file io_context.hpp
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/coroutines/thread_enums.hpp>
+#include <hpx/errors/try_catch_exception_ptr.hpp>
+#include <hpx/execution_base/completion_signatures.hpp>
+#include <hpx/execution_base/receiver.hpp>
+#include <hpx/execution_base/sender.hpp>
+#include <hpx/functional/detail/tag_fallback_invoke.hpp>
+#include <hpx/io_service/io_service_pool.hpp>
+#include <hpx/threading_base/register_thread.hpp>
+#include <hpx/threading_base/thread_pool_base.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace hpx::execution::experimental {
+
+    /// The native handle of a file or pipe used by the I/O senders.
+    using io_handle = int;
+
+    /// Flags for \a async_open, these map onto the flags of the native
+    /// open call.
+    enum class open_mode : std::uint32_t
+    {
+        read = 0x01,
+        write = 0x02,
+        read_write = read | write,
+        create = 0x04,
+        truncate = 0x08,
+        append = 0x10
+    };
+
+    constexpr open_mode operator|(open_mode lhs, open_mode rhs) noexcept
+    {
+        return static_cast<open_mode>(
+            static_cast<std::uint32_t>(lhs) | static_cast<std::uint32_t>(rhs));
+    }
+
+    constexpr bool has_open_mode(open_mode mode, open_mode flag) noexcept
+    {
+        return (static_cast<std::uint32_t>(mode) &
+                   static_cast<std::uint32_t>(flag)) != 0;
+    }
+
+    namespace detail {
+
+        // Blocking implementations of the I/O operations, these throw a
+        // hpx::exception (filesystem_error) on failure. An offset of -1
+        // refers to the current position of the file.
+        HPX_CORE_EXPORT io_handle io_open(
+            std::string const& path, open_mode mode);
+        HPX_CORE_EXPORT std::size_t io_read_some(
+            io_handle fd, void* buffer, std::size_t size, std::int64_t offset);
+        HPX_CORE_EXPORT std::size_t io_write_some(io_handle fd,
+            void const* buffer, std::size_t size, std::int64_t offset);
+        HPX_CORE_EXPORT void io_close(io_handle fd);
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename F>
+        using io_result_t = std::invoke_result_t<F&>;
+
+        template <typename F, typename Receiver>
+        struct io_operation_state
+        {
+            hpx::util::io_service_pool* io_pool_;
+            hpx::threads::thread_pool_base* pool_;
+            hpx::threads::thread_priority priority_;
+            HPX_NO_UNIQUE_ADDRESS std::decay_t<F> f_;
+            HPX_NO_UNIQUE_ADDRESS std::decay_t<Receiver> receiver_;
+
+            template <typename F_, typename Receiver_>
+            io_operation_state(hpx::util::io_service_pool* io_pool,
+                hpx::threads::thread_pool_base* pool,
+                hpx::threads::thread_priority priority, F_&& f,
+                Receiver_&& receiver)
+              : io_pool_(io_pool)
+              , pool_(pool)
+              , priority_(priority)
+              , f_(HPX_FORWARD(F_, f))
+              , receiver_(HPX_FORWARD(Receiver_, receiver))
+            {
+            }
+
+            io_operation_state(io_operation_state&&) = delete;
+            io_operation_state(io_operation_state const&) = delete;
+            io_operation_state& operator=(io_operation_state&&) = delete;
+            io_operation_state& operator=(io_operation_state const&) = delete;
+
+            // deliver the completion on a new HPX thread on the target pool
+            template <typename Completion>
+            void complete(Completion&& c)
+            {
+                threads::thread_init_data data(
+                    threads::make_thread_function_nullary(
+                        HPX_FORWARD(Completion, c)),
+                    "io_context::completion", priority_,
+                    threads::thread_schedule_hint(),
+                    threads::thread_stacksize::default_);
+                threads::register_work(data, pool_);
+            }
+
+            // executed on one of the threads of the I/O pool
+            void run()
+            {
+                hpx::detail::try_catch_exception_ptr(
+                    [&]() {
+                        if constexpr (std::is_void_v<io_result_t<F>>)
+                        {
+                            f_();
+                            complete([this]() {
+                                hpx::execution::experimental::set_value(
+                                    HPX_MOVE(receiver_));
+                            });
+                        }
+                        else
+                        {
+                            complete([this, result = f_()]() mutable {
+                                hpx::execution::experimental::set_value(
+                                    HPX_MOVE(receiver_), HPX_MOVE(result));
+                            });
+                        }
+                    },
+                    [&](std::exception_ptr ep) {
+                        complete([this, ep = HPX_MOVE(ep)]() mutable {
+                            hpx::execution::experimental::set_error(
+                                HPX_MOVE(receiver_), HPX_MOVE(ep));
+                        });
+                    });
+            }
+
+            friend void tag_invoke(start_t, io_operation_state& os) noexcept
+            {
+                hpx::detail::try_catch_exception_ptr(
+                    [&]() {
+                        os.io_pool_->get_io_service().post(
+                            [&os]() { os.run(); });
+                    },
+                    [&](std::exception_ptr ep) {
+                        hpx::execution::experimental::set_error(
+                            HPX_MOVE(os.receiver_), HPX_MOVE(ep));
+                    });
+            }
+        };
+
+        template <typename F>
+        struct io_sender
+        {
+            hpx::util::io_service_pool* io_pool_;
+            hpx::threads::thread_pool_base* pool_;
+            hpx::threads::thread_priority priority_;
+            HPX_NO_UNIQUE_ADDRESS std::decay_t<F> f_;
+
+            template <typename Env>
+            struct generate_completion_signatures
+            {
+                template <template <typename...> typename Tuple,
+                    template <typename...> typename Variant>
+                using value_types =
+                    std::conditional_t<std::is_void_v<io_result_t<F>>,
+                        Variant<Tuple<>>, Variant<Tuple<io_result_t<F>>>>;
+
+                template <template <typename...> typename Variant>
+                using error_types = Variant<std::exception_ptr>;
+
+                static constexpr bool sends_stopped = false;
+            };
+
+            template <typename Env>
+            friend auto tag_invoke(get_completion_signatures_t,
+                io_sender const&, Env) noexcept
+                -> generate_completion_signatures<Env>;
+
+            template <typename Receiver>
+            friend io_operation_state<F, Receiver> tag_invoke(
+                connect_t, io_sender&& s, Receiver&& receiver)
+            {
+                return {s.io_pool_, s.pool_, s.priority_, HPX_MOVE(s.f_),
+                    HPX_FORWARD(Receiver, receiver)};
+            }
+
+            template <typename Receiver>
+            friend io_operation_state<F, Receiver> tag_invoke(
+                connect_t, io_sender& s, Receiver&& receiver)
+            {
+                return {s.io_pool_, s.pool_, s.priority_, s.f_,
+                    HPX_FORWARD(Receiver, receiver)};
+            }
+        };
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// An \a io_context creates senders for asynchronous file and pipe I/O.
+    /// The blocking system calls are executed on the OS-threads of an
+    /// \a hpx::util::io_service_pool (for instance the runtime's "io-pool"),
+    /// which keeps them off the HPX worker threads. The completion of each
+    /// operation is delivered on a new HPX thread scheduled on the given
+    /// thread pool.
+    class io_context
+    {
+    public:
+        explicit io_context(hpx::util::io_service_pool* io_pool,
+            hpx::threads::thread_pool_base* pool =
+                hpx::threads::detail::get_self_or_default_pool(),
+            hpx::threads::thread_priority priority =
+                hpx::threads::thread_priority::normal) noexcept
+          : io_pool_(io_pool)
+          , pool_(pool)
+          , priority_(priority)
+        {
+            HPX_ASSERT(io_pool_ != nullptr);
+            HPX_ASSERT(pool_ != nullptr);
+        }
+
+        bool operator==(io_context const& rhs) const noexcept
+        {
+            return io_pool_ == rhs.io_pool_ && pool_ == rhs.pool_ &&
+                priority_ == rhs.priority_;
+        }
+
+        bool operator!=(io_context const& rhs) const noexcept
+        {
+            return !(*this == rhs);
+        }
+
+        hpx::util::io_service_pool* get_io_service_pool() const noexcept
+        {
+            return io_pool_;
+        }
+
+        hpx::threads::thread_pool_base* get_thread_pool() const noexcept
+        {
+            return pool_;
+        }
+
+        /// Returns a sender that runs the given (blocking) function on the
+        /// I/O pool and sends its result.
+        template <typename F>
+        detail::io_sender<std::decay_t<F>> execute_blocking(F&& f) const
+        {
+            return {io_pool_, pool_, priority_, HPX_FORWARD(F, f)};
+        }
+
+    private:
+        hpx::util::io_service_pool* io_pool_;
+        hpx::threads::thread_pool_base* pool_;
+        hpx::threads::thread_priority priority_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Returns a sender that opens the file at the given path and sends its
+    /// native handle.
+    inline constexpr struct async_open_t final
+      : hpx::functional::detail::tag_fallback<async_open_t>
+    {
+    private:
+        friend auto tag_fallback_invoke(async_open_t, io_context const& ctx,
+            std::string path, open_mode mode)
+        {
+            return ctx.execute_blocking(
+                [path = HPX_MOVE(path), mode]() -> io_handle {
+                    return detail::io_open(path, mode);
+                });
+        }
+    } async_open{};
+
+    /// Returns a sender that reads up to \a size bytes into the given buffer
+    /// and sends the number of bytes read (0 at the end of the file). The
+    /// buffer has to stay valid until the operation has completed.
+    inline constexpr struct async_read_some_t final
+      : hpx::functional::detail::tag_fallback<async_read_some_t>
+    {
+    private:
+        friend auto tag_fallback_invoke(async_read_some_t,
+            io_context const& ctx, io_handle fd, void* buffer,
+            std::size_t size, std::int64_t offset = -1)
+        {
+            return ctx.execute_blocking(
+                [fd, buffer, size, offset]() -> std::size_t {
+                    return detail::io_read_some(fd, buffer, size, offset);
+                });
+        }
+    } async_read_some{};
+
+    /// Returns a sender that writes up to \a size bytes from the given buffer
+    /// and sends the number of bytes written. The buffer has to stay valid
+    /// until the operation has completed.
+    inline constexpr struct async_write_some_t final
+      : hpx::functional::detail::tag_fallback<async_write_some_t>
+    {
+    private:
+        friend auto tag_fallback_invoke(async_write_some_t,
+            io_context const& ctx, io_handle fd, void const* buffer,
+            std::size_t size, std::int64_t offset = -1)
+        {
+            return ctx.execute_blocking(
+                [fd, buffer, size, offset]() -> std::size_t {
+                    return detail::io_write_some(fd, buffer, size, offset);
+                });
+        }
+    } async_write_some{};
+
+    /// Returns a sender that closes the given handle.
+    inline constexpr struct async_close_t final
+      : hpx::functional::detail::tag_fallback<async_close_t>
+    {
+    private:
+        friend auto tag_fallback_invoke(
+            async_close_t, io_context const& ctx, io_handle fd)
+        {
+            return ctx.execute_blocking([fd]() { detail::io_close(fd); });
+        }
+    } async_close{};
+}    // namespace hpx::execution::experimental
@@ -40,7 +40,8 @@ namespace hpx::execution::experimental {
         {
             return pool_ == rhs.pool_ && priority_ == rhs.priority_ &&
                 stacksize_ == rhs.stacksize_ &&
-                schedulehint_ == rhs.schedulehint_;
+                schedulehint_ == rhs.schedulehint_ &&
+                bulk_affinity_ == rhs.bulk_affinity_;
         }
 
         bool operator!=(thread_pool_scheduler const& rhs) const noexcept
@@ -136,6 +137,26 @@ namespace hpx::execution::experimental {
             return scheduler.annotation_;
         }
 
+        // support with_bulk_affinity property: bulk operations scheduled
+        // on this scheduler map the same index ranges to the same worker
+        // threads on every invocation and steal work from worker threads
+        // in the same NUMA domain first
+        friend constexpr thread_pool_scheduler tag_invoke(
+            hpx::execution::experimental::with_bulk_affinity_t,
+            thread_pool_scheduler const& scheduler, bool bulk_affinity)
+        {
+            auto sched_with_bulk_affinity = scheduler;
+            sched_with_bulk_affinity.bulk_affinity_ = bulk_affinity;
+            return sched_with_bulk_affinity;
+        }
+
+        friend constexpr bool tag_invoke(
+            hpx::execution::experimental::get_bulk_affinity_t,
+            thread_pool_scheduler const& scheduler) noexcept
+        {
+            return scheduler.bulk_affinity_;
+        }
+
         template <typename F>
         void execute(F&& f) const
         {
@@ -254,6 +275,7 @@ namespace hpx::execution::experimental {
             hpx::threads::thread_stacksize::small_;
         hpx::threads::thread_schedule_hint schedulehint_{};
         char const* annotation_ = nullptr;
+        bool bulk_affinity_ = false;
         /// \endcond
     };
 }    // namespace hpx::execution::experimental
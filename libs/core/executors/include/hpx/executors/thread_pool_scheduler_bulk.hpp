@@ -56,6 +56,15 @@ namespace hpx::execution::experimental {
         /// thread (the completion scheduler is a thread_pool_scheduler;
         /// otherwise the customization defined in this file is not chosen) it
         /// will be reused as one of the worker threads.
+        ///
+        /// If the scheduler has the bulk_affinity property set, the work is
+        /// distributed such that repeated invocations over the same shape
+        /// touch the same data on the same worker threads: the tasks are
+        /// always placed on the worker thread owning their queue (ignoring
+        /// any hint given to the scheduler), each task starts with the queue
+        /// of the worker thread it actually runs on, and stealing first
+        /// drains the queues of the worker threads in the same NUMA domain
+        /// before work is taken from other NUMA domains.
         template <typename Sender, typename Shape, typename F>
         class thread_pool_bulk_sender
         {
@@ -193,6 +202,21 @@ namespace hpx::execution::experimental {
                             }
                         }
 
+                        // Handle all chunks remaining in the queue of the given
+                        // worker thread, starting from the end of the queue.
+                        template <typename Ts>
+                        void steal_chunks(
+                            Ts& ts, std::size_t const worker_thread) const
+                        {
+                            auto& queue = op_state->queues[worker_thread].data_;
+
+                            hpx::optional<std::uint32_t> index;
+                            while ((index = queue.pop_right()))
+                            {
+                                do_work_chunk(ts, index.value());
+                            }
+                        }
+
                         // Visit the values sent from the predecessor sender.
                         // This function first tries to handle all chunks in the
                         // queue owned by worker_thread. It then tries to steal
@@ -202,8 +226,25 @@ namespace hpx::execution::experimental {
                                 std::decay_t<Ts>, hpx::monostate>>>
                         void operator()(Ts& ts) const
                         {
+                            std::size_t const num_worker_threads =
+                                op_state->num_worker_threads;
+
+                            // With bulk affinity the task starts with the
+                            // chunks belonging to the worker thread it runs
+                            // on, even if it was scheduled elsewhere.
+                            std::size_t worker_thread = task_f->worker_thread;
+                            if (op_state->bulk_affinity)
+                            {
+                                std::size_t const current_worker_thread =
+                                    hpx::get_local_worker_thread_num();
+                                if (current_worker_thread < num_worker_threads)
+                                {
+                                    worker_thread = current_worker_thread;
+                                }
+                            }
+
                             auto& local_queue =
-                                op_state->queues[task_f->worker_thread].data_;
+                                op_state->queues[worker_thread].data_;
 
                             // Handle local queue first
                             hpx::optional<std::uint32_t> index;
@@ -213,20 +254,37 @@ namespace hpx::execution::experimental {
                             }
 
                             // Then steal from neighboring queues
-                            for (std::uint32_t offset = 1;
-                                 offset < op_state->num_worker_threads;
-                                 ++offset)
+                            if (op_state->numa_domains.empty())
+                            {
+                                for (std::size_t offset = 1;
+                                     offset < num_worker_threads; ++offset)
+                                {
+                                    steal_chunks(ts,
+                                        (worker_thread + offset) %
+                                            num_worker_threads);
+                                }
+                                return;
+                            }
+
+                            // Steal from the worker threads in the same NUMA
+                            // domain first, only then from the other domains.
+                            auto const& numa_domains = op_state->numa_domains;
+                            std::size_t const local_domain =
+                                numa_domains[worker_thread];
+                            for (bool const same_domain : {true, false})
                             {
-                                std::size_t neighbor_worker_thread =
-                                    (task_f->worker_thread + offset) %
-                                    op_state->num_worker_threads;
-                                auto& neighbor_queue =
-                                    op_state->queues[neighbor_worker_thread]
-                                        .data_;
-
-                                while ((index = neighbor_queue.pop_right()))
+                                for (std::size_t offset = 1;
+                                     offset < num_worker_threads; ++offset)
                                 {
-                                    do_work_chunk(ts, index.value());
+                                    std::size_t const neighbor_worker_thread =
+                                        (worker_thread + offset) %
+                                        num_worker_threads;
+                                    if ((numa_domains[neighbor_worker_thread] ==
+                                            local_domain) == same_domain)
+                                    {
+                                        steal_chunks(
+                                            ts, neighbor_worker_thread);
+                                    }
                                 }
                             }
                         }
@@ -377,9 +435,11 @@ namespace hpx::execution::experimental {
                             return;
                         }
 
-                        // Only apply hint if none was given.
+                        // Only apply hint if none was given, always place the
+                        // task on its worker thread with bulk affinity.
                         auto hint = get_hint(op_state->scheduler);
-                        if (hint == hpx::threads::thread_schedule_hint())
+                        if (op_state->bulk_affinity ||
+                            hint == hpx::threads::thread_schedule_hint())
                         {
                             hint = hpx::threads::thread_schedule_hint(
                                 hpx::threads::thread_schedule_hint_mode::thread,
@@ -528,6 +588,11 @@ namespace hpx::execution::experimental {
                     ts;
                 std::atomic<bool> exception_thrown{false};
                 std::optional<std::exception_ptr> exception;
+                bool const bulk_affinity = get_bulk_affinity(scheduler);
+
+                // NUMA domain of each worker thread, only used (and
+                // non-empty) with bulk affinity
+                std::vector<std::size_t> numa_domains;
 
                 template <typename Sender_, typename Shape_, typename F_,
                     typename Receiver_>
@@ -541,6 +606,18 @@ namespace hpx::execution::experimental {
                   , f(HPX_FORWARD(F_, f))
                   , receiver(HPX_FORWARD(Receiver_, receiver))
                 {
+                    if (bulk_affinity)
+                    {
+                        auto* pool = this->scheduler.get_thread_pool();
+                        numa_domains.reserve(num_worker_threads);
+                        for (std::size_t worker_thread = 0;
+                             worker_thread != num_worker_threads;
+                             ++worker_thread)
+                        {
+                            numa_domains.push_back(
+                                pool->get_numa_domain(worker_thread));
+                        }
+                    }
                 }
 
                 friend void tag_invoke(start_t, operation_state& os) noexcept
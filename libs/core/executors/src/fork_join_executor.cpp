@@ -20,6 +20,9 @@ namespace hpx::execution::experimental {
         case fork_join_executor::loop_schedule::dynamic:
             os << "dynamic";
             break;
+        case fork_join_executor::loop_schedule::static_numa:
+            os << "static_numa";
+            break;
         default:
             os << "<unknown>";
             break;
@@ -33,4 +36,29 @@ namespace hpx::execution::experimental {
 
         return os;
     }
+
+    std::ostream& operator<<(
+        std::ostream& os, fork_join_executor::barrier_kind const& barrier)
+    {
+        switch (barrier)
+        {
+        case fork_join_executor::barrier_kind::flat:
+            os << "flat";
+            break;
+        case fork_join_executor::barrier_kind::hierarchical:
+            os << "hierarchical";
+            break;
+        default:
+            os << "<unknown>";
+            break;
+        }
+
+        os << " ("
+           << static_cast<
+                  std::underlying_type_t<fork_join_executor::barrier_kind>>(
+                  barrier)
+           << ")";
+
+        return os;
+    }
 }    // namespace hpx::execution::experimental
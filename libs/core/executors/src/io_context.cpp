@@ -0,0 +1,150 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/executors/io_context.hpp>
+#include <hpx/modules/errors.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(HPX_WINDOWS)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace hpx::execution::experimental::detail {
+
+    io_handle io_open(std::string const& path, open_mode mode)
+    {
+        int flags = 0;
+        if (has_open_mode(mode, open_mode::read) &&
+            has_open_mode(mode, open_mode::write))
+        {
+            flags |= O_RDWR;
+        }
+        else if (has_open_mode(mode, open_mode::write))
+        {
+            flags |= O_WRONLY;
+        }
+        else
+        {
+            flags |= O_RDONLY;
+        }
+
+        if (has_open_mode(mode, open_mode::create))
+        {
+            flags |= O_CREAT;
+        }
+        if (has_open_mode(mode, open_mode::truncate))
+        {
+            flags |= O_TRUNC;
+        }
+        if (has_open_mode(mode, open_mode::append))
+        {
+            flags |= O_APPEND;
+        }
+
+#if defined(HPX_WINDOWS)
+        io_handle fd =
+            ::_open(path.c_str(), flags | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        io_handle fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+#endif
+        if (fd < 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "hpx::execution::experimental::async_open",
+                "opening file {} failed: {}", path, std::strerror(errno));
+        }
+        return fd;
+    }
+
+    std::size_t io_read_some(
+        io_handle fd, void* buffer, std::size_t size, std::int64_t offset)
+    {
+#if defined(HPX_WINDOWS)
+        if (offset != -1 && ::_lseeki64(fd, offset, SEEK_SET) < 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "hpx::execution::experimental::async_read_some",
+                "seeking to offset {} failed: {}", offset,
+                std::strerror(errno));
+        }
+        auto const result = ::_read(fd, buffer, static_cast<unsigned>(size));
+#else
+        ssize_t result = 0;
+        do
+        {
+            result = offset == -1 ?
+                ::read(fd, buffer, size) :
+                ::pread(fd, buffer, size, static_cast<off_t>(offset));
+        } while (result < 0 && errno == EINTR);
+#endif
+        if (result < 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "hpx::execution::experimental::async_read_some",
+                "reading from handle {} failed: {}", fd,
+                std::strerror(errno));
+        }
+        return static_cast<std::size_t>(result);
+    }
+
+    std::size_t io_write_some(io_handle fd, void const* buffer,
+        std::size_t size, std::int64_t offset)
+    {
+#if defined(HPX_WINDOWS)
+        if (offset != -1 && ::_lseeki64(fd, offset, SEEK_SET) < 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "hpx::execution::experimental::async_write_some",
+                "seeking to offset {} failed: {}", offset,
+                std::strerror(errno));
+        }
+        auto const result = ::_write(fd, buffer, static_cast<unsigned>(size));
+#else
+        ssize_t result = 0;
+        do
+        {
+            result = offset == -1 ?
+                ::write(fd, buffer, size) :
+                ::pwrite(fd, buffer, size, static_cast<off_t>(offset));
+        } while (result < 0 && errno == EINTR);
+#endif
+        if (result < 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "hpx::execution::experimental::async_write_some",
+                "writing to handle {} failed: {}", fd, std::strerror(errno));
+        }
+        return static_cast<std::size_t>(result);
+    }
+
+    void io_close(io_handle fd)
+    {
+#if defined(HPX_WINDOWS)
+        int const result = ::_close(fd);
+#else
+        int const result = ::close(fd);
+#endif
+        if (result < 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "hpx::execution::experimental::async_close",
+                "closing handle {} failed: {}", fd, std::strerror(errno));
+        }
+    }
+}    // namespace hpx::execution::experimental::detail
@@ -9,6 +9,7 @@
 #include <hpx/local/execution.hpp>
 #include <hpx/local/future.hpp>
 #include <hpx/local/init.hpp>
+#include <hpx/local/runtime.hpp>
 #include <hpx/local/thread.hpp>
 #include <hpx/modules/testing.hpp>
 
@@ -172,17 +173,36 @@ void static_check_executor()
 }
 
 template <typename... ExecutorArgs>
-void test_executor(hpx::threads::thread_priority priority,
+void test_executor(fork_join_executor::barrier_kind barrier,
+    hpx::threads::thread_priority priority,
     hpx::threads::thread_stacksize stacksize,
     fork_join_executor::loop_schedule schedule)
 {
-    std::cerr << "testing fork_join_executor with priority = " << priority
-              << ", stacksize = " << stacksize << ", schedule = " << schedule
-              << "\n";
-    test_bulk_sync(priority, stacksize, schedule);
-    test_bulk_async(priority, stacksize, schedule);
-    test_bulk_sync_exception(priority, stacksize, schedule);
-    test_bulk_async_exception(priority, stacksize, schedule);
+    std::cerr << "testing fork_join_executor with barrier = " << barrier
+              << ", priority = " << priority << ", stacksize = " << stacksize
+              << ", schedule = " << schedule << "\n";
+    test_bulk_sync(barrier, priority, stacksize, schedule);
+    test_bulk_async(barrier, priority, stacksize, schedule);
+    test_bulk_sync_exception(barrier, priority, stacksize, schedule);
+    test_bulk_async_exception(barrier, priority, stacksize, schedule);
+}
+
+// Group the worker threads into synthetic NUMA domains to exercise the
+// hierarchical barrier on machines with a single NUMA domain.
+void test_executor_domains(std::vector<std::size_t> const& domains,
+    hpx::threads::thread_priority priority,
+    hpx::threads::thread_stacksize stacksize,
+    fork_join_executor::loop_schedule schedule)
+{
+    std::cerr << "testing fork_join_executor with synthetic NUMA domains, "
+              << "priority = " << priority << ", stacksize = " << stacksize
+              << ", schedule = " << schedule << "\n";
+
+    auto const barrier = fork_join_executor::barrier_kind::hierarchical;
+    test_bulk_sync(domains, barrier, priority, stacksize, schedule);
+    test_bulk_async(domains, barrier, priority, stacksize, schedule);
+    test_bulk_sync_exception(domains, barrier, priority, stacksize, schedule);
+    test_bulk_async_exception(domains, barrier, priority, stacksize, schedule);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -207,11 +227,32 @@ int hpx_main()
             for (auto const schedule : {
                      fork_join_executor::loop_schedule::static_,
                      fork_join_executor::loop_schedule::dynamic,
+                     fork_join_executor::loop_schedule::static_numa,
                  })
             {
+                for (auto const barrier : {
+                         fork_join_executor::barrier_kind::flat,
+                         fork_join_executor::barrier_kind::hierarchical,
+                     })
                 {
-                    test_executor(priority, stacksize, schedule);
+                    test_executor(barrier, priority, stacksize, schedule);
                 }
+
+                // two domains, once with contiguous and once with interleaved
+                // worker threads
+                std::size_t const num_threads = hpx::get_num_worker_threads();
+                std::vector<std::size_t> contiguous(num_threads);
+                std::vector<std::size_t> interleaved(num_threads);
+                for (std::size_t t = 0; t != num_threads; ++t)
+                {
+                    contiguous[t] = (2 * t) / num_threads;
+                    interleaved[t] = t % 2;
+                }
+
+                test_executor_domains(
+                    contiguous, priority, stacksize, schedule);
+                test_executor_domains(
+                    interleaved, priority, stacksize, schedule);
             }
         }
     }
@@ -0,0 +1,107 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/local/execution.hpp>
+#include <hpx/local/init.hpp>
+#include <hpx/local/runtime.hpp>
+#include <hpx/modules/filesystem.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/runtime_local/service_executors.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ex = hpx::execution::experimental;
+namespace tt = hpx::this_thread::experimental;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_write_read(ex::io_context const& ctx, std::string const& path)
+{
+    std::string const data = "the quick brown fox jumps over the lazy dog";
+
+    // write the data using two writes at explicit offsets
+    ex::io_handle fd = tt::sync_wait(ex::async_open(ctx, path,
+        ex::open_mode::write | ex::open_mode::create |
+            ex::open_mode::truncate));
+
+    std::size_t const half = data.size() / 2;
+    std::size_t written = tt::sync_wait(
+        ex::async_write_some(ctx, fd, data.data() + half, data.size() - half,
+            static_cast<std::int64_t>(half)));
+    written +=
+        tt::sync_wait(ex::async_write_some(ctx, fd, data.data(), half, 0));
+    HPX_TEST_EQ(written, data.size());
+
+    tt::sync_wait(ex::async_close(ctx, fd));
+
+    // read it back chained through then, the completions run on HPX threads
+    std::vector<char> buffer(data.size() + 10);
+    fd = tt::sync_wait(ex::async_open(ctx, path, ex::open_mode::read));
+
+    std::size_t read = tt::sync_wait(
+        ex::async_read_some(ctx, fd, buffer.data(), buffer.size()) |
+        ex::then([](std::size_t n) {
+            HPX_TEST(hpx::threads::get_self_ptr() != nullptr);
+            return n;
+        }));
+    HPX_TEST_EQ(read, data.size());
+    HPX_TEST_EQ(std::string(buffer.data(), read), data);
+
+    // reading at the end of the file returns zero bytes
+    read = tt::sync_wait(ex::async_read_some(
+        ctx, fd, buffer.data(), buffer.size(), std::int64_t(data.size())));
+    HPX_TEST_EQ(read, std::size_t(0));
+
+    tt::sync_wait(ex::async_close(ctx, fd));
+}
+
+void test_errors(ex::io_context const& ctx, std::string const& path)
+{
+    bool caught_exception = false;
+    try
+    {
+        tt::sync_wait(ex::async_open(
+            ctx, path + "/does/not/exist", ex::open_mode::read));
+        HPX_TEST(false);
+    }
+    catch (hpx::exception const& e)
+    {
+        HPX_TEST_EQ(e.get_error(), hpx::filesystem_error);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+int hpx_main()
+{
+    hpx::filesystem::path const path =
+        hpx::filesystem::temp_directory_path() /
+        ("hpx_io_context_" +
+            std::to_string(
+                std::hash<std::thread::id>()(std::this_thread::get_id())));
+
+    {
+        ex::io_pool_context ctx;
+        test_write_read(ctx, path.string());
+        test_errors(ctx, path.string());
+    }
+
+    hpx::filesystem::remove(path);
+
+    return hpx::local::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::local::init(hpx_main, argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -329,6 +329,14 @@ void test_properties()
         // thread_pool_scheduler holds the property.
     }
 
+    {
+        HPX_TEST(!ex::get_bulk_affinity(sched));
+        auto exec_prop = ex::with_bulk_affinity(sched, true);
+        HPX_TEST(ex::get_bulk_affinity(exec_prop));
+        HPX_TEST(exec_prop != sched);
+        HPX_TEST(ex::with_bulk_affinity(exec_prop, false) == sched);
+    }
+
     {
         char const* annotation = "<test>";
         auto exec_prop = ex::with_annotation(sched, annotation);
@@ -1624,6 +1632,24 @@ void test_bulk()
         }
     }
 
+    // repeated invocations with bulk affinity on the same data
+    {
+        auto sched = ex::with_bulk_affinity(ex::thread_pool_scheduler{}, true);
+        int const n = 1000;
+        std::vector<int> v(n, 0);
+
+        for (int iteration = 0; iteration != 10; ++iteration)
+        {
+            ex::schedule(sched) | ex::bulk(n, [&](int i) { ++v[i]; }) |
+                tt::sync_wait();
+        }
+
+        for (int i = 0; i < n; ++i)
+        {
+            HPX_TEST_EQ(v[i], 10);
+        }
+    }
+
     {
         std::unordered_set<std::string> string_map;
         std::vector<std::string> v = {"hello", "brave", "new", "world"};
@@ -0,0 +1,78 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that bulk operations scheduled through a thread_pool_scheduler with
+// the bulk_affinity property process each index on the same worker thread
+// across invocations.
+//
+// The test runs on the static scheduler, which does not steal HPX threads
+// between worker threads. Each worker thread gets a single index, and all
+// indices wait for each other. Hence no worker thread can run out of work and
+// steal the index of another one.
+
+#include <hpx/local/barrier.hpp>
+#include <hpx/local/execution.hpp>
+#include <hpx/local/init.hpp>
+#include <hpx/local/runtime.hpp>
+#include <hpx/local/thread.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ex = hpx::execution::experimental;
+namespace tt = hpx::this_thread::experimental;
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<std::size_t> record_worker_threads(
+    ex::thread_pool_scheduler const& sched, std::size_t n)
+{
+    std::vector<std::size_t> worker_threads(n, std::size_t(-1));
+    hpx::barrier<> b(static_cast<std::ptrdiff_t>(n));
+
+    ex::schedule(sched) | ex::bulk(n, [&](std::size_t i) {
+        worker_threads[i] = hpx::get_worker_thread_num();
+        b.arrive_and_wait();
+    }) | tt::sync_wait();
+
+    return worker_threads;
+}
+
+void test_bulk_affinity()
+{
+    auto sched = ex::with_bulk_affinity(ex::thread_pool_scheduler{}, true);
+    std::size_t const n = sched.get_thread_pool()->get_os_thread_count();
+
+    std::vector<std::size_t> const first = record_worker_threads(sched, n);
+    for (int iteration = 0; iteration != 10; ++iteration)
+    {
+        std::vector<std::size_t> const next = record_worker_threads(sched, n);
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            HPX_TEST_NEQ(next[i], std::size_t(-1));
+            HPX_TEST_EQ(next[i], first[i]);
+        }
+    }
+}
+
+int hpx_main()
+{
+    test_bulk_affinity();
+
+    return hpx::local::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::local::init_params init_args;
+    init_args.cfg = {"--hpx:queuing=static"};
+
+    HPX_TEST_EQ_MSG(hpx::local::init(hpx_main, argc, argv, init_args), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
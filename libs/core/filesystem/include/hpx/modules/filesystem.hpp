@@ -95,5 +95,12 @@ namespace hpx { namespace filesystem {
         return is_regular_file(p, compat_error_code(ec));
     }
 
+    using boost::filesystem::rename;
+    inline void rename(
+        path const& from, path const& to, std::error_code& ec) noexcept
+    {
+        rename(from, to, compat_error_code(ec));
+    }
+
 }}    // namespace hpx::filesystem
 #endif
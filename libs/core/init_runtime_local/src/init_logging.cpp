@@ -13,6 +13,7 @@
 #include <hpx/runtime_local/get_locality_id.hpp>
 #include <hpx/runtime_local/get_worker_thread_num.hpp>
 #include <hpx/threading_base/thread_data.hpp>
+#include <hpx/util/get_entry_as.hpp>
 
 #include <cstddef>
 #include <cstdint>
@@ -914,6 +915,33 @@ namespace hpx { namespace util {
                 lvl, HPX_MOVE(settings.dest_), HPX_MOVE(settings.format_));
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        void init_async_logging(util::section const& ini)
+        {
+            if (util::get_entry_as<int>(ini, "hpx.logging.async.enable", 0) ==
+                0)
+            {
+                return;
+            }
+
+            logging::async_logging_settings settings;
+            settings.buffer_size = util::get_entry_as<std::size_t>(
+                ini, "hpx.logging.async.buffer_size", settings.buffer_size);
+            settings.binary_file =
+                ini.get_entry("hpx.logging.async.binary_file", empty_string);
+
+            logging::enable_async_logging(settings);
+
+            // the console loggers stay synchronous as they are fed from
+            // the (already asynchronous) parcel layer
+            logging::register_async_logger(*agas_logger(), "AGAS");
+            logging::register_async_logger(*parcel_logger(), "PT");
+            logging::register_async_logger(*timing_logger(), "TIM");
+            logging::register_async_logger(*hpx_logger(), "HPX");
+            logging::register_async_logger(*app_logger(), "APP");
+            logging::register_async_logger(*debuglog_logger(), "DEB");
+        }
+
         ///////////////////////////////////////////////////////////////////////
         static void (*default_set_console_dest)(logger_writer_type&,
             char const*, logging::level,
@@ -951,6 +979,9 @@ namespace hpx { namespace util {
             init_hpx_console_log(ini);
             init_app_console_log(ini);
             init_debuglog_console_log(ini);
+
+            // optionally offload writing log messages to a background thread
+            init_async_logging(ini);
         }
 
         void init_logging_local(runtime_configuration& ini)
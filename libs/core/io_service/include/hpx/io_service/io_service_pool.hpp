@@ -12,8 +12,10 @@
 #include <hpx/config.hpp>
 #include <hpx/config/asio.hpp>
 #include <hpx/concurrency/barrier.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
 #include <hpx/functional/function.hpp>
 #include <hpx/threading_base/callback_notifier.hpp>
+#include <hpx/topology/cpu_mask.hpp>
 
 #include <asio/io_context.hpp>
 /* The boost asio support includes termios.h.
@@ -23,9 +25,13 @@
 #undef VT1
 #undef VT2
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -39,6 +45,26 @@ namespace hpx { namespace util {
     public:
         HPX_NON_COPYABLE(io_service_pool);
 
+        /// Options controlling how the threads of the pool (the reactors)
+        /// are run.
+        struct reactor_options
+        {
+            /// Affinity description (same syntax as --hpx:bind) used to pin
+            /// the reactor threads, the reactors are not pinned if empty.
+            std::string affinity;
+
+            /// Poll the io_services instead of blocking in the reactor.
+            bool busy_poll = false;
+
+            /// Number of unsuccessful polls before a reactor starts backing
+            /// off.
+            std::size_t busy_poll_spin_count = 1000;
+
+            /// Maximum time a backing off reactor blocks waiting for an
+            /// event.
+            std::chrono::microseconds busy_poll_max_backoff{100};
+        };
+
     public:
         /// \brief Construct the io_service pool.
         /// \param pool_size
@@ -106,6 +132,19 @@ namespace hpx { namespace util {
 
         void init(std::size_t pool_size);
 
+        /// \brief Set the options used to run the reactor threads, this has
+        ///        to be called before the pool is run.
+        void set_reactor_options(reactor_options options);
+
+        /// \brief Return the number of handlers executed by the thread
+        ///        \a index of this pool
+        std::int64_t get_events_handled(std::size_t index, bool reset);
+
+        /// \brief Return the time (in nanoseconds) the thread \a index of
+        ///        this pool spent polling for or waiting on events without
+        ///        executing a handler (busy-poll mode only)
+        std::int64_t get_polling_time(std::size_t index, bool reset);
+
     protected:
         bool run_locked(
             std::size_t num_threads, bool join_threads, barrier* startup);
@@ -114,6 +153,11 @@ namespace hpx { namespace util {
         void clear_locked();
         void wait_locked();
 
+        void create_io_services_locked(std::size_t pool_size);
+        void bind_thread(std::size_t index);
+        void run_blocking(std::size_t index);
+        void run_busy_poll(std::size_t index);
+
     private:
         using io_service_ptr = std::unique_ptr<asio::io_context>;
 
@@ -167,6 +211,20 @@ namespace hpx { namespace util {
             // Barriers for waiting for work to finish on all worker threads
             std::unique_ptr<barrier> wait_barrier_;
             std::unique_ptr<barrier> continue_barrier_;
+
+            /// How to run the threads of this pool
+            reactor_options options_;
+            std::vector<threads::mask_type> affinity_masks_;
+
+            /// Per-thread statistics
+            struct reactor_counters
+            {
+                std::atomic<std::int64_t> events_handled_{0};
+                std::atomic<std::int64_t> polling_time_{0};
+            };
+
+            std::unique_ptr<util::cache_aligned_data<reactor_counters>[]>
+                counters_;
         };
 
         ///////////////////////////////////////////////////////////////////////////////
@@ -1,4 +1,4 @@
-//  Copyright (c) 2007-2017 Hartmut Kaiser
+//  Copyright (c) 2007-2022 Hartmut Kaiser
 //  Copyright (c)      2011 Bryce Adelstein-Lelbach
 //
 //  Parts of this code were taken from the Boost.Asio library
@@ -11,19 +11,28 @@
 #include <hpx/config.hpp>
 #include <hpx/config/asio.hpp>
 #include <hpx/assert.hpp>
+#include <hpx/affinity/parse_affinity_options.hpp>
 #include <hpx/concurrency/barrier.hpp>
 #include <hpx/io_service/io_service_pool.hpp>
 #include <hpx/modules/errors.hpp>
 #include <hpx/modules/logging.hpp>
+#include <hpx/timing/high_resolution_clock.hpp>
+#include <hpx/topology/topology.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
 
 #include <asio/io_context.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <thread>
 #include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace util {
@@ -59,14 +68,31 @@ namespace hpx { namespace util {
         wait_barrier_.reset(new barrier(pool_size + 1));
         continue_barrier_.reset(new barrier(pool_size + 1));
 
+        create_io_services_locked(pool_size_);
+    }
+
+    void io_service_pool::create_io_services_locked(std::size_t pool_size)
+    {
         // Give all the io_services work to do so that their run() functions
         // will not exit until they are explicitly stopped.
-        for (std::size_t i = 0; i < pool_size_; ++i)
+        for (std::size_t i = 0; i < pool_size; ++i)
         {
             std::unique_ptr<asio::io_context> p(new asio::io_context);
             io_services_.emplace_back(HPX_MOVE(p));
             work_.emplace_back(initialize_work(*io_services_[i]));
         }
+
+        counters_.reset(
+            new util::cache_aligned_data<reactor_counters>[pool_size]);
+    }
+
+    void io_service_pool::set_reactor_options(reactor_options options)
+    {
+        std::lock_guard<std::mutex> l(mtx_);
+
+        HPX_ASSERT(threads_.empty());
+        options_ = HPX_MOVE(options);
+        affinity_masks_.clear();
     }
 
     io_service_pool::io_service_pool(
@@ -101,10 +127,20 @@ namespace hpx { namespace util {
 
         notifier_.on_start_thread(index, index, pool_name_, pool_name_postfix_);
 
+        bind_thread(index);
+
         // use this thread for the given io service
         while (true)
         {
-            io_services_[index]->run();    // run io service
+            // run io service
+            if (options_.busy_poll)
+            {
+                run_busy_poll(index);
+            }
+            else
+            {
+                run_blocking(index);
+            }
 
             if (waiting_)
             {
@@ -120,6 +156,116 @@ namespace hpx { namespace util {
         notifier_.on_stop_thread(index, index, pool_name_, pool_name_postfix_);
     }
 
+    void io_service_pool::bind_thread(std::size_t index)
+    {
+        if (index >= affinity_masks_.size() ||
+            !threads::any(affinity_masks_[index]))
+        {
+            return;
+        }
+
+        error_code ec(throwmode::lightweight);
+        threads::create_topology().set_thread_affinity_mask(
+            affinity_masks_[index], ec);
+        if (ec)
+        {
+            LERR_(warning).format(
+                "io_service_pool({}): failed to bind thread {}: {}",
+                pool_name_, index, ec.get_message());
+        }
+    }
+
+    void io_service_pool::run_blocking(std::size_t index)
+    {
+        asio::io_context& io_service = *io_services_[index];
+        auto& counters = counters_[index].data_;
+
+        // equivalent to io_service.run(), but counts the executed handlers
+        while (io_service.run_one() != 0)
+        {
+            counters.events_handled_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Poll the io_service without blocking in the reactor (epoll & co.) to
+    // reduce the latency of handling incoming events. After a configurable
+    // number of unsuccessful polls the thread blocks for an exponentially
+    // growing (bounded) amount of time, the backoff is reset as soon as an
+    // event was handled.
+    void io_service_pool::run_busy_poll(std::size_t index)
+    {
+        asio::io_context& io_service = *io_services_[index];
+        auto& counters = counters_[index].data_;
+
+        std::chrono::microseconds const min_backoff(1);
+        std::chrono::microseconds const max_backoff =
+            (std::max)(options_.busy_poll_max_backoff, min_backoff);
+
+        std::size_t idle_polls = 0;
+        std::chrono::microseconds backoff = min_backoff;
+
+        while (!io_service.stopped())
+        {
+            std::uint64_t const start =
+                hpx::chrono::high_resolution_clock::now();
+
+            std::size_t handled = 0;
+            if (idle_polls < options_.busy_poll_spin_count)
+            {
+                handled = io_service.poll();
+                ++idle_polls;
+            }
+            else
+            {
+                handled = io_service.run_one_for(backoff);
+                backoff = (std::min)(2 * backoff, max_backoff);
+            }
+
+            if (handled != 0)
+            {
+                counters.events_handled_.fetch_add(
+                    static_cast<std::int64_t>(handled),
+                    std::memory_order_relaxed);
+
+                idle_polls = 0;
+                backoff = min_backoff;
+            }
+            else
+            {
+                counters.polling_time_.fetch_add(
+                    static_cast<std::int64_t>(
+                        hpx::chrono::high_resolution_clock::now() - start),
+                    std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::int64_t io_service_pool::get_events_handled(
+        std::size_t index, bool reset)
+    {
+        // the counters are reallocated whenever the pool is (re-)started
+        std::lock_guard<std::mutex> l(mtx_);
+        if (!counters_ || index >= pool_size_)
+        {
+            return 0;
+        }
+        return util::get_and_reset_value(
+            counters_[index].data_.events_handled_, reset);
+    }
+
+    std::int64_t io_service_pool::get_polling_time(
+        std::size_t index, bool reset)
+    {
+        // the counters are reallocated whenever the pool is (re-)started
+        std::lock_guard<std::mutex> l(mtx_);
+        if (!counters_ || index >= pool_size_)
+        {
+            return 0;
+        }
+        return util::get_and_reset_value(
+            counters_[index].data_.polling_time_, reset);
+    }
+
     bool io_service_pool::run(
         std::size_t num_threads, bool join_threads, util::barrier* startup)
     {
@@ -177,12 +323,35 @@ namespace hpx { namespace util {
         if (io_services_.empty())
         {
             pool_size_ = num_threads;
+            create_io_services_locked(num_threads);
+        }
 
-            for (std::size_t i = 0; i < num_threads; ++i)
+        // compute the cores the reactor threads should be pinned to
+        affinity_masks_.clear();
+        if (!options_.affinity.empty())
+        {
+            threads::topology const& topo = threads::create_topology();
+
+            std::vector<threads::mask_type> masks(num_threads);
+            for (auto& mask : masks)
             {
-                std::unique_ptr<asio::io_context> p(new asio::io_context);
-                io_services_.emplace_back(HPX_MOVE(p));
-                work_.emplace_back(initialize_work(*io_services_[i]));
+                threads::resize(mask, threads::hardware_concurrency());
+            }
+
+            std::vector<std::size_t> pu_nums;
+            error_code ec(throwmode::lightweight);
+            threads::parse_affinity_options(options_.affinity, masks, 0,
+                topo.get_number_of_cores(), num_threads, pu_nums, false, ec);
+            if (ec)
+            {
+                LERR_(warning).format(
+                    "io_service_pool({}): ignoring invalid affinity "
+                    "description '{}': {}",
+                    pool_name_, options_.affinity, ec.get_message());
+            }
+            else
+            {
+                affinity_masks_ = HPX_MOVE(masks);
             }
         }
 
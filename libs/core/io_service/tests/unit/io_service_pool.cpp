@@ -0,0 +1,209 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that the reactor threads of an io_service_pool count the handlers
+// they execute (in blocking and busy-poll mode), that they are pinned as
+// requested, and that the counters can be queried while the pool restarts.
+
+#include <hpx/config.hpp>
+#include <hpx/affinity/parse_affinity_options.hpp>
+#include <hpx/io_service/io_service_pool.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/topology/topology.hpp>
+
+#include <asio/io_context.hpp>
+#include <asio/post.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using hpx::util::io_service_pool;
+
+constexpr std::size_t num_reactors = 2;
+constexpr std::size_t num_handlers = 1000;
+
+// the pool refers to the notifier, it has to outlive the pool
+hpx::threads::policies::callback_notifier const notifier;
+
+///////////////////////////////////////////////////////////////////////////////
+// execute the given function on the reactor thread index and wait for it
+template <typename F>
+void run_on(io_service_pool& pool, std::size_t index, F&& f)
+{
+    std::atomic<bool> done(false);
+    asio::post(pool.get_io_service(static_cast<int>(index)), [&]() {
+        f();
+        done = true;
+    });
+
+    while (!done.load())
+    {
+        std::this_thread::yield();
+    }
+}
+
+void post_handlers(io_service_pool& pool)
+{
+    std::atomic<std::size_t> executed(0);
+    for (std::size_t i = 0; i != num_reactors; ++i)
+    {
+        asio::io_context& io_service =
+            pool.get_io_service(static_cast<int>(i));
+        for (std::size_t j = 0; j != num_handlers; ++j)
+        {
+            asio::post(io_service, [&]() { ++executed; });
+        }
+    }
+
+    while (executed.load() != num_reactors * num_handlers)
+    {
+        std::this_thread::yield();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_counters(bool busy_poll)
+{
+    io_service_pool pool(num_reactors, notifier, "test-io");
+
+    io_service_pool::reactor_options options;
+    options.busy_poll = busy_poll;
+    options.busy_poll_spin_count = 10;
+    pool.set_reactor_options(options);
+
+    pool.run(false);
+
+    post_handlers(pool);
+    for (std::size_t i = 0; i != num_reactors; ++i)
+    {
+        // the counter of the reactor is updated after the handler returned
+        while (pool.get_events_handled(i, false) <
+            static_cast<std::int64_t>(num_handlers))
+        {
+            std::this_thread::yield();
+        }
+
+        HPX_TEST_EQ(pool.get_events_handled(i, true),
+            static_cast<std::int64_t>(num_handlers));
+        HPX_TEST_EQ(pool.get_events_handled(i, false), std::int64_t(0));
+    }
+
+    // let the reactors poll for a while without anything to do
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    for (std::size_t i = 0; i != num_reactors; ++i)
+    {
+        if (busy_poll)
+        {
+            HPX_TEST_LT(std::int64_t(0), pool.get_polling_time(i, true));
+        }
+        else
+        {
+            HPX_TEST_EQ(pool.get_polling_time(i, true), std::int64_t(0));
+        }
+    }
+
+    // reactors outside of the pool have no counters
+    HPX_TEST_EQ(pool.get_events_handled(num_reactors, false), std::int64_t(0));
+    HPX_TEST_EQ(pool.get_polling_time(num_reactors, false), std::int64_t(0));
+
+    pool.stop();
+    pool.join();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_affinity()
+{
+    hpx::threads::topology const& topo = hpx::threads::create_topology();
+
+    std::string const affinity = "thread:0-1=pu:0";
+
+    // compute the masks the reactor threads are expected to be bound to
+    std::vector<hpx::threads::mask_type> expected(num_reactors);
+    for (auto& mask : expected)
+    {
+        hpx::threads::resize(mask, hpx::threads::hardware_concurrency());
+    }
+
+    std::vector<std::size_t> pu_nums;
+    hpx::error_code ec(hpx::throwmode::lightweight);
+    hpx::threads::parse_affinity_options(affinity, expected, 0,
+        topo.get_number_of_cores(), num_reactors, pu_nums, false, ec);
+    HPX_TEST(!ec);
+
+    io_service_pool pool(num_reactors, notifier, "test-io");
+
+    io_service_pool::reactor_options options;
+    options.affinity = affinity;
+    pool.set_reactor_options(options);
+
+    pool.run(false);
+
+    for (std::size_t i = 0; i != num_reactors; ++i)
+    {
+        hpx::threads::mask_type mask;
+        run_on(pool, i, [&]() {
+            hpx::error_code ec(hpx::throwmode::lightweight);
+            mask = topo.get_cpubind_mask(ec);
+        });
+
+        HPX_TEST(hpx::threads::equal(mask, expected[i]));
+    }
+
+    pool.stop();
+    pool.join();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_restart()
+{
+    io_service_pool pool(num_reactors, notifier, "test-io");
+    pool.run(false);
+
+    // query the counters while the pool is restarted, which reallocates them
+    std::atomic<bool> done(false);
+    std::thread reader([&]() {
+        while (!done.load())
+        {
+            for (std::size_t i = 0; i != num_reactors; ++i)
+            {
+                HPX_TEST_LTE(std::int64_t(0), pool.get_events_handled(i, true));
+                HPX_TEST_LTE(std::int64_t(0), pool.get_polling_time(i, true));
+            }
+        }
+    });
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        post_handlers(pool);
+
+        pool.stop();
+        pool.join();
+        pool.clear();
+        pool.run(false);
+    }
+
+    done = true;
+    reader.join();
+
+    pool.stop();
+    pool.join();
+}
+
+int main()
+{
+    test_counters(false);
+    test_counters(true);
+    test_affinity();
+    test_restart();
+
+    return hpx::util::report_errors();
+}
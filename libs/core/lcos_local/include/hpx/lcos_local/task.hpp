@@ -0,0 +1,595 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file task.hpp
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_CXX20_COROUTINES)
+
+#include <hpx/assert.hpp>
+#include <hpx/datastructures/variant.hpp>
+#include <hpx/execution/algorithms/detail/single_result.hpp>
+#include <hpx/execution_base/completion_signatures.hpp>
+#include <hpx/execution_base/operation_state.hpp>
+#include <hpx/execution_base/receiver.hpp>
+#include <hpx/execution_base/sender.hpp>
+#include <hpx/futures/future.hpp>
+#include <hpx/futures/promise.hpp>
+#include <hpx/futures/traits/future_access.hpp>
+#include <hpx/futures/traits/is_future.hpp>
+#include <hpx/lcos_local/channel.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/memory.hpp>
+#include <hpx/threading_base/thread_helpers.hpp>
+#include <hpx/timing/steady_clock.hpp>
+#include <hpx/type_support/meta.hpp>
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace hpx {
+
+    template <typename T = void>
+    class task;
+
+    namespace detail {
+
+        ///////////////////////////////////////////////////////////////////////
+        // Schedule the resumption of the given coroutine as a new stackless
+        // HPX thread. Stackless threads don't own a stack of their own, they
+        // run on the stack of the scheduling loop of the worker thread.
+        HPX_CORE_EXPORT threads::thread_id_ref_type resume_on_stackless_thread(
+            std::coroutine_handle<> h,
+            threads::thread_schedule_state initial_state =
+                threads::thread_schedule_state::pending);
+
+        ///////////////////////////////////////////////////////////////////////
+        // Await a future without creating any additional shared state. The
+        // awaiting coroutine is resumed on a new stackless thread once the
+        // future becomes ready.
+        template <typename Future>
+        struct future_awaiter
+        {
+            Future f_;
+
+            bool await_ready() const noexcept
+            {
+                return f_.is_ready();
+            }
+
+            void await_suspend(std::coroutine_handle<> h)
+            {
+                auto st = traits::detail::get_shared_state(f_);
+                st->set_on_completed(
+                    [h]() { resume_on_stackless_thread(h); });
+            }
+
+            decltype(auto) await_resume()
+            {
+                return f_.get();
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Await a sender by connecting it to a receiver that stores the
+        // result in the coroutine frame and schedules the coroutine.
+        template <typename Sender>
+        struct sender_awaiter
+        {
+            using result_type = std::decay_t<
+                hpx::execution::experimental::detail::single_result_t<
+                    hpx::execution::experimental::value_types_of_t<Sender,
+                        hpx::execution::experimental::empty_env, meta::pack,
+                        meta::pack>>>;
+
+            static constexpr bool is_void_result =
+                std::is_void_v<result_type>;
+
+            struct void_value_type
+            {
+            };
+
+            using value_type = std::conditional_t<is_void_result,
+                void_value_type, result_type>;
+
+            struct receiver
+            {
+                sender_awaiter* awaiter_;
+
+                template <typename Error>
+                friend void tag_invoke(hpx::execution::experimental::set_error_t,
+                    receiver&& r, Error&& error) noexcept
+                {
+                    if constexpr (std::is_same_v<std::decay_t<Error>,
+                                      std::exception_ptr>)
+                    {
+                        r.awaiter_->result_.template emplace<2>(
+                            HPX_FORWARD(Error, error));
+                    }
+                    else
+                    {
+                        r.awaiter_->result_.template emplace<2>(
+                            std::make_exception_ptr(HPX_FORWARD(Error, error)));
+                    }
+                    resume_on_stackless_thread(r.awaiter_->continuation_);
+                }
+
+                friend void tag_invoke(
+                    hpx::execution::experimental::set_stopped_t,
+                    receiver&& r) noexcept
+                {
+                    r.awaiter_->result_.template emplace<2>(
+                        std::make_exception_ptr(hpx::exception(
+                            hpx::thread_cancelled, "sender was stopped")));
+                    resume_on_stackless_thread(r.awaiter_->continuation_);
+                }
+
+                template <typename... Us>
+                friend void tag_invoke(hpx::execution::experimental::set_value_t,
+                    receiver&& r, Us&&... us) noexcept
+                {
+                    r.awaiter_->result_.template emplace<1>(
+                        HPX_FORWARD(Us, us)...);
+                    resume_on_stackless_thread(r.awaiter_->continuation_);
+                }
+            };
+
+            using operation_state_type =
+                hpx::execution::experimental::connect_result_t<Sender,
+                    receiver>;
+
+            explicit sender_awaiter(Sender&& sender)
+              : op_state_(hpx::execution::experimental::connect(
+                    HPX_MOVE(sender), receiver{this}))
+            {
+            }
+
+            sender_awaiter(sender_awaiter&&) = delete;
+            sender_awaiter& operator=(sender_awaiter&&) = delete;
+
+            constexpr bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> h)
+            {
+                continuation_ = h;
+                hpx::execution::experimental::start(op_state_);
+            }
+
+            result_type await_resume()
+            {
+                if (result_.index() == 2)
+                {
+                    std::rethrow_exception(hpx::get<2>(result_));
+                }
+                if constexpr (!is_void_result)
+                {
+                    return HPX_MOVE(hpx::get<1>(result_));
+                }
+            }
+
+            std::coroutine_handle<> continuation_;
+            hpx::variant<hpx::monostate, value_type, std::exception_ptr>
+                result_;
+            operation_state_type op_state_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        struct is_channel : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct is_channel<hpx::lcos::local::channel<T>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        struct is_channel<hpx::lcos::local::one_element_channel<T>>
+          : std::true_type
+        {
+        };
+
+        template <typename T>
+        struct is_channel<hpx::lcos::local::receive_channel<T>>
+          : std::true_type
+        {
+        };
+
+        template <typename T>
+        inline constexpr bool is_channel_v = is_channel<std::decay_t<T>>::value;
+
+        ///////////////////////////////////////////////////////////////////////
+        struct task_promise_base
+        {
+            struct final_awaiter
+            {
+                constexpr bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                // symmetric transfer to the awaiting coroutine, if any
+                template <typename Promise>
+                std::coroutine_handle<> await_suspend(
+                    std::coroutine_handle<Promise> h) noexcept
+                {
+                    std::coroutine_handle<> continuation =
+                        h.promise().continuation_;
+                    if (continuation)
+                    {
+                        return continuation;
+                    }
+                    return std::noop_coroutine();
+                }
+
+                constexpr void await_resume() const noexcept {}
+            };
+
+            // tasks are lazy, they start running only once they are awaited
+            constexpr std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            constexpr final_awaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void unhandled_exception() noexcept
+            {
+                exception_ = std::current_exception();
+            }
+
+            // futures, senders, and channels are awaited through adaptors
+            // resuming the task on a stackless thread
+            template <typename Future,
+                typename = std::enable_if_t<traits::is_future_v<Future>>>
+            auto await_transform(Future&& f) noexcept
+            {
+                return future_awaiter<Future>{HPX_FORWARD(Future, f)};
+            }
+
+            template <typename Channel,
+                typename = std::enable_if_t<is_channel_v<Channel>>,
+                typename = void>
+            auto await_transform(Channel&& c)
+            {
+                return future_awaiter<decltype(c.get())>{c.get()};
+            }
+
+            template <typename Sender,
+                typename = std::enable_if_t<!traits::is_future_v<Sender> &&
+                    !is_channel_v<Sender> &&
+                    hpx::execution::experimental::is_sender_v<Sender>>,
+                typename = void, typename = void>
+            auto await_transform(Sender&& sender)
+            {
+                return sender_awaiter<std::decay_t<Sender>>(
+                    HPX_FORWARD(Sender, sender));
+            }
+
+            // everything else (tasks, timers) is awaited as is
+            template <typename Awaitable,
+                typename = std::enable_if_t<!traits::is_future_v<Awaitable> &&
+                    !is_channel_v<Awaitable> &&
+                    !hpx::execution::experimental::is_sender_v<Awaitable>>,
+                typename = void, typename = void, typename = void>
+            Awaitable&& await_transform(Awaitable&& a) noexcept
+            {
+                return HPX_FORWARD(Awaitable, a);
+            }
+
+            void rethrow_if_exception()
+            {
+                if (exception_)
+                {
+                    std::rethrow_exception(exception_);
+                }
+            }
+
+            std::coroutine_handle<> continuation_;
+            std::exception_ptr exception_;
+        };
+
+        template <typename T>
+        struct task_promise : task_promise_base
+        {
+            task<T> get_return_object() noexcept;
+
+            template <typename U>
+            void return_value(U&& value)
+            {
+                value_.emplace(HPX_FORWARD(U, value));
+            }
+
+            T get()
+            {
+                rethrow_if_exception();
+                HPX_ASSERT(value_.has_value());
+                return HPX_MOVE(*value_);
+            }
+
+            std::optional<T> value_;
+        };
+
+        template <>
+        struct task_promise<void> : task_promise_base
+        {
+            task<void> get_return_object() noexcept;
+
+            constexpr void return_void() const noexcept {}
+
+            void get()
+            {
+                rethrow_if_exception();
+            }
+        };
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A \a task<T> is a lazily started coroutine producing a value of type
+    /// \a T. A task starts running only once it is awaited (by another task)
+    /// or once it is passed to \a hpx::start_task. Whenever a task has to
+    /// wait for a future, a sender, a channel, or a timer, its frame is
+    /// scheduled again as a stackless HPX thread once the awaited operation
+    /// has completed. Suspended tasks therefore don't hold on to a stack.
+    ///
+    /// \note A task may be awaited only once. The body of a task must not
+    ///       block or suspend the underlying HPX thread (for instance by
+    ///       calling \a hpx::future::get on a future that is not ready),
+    ///       it should co_await instead.
+    template <typename T>
+    class task
+    {
+    public:
+        using promise_type = detail::task_promise<T>;
+        using value_type = T;
+
+        task() noexcept = default;
+
+        task(task&& rhs) noexcept
+          : coro_(std::exchange(rhs.coro_, nullptr))
+        {
+        }
+
+        task& operator=(task&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                if (coro_)
+                {
+                    coro_.destroy();
+                }
+                coro_ = std::exchange(rhs.coro_, nullptr);
+            }
+            return *this;
+        }
+
+        task(task const&) = delete;
+        task& operator=(task const&) = delete;
+
+        ~task()
+        {
+            if (coro_)
+            {
+                coro_.destroy();
+            }
+        }
+
+        bool valid() const noexcept
+        {
+            return coro_ != nullptr;
+        }
+
+        // awaiting a task transfers control to it directly
+        auto operator co_await() && noexcept
+        {
+            struct awaiter
+            {
+                std::coroutine_handle<promise_type> coro_;
+
+                bool await_ready() const noexcept
+                {
+                    return !coro_ || coro_.done();
+                }
+
+                std::coroutine_handle<> await_suspend(
+                    std::coroutine_handle<> h) noexcept
+                {
+                    coro_.promise().continuation_ = h;
+                    return coro_;
+                }
+
+                T await_resume()
+                {
+                    if (!coro_)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::no_state,
+                            "task::operator co_await",
+                            "the task has no valid coroutine state");
+                    }
+                    return coro_.promise().get();
+                }
+            };
+
+            return awaiter{coro_};
+        }
+
+    private:
+        friend struct detail::task_promise<T>;
+
+        explicit task(std::coroutine_handle<promise_type> coro) noexcept
+          : coro_(coro)
+        {
+        }
+
+        std::coroutine_handle<promise_type> coro_ = nullptr;
+    };
+
+    namespace detail {
+
+        template <typename T>
+        task<T> task_promise<T>::get_return_object() noexcept
+        {
+            return task<T>(
+                std::coroutine_handle<task_promise<T>>::from_promise(*this));
+        }
+
+        inline task<void> task_promise<void>::get_return_object() noexcept
+        {
+            return task<void>(
+                std::coroutine_handle<task_promise<void>>::from_promise(
+                    *this));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The root coroutine is started by start_task, it drives the given
+        // task and destroys itself once the task has finished.
+        struct root_task
+        {
+            struct promise_type
+            {
+                root_task get_return_object() noexcept
+                {
+                    return root_task{
+                        std::coroutine_handle<promise_type>::from_promise(
+                            *this)};
+                }
+
+                constexpr std::suspend_always initial_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                constexpr std::suspend_never final_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                constexpr void return_void() const noexcept {}
+
+                void unhandled_exception() noexcept
+                {
+                    std::terminate();
+                }
+            };
+
+            std::coroutine_handle<promise_type> coro_;
+        };
+
+        template <typename T>
+        root_task run_root_task(task<T> t, hpx::promise<T> p)
+        {
+            try
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    co_await HPX_MOVE(t);
+                    p.set_value();
+                }
+                else
+                {
+                    p.set_value(co_await HPX_MOVE(t));
+                }
+            }
+            catch (...)
+            {
+                p.set_exception(std::current_exception());
+            }
+        }
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Start running the given task on a stackless HPX thread. The returned
+    /// future becomes ready once the task has finished.
+    template <typename T>
+    hpx::future<T> start_task(task<T> t)
+    {
+        hpx::promise<T> p;
+        hpx::future<T> f = p.get_future();
+
+        detail::root_task root = detail::run_root_task(HPX_MOVE(t), HPX_MOVE(p));
+        detail::resume_on_stackless_thread(root.coro_);
+
+        return f;
+    }
+
+    namespace this_task {
+
+        ///////////////////////////////////////////////////////////////////////
+        struct sleep_awaiter
+        {
+            hpx::chrono::steady_time_point abs_time_;
+
+            bool await_ready() const noexcept
+            {
+                return abs_time_.value() <= hpx::chrono::steady_clock::now();
+            }
+
+            void await_suspend(std::coroutine_handle<> h)
+            {
+                // create the stackless thread suspended and let the timer
+                // wake it up
+                threads::thread_id_ref_type id =
+                    detail::resume_on_stackless_thread(
+                        h, threads::thread_schedule_state::suspended);
+                threads::set_thread_state(id.noref(), abs_time_,
+                    threads::thread_schedule_state::pending,
+                    threads::thread_restart_state::timeout);
+            }
+
+            constexpr void await_resume() const noexcept {}
+        };
+
+        struct yield_awaiter
+        {
+            constexpr bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> h)
+            {
+                detail::resume_on_stackless_thread(h);
+            }
+
+            constexpr void await_resume() const noexcept {}
+        };
+
+        /// Suspend the calling task until the given point in time.
+        inline sleep_awaiter sleep_until(
+            hpx::chrono::steady_time_point const& abs_time) noexcept
+        {
+            return sleep_awaiter{abs_time};
+        }
+
+        /// Suspend the calling task for the given duration.
+        inline sleep_awaiter sleep_for(
+            hpx::chrono::steady_duration const& rel_time)
+        {
+            return sleep_awaiter{rel_time.from_now()};
+        }
+
+        /// Reschedule the calling task, giving other work a chance to run.
+        inline constexpr yield_awaiter yield() noexcept
+        {
+            return yield_awaiter{};
+        }
+    }    // namespace this_task
+}    // namespace hpx
+
+#endif    // HPX_HAVE_CXX20_COROUTINES
@@ -0,0 +1,44 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_CXX20_COROUTINES)
+
+#include <hpx/assert.hpp>
+#include <hpx/lcos_local/task.hpp>
+#include <hpx/modules/threading_base.hpp>
+
+#include <coroutine>
+
+namespace hpx { namespace detail {
+
+    threads::thread_id_ref_type resume_on_stackless_thread(
+        std::coroutine_handle<> h,
+        threads::thread_schedule_state initial_state)
+    {
+        HPX_ASSERT(h && !h.done());
+
+        threads::thread_init_data data(
+            [h](threads::thread_restart_state) {
+                h.resume();
+                return threads::thread_result_type(
+                    threads::thread_schedule_state::terminated,
+                    threads::invalid_thread_id);
+            },
+            "hpx::task", threads::thread_priority::normal,
+            threads::thread_schedule_hint(), threads::thread_stacksize::nostack,
+            initial_state);
+
+        if (initial_state == threads::thread_schedule_state::pending)
+        {
+            return threads::register_work(data);
+        }
+        return threads::register_thread(data);
+    }
+}}    // namespace hpx::detail
+
+#endif    // HPX_HAVE_CXX20_COROUTINES
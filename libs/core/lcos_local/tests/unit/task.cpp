@@ -0,0 +1,162 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if !defined(HPX_HAVE_CXX20_COROUTINES)
+#error "This test requires compiler support for C++20 coroutines"
+#endif
+
+#include <hpx/local/channel.hpp>
+#include <hpx/local/execution.hpp>
+#include <hpx/local/future.hpp>
+#include <hpx/local/init.hpp>
+#include <hpx/local/thread.hpp>
+#include <hpx/lcos_local/task.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ex = hpx::execution::experimental;
+
+hpx::task<int> answer()
+{
+    co_return 42;
+}
+
+hpx::task<int> nested()
+{
+    int result = co_await answer();
+    co_return result + co_await answer();
+}
+
+hpx::task<void> throws()
+{
+    throw std::runtime_error("task failed");
+    co_return;
+}
+
+hpx::task<int> await_future()
+{
+    int result = co_await hpx::async([]() {
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return 42;
+    });
+    co_return result + co_await hpx::make_ready_future(1);
+}
+
+hpx::task<int> await_sender()
+{
+    co_return co_await(ex::schedule(ex::thread_pool_scheduler{}) |
+        ex::then([]() { return 42; }));
+}
+
+hpx::task<std::size_t> await_channel(hpx::channel<std::size_t>& c)
+{
+    std::size_t sum = 0;
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        sum += co_await c;
+    }
+    co_return sum;
+}
+
+hpx::task<double> await_timer()
+{
+    hpx::chrono::high_resolution_timer t;
+    co_await hpx::this_task::sleep_for(std::chrono::milliseconds(100));
+    co_await hpx::this_task::yield();
+    co_return t.elapsed();
+}
+
+hpx::task<std::size_t> recurse(std::size_t n)
+{
+    if (n == 0)
+    {
+        co_return 0;
+    }
+    co_return 1 + co_await recurse(n - 1);
+}
+
+void test_task()
+{
+    HPX_TEST_EQ(hpx::start_task(answer()).get(), 42);
+    HPX_TEST_EQ(hpx::start_task(nested()).get(), 84);
+
+    bool caught_exception = false;
+    try
+    {
+        hpx::start_task(throws()).get();
+        HPX_TEST(false);
+    }
+    catch (std::runtime_error const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    HPX_TEST_EQ(hpx::start_task(await_future()).get(), 43);
+    HPX_TEST_EQ(hpx::start_task(await_sender()).get(), 42);
+
+    {
+        hpx::channel<std::size_t> c;
+        hpx::future<std::size_t> f = hpx::start_task(await_channel(c));
+        for (std::size_t i = 0; i != 10; ++i)
+        {
+            c.set(i);
+        }
+        HPX_TEST_EQ(f.get(), std::size_t(45));
+    }
+
+    HPX_TEST_LTE(0.1, hpx::start_task(await_timer()).get());
+    HPX_TEST_EQ(hpx::start_task(recurse(1000)).get(), std::size_t(1000));
+}
+
+void test_many_suspended_tasks()
+{
+    std::size_t const num_tasks = 10000;
+
+    hpx::promise<void> p;
+    hpx::shared_future<void> sf = p.get_future();
+
+    std::vector<hpx::future<int>> fs;
+    fs.reserve(num_tasks);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        fs.push_back(hpx::start_task([](hpx::shared_future<void> f)
+                                         -> hpx::task<int> {
+            co_await f;
+            co_return 1;
+        }(sf)));
+    }
+
+    p.set_value();
+
+    int sum = 0;
+    for (auto& f : fs)
+    {
+        sum += f.get();
+    }
+    HPX_TEST_EQ(sum, int(num_tasks));
+}
+
+int hpx_main()
+{
+    test_task();
+    test_many_suspended_tasks();
+
+    return hpx::local::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::local::init(hpx_main, argc, argv), 0);
+    return hpx::util::report_errors();
+}
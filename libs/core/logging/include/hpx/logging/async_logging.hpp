@@ -0,0 +1,109 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace hpx { namespace util { namespace logging {
+
+    class logger;
+    class message;
+
+    /**
+    @brief Settings for the asynchronous logging backend
+
+    If asynchronous logging is enabled, messages written to a registered
+    logger are not handed to its destinations on the calling thread. Instead,
+    each OS-thread appends a compact binary record to its own lock-free ring
+    buffer. A single background OS-thread drains all ring buffers and either
+    passes the records on to the destinations of the originating logger or,
+    if @c binary_file is not empty, writes the raw records to that file. Binary
+    log files can be converted to text using @ref decode_binary_log.
+
+    In binary mode the formatters of the originating logger are not invoked at
+    all, each record carries a timestamp and the sequence number of the
+    producing OS-thread instead.
+    */
+    struct async_logging_settings
+    {
+        /// size (in bytes) of the ring buffer allocated for each OS-thread
+        std::size_t buffer_size = 65536;
+
+        /// if not empty, records are written to this file in binary form
+        std::string binary_file;
+    };
+
+    /// @brief Start the background thread of the asynchronous logging backend
+    HPX_CORE_EXPORT void enable_async_logging(
+        async_logging_settings const& settings = {});
+
+    /// @brief Drain all outstanding records, stop the background thread, and
+    /// switch all registered loggers back to synchronous operation
+    HPX_CORE_EXPORT void disable_async_logging();
+
+    /// @brief Return whether the asynchronous logging backend is running
+    HPX_CORE_EXPORT bool is_async_logging_enabled() noexcept;
+
+    /// @brief Synchronously hand all records written so far to their
+    /// destinations (or the binary log file)
+    HPX_CORE_EXPORT void flush_async_logging();
+
+    /// @brief Same as @ref flush_async_logging, but return without doing
+    /// anything if this would block. This is intended for use while the
+    /// process is terminating. This function is not async-signal-safe, it
+    /// must not be called from a signal handler.
+    HPX_CORE_EXPORT void try_flush_async_logging() noexcept;
+
+    /// @brief Route all messages written to the given logger through the
+    /// asynchronous backend. The name identifies the logger in binary log
+    /// files. This function has no effect if asynchronous logging is not
+    /// enabled.
+    HPX_CORE_EXPORT void register_async_logger(
+        logger& l, std::string const& name);
+
+    /// @brief Convert a binary log file as written by the asynchronous
+    /// logging backend into text, one line per record. Returns false if the
+    /// input is not a valid binary log.
+    HPX_CORE_EXPORT bool decode_binary_log(std::istream& in, std::ostream& out);
+
+    namespace detail {
+
+        ///////////////////////////////////////////////////////////////////////
+        // Layout of the records stored in the per-thread ring buffers and in
+        // binary log files. Each header is immediately followed by 'size'
+        // bytes of payload.
+        enum class record_kind : std::uint16_t
+        {
+            channel = 0,    // payload: name of the logger
+            message = 1     // payload: (formatted) message text
+        };
+
+        struct record_header
+        {
+            std::uint32_t size;          // size of the payload in bytes
+            std::uint16_t kind;          // record_kind
+            std::uint16_t channel;       // id of the originating logger
+            std::uint32_t thread;        // sequence number of OS-thread
+            std::uint32_t reserved;
+            std::uint64_t timestamp;    // nanoseconds
+        };
+
+        // every binary log file starts with this signature
+        constexpr char binary_log_signature[8] = {
+            'H', 'P', 'X', 'B', 'L', 'O', 'G', '1'};
+
+        constexpr std::uint16_t no_async_channel = 0xffff;
+
+        // append the given message to the ring buffer of the calling thread
+        HPX_CORE_EXPORT void async_write(logger& l, message const& msg);
+    }    // namespace detail
+}}}    // namespace hpx::util::logging
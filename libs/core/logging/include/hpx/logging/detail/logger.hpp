@@ -17,10 +17,13 @@
 #pragma once
 
 #include <hpx/config.hpp>
+#include <hpx/logging/async_logging.hpp>
 #include <hpx/logging/format/named_write.hpp>
 #include <hpx/logging/level.hpp>
 #include <hpx/modules/format.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
@@ -172,9 +175,29 @@ namespace hpx { namespace util { namespace logging {
         void write(message msg)
         {
             if (m_is_caching_off)
-                m_writer(msg);
+            {
+                if (async_channel() != detail::no_async_channel)
+                    detail::async_write(*this, msg);
+                else
+                    m_writer(msg);
+            }
             else
+            {
                 m_cache.push_back(HPX_MOVE(msg));
+            }
+        }
+
+        // id under which this logger is known to the asynchronous logging
+        // backend (detail::no_async_channel if messages are written
+        // synchronously)
+        std::uint16_t async_channel() const noexcept
+        {
+            return m_async_channel.load(std::memory_order_relaxed);
+        }
+
+        void set_async_channel(std::uint16_t channel) noexcept
+        {
+            m_async_channel.store(channel, std::memory_order_relaxed);
         }
 
     private:
@@ -182,5 +205,6 @@ namespace hpx { namespace util { namespace logging {
         mutable bool m_is_caching_off;
         writer::named_write m_writer;
         level m_level;
+        std::atomic<std::uint16_t> m_async_channel{detail::no_async_channel};
     };
 }}}    // namespace hpx::util::logging
@@ -404,6 +404,22 @@ This will just configure "file" twice, ending up with writing only to "two.txt"
 #endif
         }
 
+        /** @brief Applies the formatters only, used by the asynchronous
+        logging backend on the thread that produced the message
+    */
+        void format_message(std::stringstream& out, message const& msg) const
+        {
+            m_format(out, msg);
+        }
+
+        /** @brief Writes an already formatted message to all destinations,
+        used by the asynchronous logging backend
+    */
+        void write_formatted(message const& formatted) const
+        {
+            m_destination(formatted);
+        }
+
         /** @brief Replaces a formatter from the named formatter.
 
     You can use this, for instance, when you want to share
@@ -23,6 +23,7 @@ namespace hpx {
 #if defined(HPX_HAVE_LOGGING)
 
 #include <hpx/assertion/current_function.hpp>
+#include <hpx/logging/async_logging.hpp>
 #include <hpx/logging/level.hpp>
 #include <hpx/logging/logging.hpp>
 #include <hpx/modules/format.hpp>
@@ -0,0 +1,665 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_LOGGING)
+#include <hpx/assert.hpp>
+#include <hpx/logging/async_logging.hpp>
+#include <hpx/logging/detail/logger.hpp>
+#include <hpx/logging/message.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/timing/high_resolution_clock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace util { namespace logging { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Single-producer/single-consumer byte ring buffer. The producer is the
+    // OS-thread owning the buffer, the consumer is the background thread of
+    // the backend (or a thread calling flush_async_logging, serialized with
+    // the background thread through async_backend::drain_mtx_).
+    class ring_buffer
+    {
+    public:
+        ring_buffer(std::size_t capacity, std::uint32_t thread,
+            std::uint64_t generation)
+          : buffer_(capacity)
+          , thread_(thread)
+          , generation_(generation)
+        {
+        }
+
+        std::uint32_t thread() const noexcept
+        {
+            return thread_;
+        }
+
+        // the generation of the backend this buffer was created for
+        std::uint64_t generation() const noexcept
+        {
+            return generation_;
+        }
+
+        std::size_t capacity() const noexcept
+        {
+            return buffer_.size();
+        }
+
+        void orphan() noexcept
+        {
+            orphaned_.store(true, std::memory_order_release);
+        }
+
+        bool is_orphaned() const noexcept
+        {
+            return orphaned_.load(std::memory_order_acquire);
+        }
+
+        bool empty() const noexcept
+        {
+            return head_.load(std::memory_order_acquire) ==
+                tail_.load(std::memory_order_acquire);
+        }
+
+        // called by producer only, announces (and ends) a push, see
+        // async_backend::stop
+        void begin_write() noexcept
+        {
+            writing_.store(true, std::memory_order_seq_cst);
+        }
+
+        void end_write() noexcept
+        {
+            writing_.store(false, std::memory_order_release);
+        }
+
+        bool is_writing() const noexcept
+        {
+            return writing_.load(std::memory_order_seq_cst);
+        }
+
+        // called by producer only
+        void push(record_header const& hdr, char const* data)
+        {
+            std::size_t const size = sizeof(record_header) + hdr.size;
+            HPX_ASSERT(size <= buffer_.size());
+
+            std::size_t const tail = tail_.load(std::memory_order_relaxed);
+
+            // wait for the consumer to make room, this happens only if the
+            // background thread is not able to keep up
+            while (buffer_.size() -
+                    (tail - head_.load(std::memory_order_acquire)) <
+                size)
+            {
+                std::this_thread::yield();
+            }
+
+            copy_in(tail, reinterpret_cast<char const*>(&hdr),
+                sizeof(record_header));
+            copy_in(tail + sizeof(record_header), data, hdr.size);
+
+            tail_.store(tail + size, std::memory_order_release);
+        }
+
+        // called by consumer only
+        template <typename F>
+        void drain(F&& f)
+        {
+            std::size_t head = head_.load(std::memory_order_relaxed);
+            std::size_t const tail = tail_.load(std::memory_order_acquire);
+
+            std::string payload;
+            while (head != tail)
+            {
+                record_header hdr;
+                copy_out(head, reinterpret_cast<char*>(&hdr),
+                    sizeof(record_header));
+
+                payload.resize(hdr.size);
+                copy_out(head + sizeof(record_header), &payload[0], hdr.size);
+
+                head += sizeof(record_header) + hdr.size;
+                f(hdr, HPX_MOVE(payload));
+            }
+
+            head_.store(head, std::memory_order_release);
+        }
+
+    private:
+        void copy_in(std::size_t pos, char const* data, std::size_t size)
+        {
+            std::size_t const offset = pos % buffer_.size();
+            std::size_t const first = (std::min)(size, buffer_.size() - offset);
+            std::memcpy(&buffer_[offset], data, first);
+            if (first != size)
+            {
+                std::memcpy(&buffer_[0], data + first, size - first);
+            }
+        }
+
+        void copy_out(std::size_t pos, char* data, std::size_t size) const
+        {
+            std::size_t const offset = pos % buffer_.size();
+            std::size_t const first = (std::min)(size, buffer_.size() - offset);
+            std::memcpy(data, &buffer_[offset], first);
+            if (first != size)
+            {
+                std::memcpy(data + first, &buffer_[0], size - first);
+            }
+        }
+
+        std::vector<char> buffer_;
+        std::uint32_t thread_;
+        std::uint64_t generation_;
+        std::atomic<bool> orphaned_{false};
+
+        // keep producer and consumer positions on separate cache lines
+        alignas(64) std::atomic<std::size_t> head_{0};
+        alignas(64) std::atomic<std::size_t> tail_{0};
+        std::atomic<bool> writing_{false};
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct pending_record
+    {
+        record_header hdr;
+        std::string payload;
+    };
+
+    class async_backend
+    {
+    public:
+        async_backend() = default;
+
+        async_backend(async_backend const&) = delete;
+        async_backend(async_backend&&) = delete;
+        async_backend& operator=(async_backend const&) = delete;
+        async_backend& operator=(async_backend&&) = delete;
+
+        ~async_backend()
+        {
+            stop();
+        }
+
+        void start(async_logging_settings const& settings)
+        {
+            std::lock_guard<std::mutex> l(mtx_);
+            if (running_.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            // leave room for at least one full record header
+            buffer_size_ = (std::max)(settings.buffer_size,
+                std::size_t(4 * sizeof(record_header)));
+
+            if (!settings.binary_file.empty())
+            {
+                binary_out_.open(settings.binary_file.c_str(),
+                    std::ios_base::out | std::ios_base::binary |
+                        std::ios_base::trunc);
+                binary_out_.write(
+                    binary_log_signature, sizeof(binary_log_signature));
+                channels_written_.clear();
+            }
+            binary_mode_.store(
+                !settings.binary_file.empty(), std::memory_order_relaxed);
+
+            ++generation_;
+            running_.store(true, std::memory_order_release);
+            thread_ = std::thread(&async_backend::run, this);
+        }
+
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+                if (!running_.load(std::memory_order_relaxed))
+                {
+                    return;
+                }
+
+                // switch all loggers back to synchronous operation
+                for (logger* lg : loggers_)
+                {
+                    lg->set_async_channel(no_async_channel);
+                }
+
+                running_.store(false, std::memory_order_seq_cst);
+            }
+
+            if (thread_.joinable())
+            {
+                thread_.join();
+            }
+
+            // Producers announce a push before checking whether the backend
+            // is still running. Wait for the pushes which were announced
+            // before the backend was stopped, all later ones are written
+            // synchronously. Keep draining, as a producer might wait for
+            // room in its ring buffer.
+            std::vector<std::shared_ptr<ring_buffer>> rings;
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+                rings = rings_;
+            }
+
+            for (auto const& r : rings)
+            {
+                while (r->is_writing())
+                {
+                    drain();
+                    std::this_thread::yield();
+                }
+            }
+
+            // drain whatever was written before the loggers were switched
+            drain();
+
+            // the ring buffers are shared with the threads which wrote to
+            // them, those will allocate new ones once the backend is
+            // restarted
+            std::lock_guard<std::mutex> l(mtx_);
+            rings_.clear();
+            if (binary_out_.is_open())
+            {
+                binary_out_.flush();
+                binary_out_.close();
+            }
+            binary_mode_.store(false, std::memory_order_relaxed);
+        }
+
+        bool is_running() const noexcept
+        {
+            return running_.load(std::memory_order_acquire);
+        }
+
+        void register_logger(logger& lg, std::string const& name)
+        {
+            std::lock_guard<std::mutex> l(mtx_);
+            if (!running_.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            auto it = std::find(loggers_.begin(), loggers_.end(), &lg);
+            if (it == loggers_.end())
+            {
+                HPX_ASSERT(loggers_.size() < no_async_channel);
+                loggers_.push_back(&lg);
+                names_.push_back(name);
+                it = loggers_.end() - 1;
+            }
+            else
+            {
+                names_[it - loggers_.begin()] = name;
+            }
+
+            lg.set_async_channel(
+                static_cast<std::uint16_t>(it - loggers_.begin()));
+        }
+
+        void write(logger& lg, message const& msg)
+        {
+            ring_buffer* ring = get_local_ring();
+            if (ring == nullptr)
+            {
+                // the backend was stopped concurrently
+                lg.writer()(msg);
+                return;
+            }
+
+            std::string text;
+            if (binary_mode_.load(std::memory_order_relaxed))
+            {
+                // binary records carry the unformatted message only
+                text = msg.full_string();
+            }
+            else
+            {
+                std::stringstream out;
+                lg.writer().format_message(out, msg);
+                text = out.str();
+            }
+
+            ring->begin_write();
+
+            std::uint16_t const channel = lg.async_channel();
+            if (channel == no_async_channel ||
+                !running_.load(std::memory_order_seq_cst) ||
+                ring->generation() != generation_.load())
+            {
+                // the backend was stopped (or restarted) concurrently
+                ring->end_write();
+                lg.writer()(msg);
+                return;
+            }
+
+            record_header hdr;
+            hdr.kind = static_cast<std::uint16_t>(record_kind::message);
+            hdr.channel = channel;
+            hdr.reserved = 0;
+            hdr.timestamp = hpx::chrono::high_resolution_clock::now();
+            hdr.thread = ring->thread();
+
+            // truncate messages which would not fit into the ring buffer
+            std::size_t const max_size =
+                ring->capacity() - sizeof(record_header);
+            hdr.size = static_cast<std::uint32_t>(
+                (std::min)(text.size(), max_size));
+
+            ring->push(hdr, text.data());
+            ring->end_write();
+        }
+
+        // If wait is false, give up instead of blocking on a lock held by
+        // another thread. This is used while terminating, where the lock
+        // might be held by the thread which was interrupted.
+        void drain(bool wait = true)
+        {
+            std::unique_lock<std::mutex> drain_lock(
+                drain_mtx_, std::defer_lock);
+            if (!acquire(drain_lock, wait))
+            {
+                return;
+            }
+
+            std::vector<std::shared_ptr<ring_buffer>> rings;
+            {
+                std::unique_lock<std::mutex> l(mtx_, std::defer_lock);
+                if (!acquire(l, wait))
+                {
+                    return;
+                }
+
+                // drop buffers of exited threads once they have been drained
+                rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                 [](std::shared_ptr<ring_buffer> const& r) {
+                                     return r->is_orphaned() && r->empty();
+                                 }),
+                    rings_.end());
+                rings = rings_;
+            }
+
+            records_.clear();
+            for (auto const& r : rings)
+            {
+                r->drain([this](record_header const& hdr, std::string&& data) {
+                    records_.push_back(pending_record{hdr, HPX_MOVE(data)});
+                });
+            }
+
+            if (records_.empty())
+            {
+                return;
+            }
+
+            // records from different threads are interleaved by time
+            std::stable_sort(records_.begin(), records_.end(),
+                [](pending_record const& lhs, pending_record const& rhs) {
+                    return lhs.hdr.timestamp < rhs.hdr.timestamp;
+                });
+
+            for (pending_record const& rec : records_)
+            {
+                dispatch(rec);
+            }
+
+            if (binary_out_.is_open())
+            {
+                binary_out_.flush();
+            }
+        }
+
+    private:
+        static bool acquire(std::unique_lock<std::mutex>& l, bool wait)
+        {
+            if (!wait)
+            {
+                return l.try_lock();
+            }
+            l.lock();
+            return true;
+        }
+
+        struct local_ring_holder
+        {
+            ~local_ring_holder()
+            {
+                if (ring)
+                {
+                    ring->orphan();
+                }
+            }
+
+            std::shared_ptr<ring_buffer> ring;
+        };
+
+        // returns nullptr if the backend is not running
+        ring_buffer* get_local_ring()
+        {
+            static thread_local local_ring_holder holder;
+
+            if (!holder.ring || holder.ring->generation() != generation_)
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+                if (!running_.load(std::memory_order_relaxed))
+                {
+                    return nullptr;
+                }
+
+                if (holder.ring)
+                {
+                    holder.ring->orphan();
+                }
+
+                holder.ring = std::make_shared<ring_buffer>(
+                    buffer_size_, next_thread_++, generation_);
+                rings_.push_back(holder.ring);
+            }
+            return holder.ring.get();
+        }
+
+        void dispatch(pending_record const& rec)
+        {
+            if (binary_out_.is_open())
+            {
+                // emit the name of the logger the first time it's referenced
+                if (channels_written_.size() <= rec.hdr.channel)
+                {
+                    channels_written_.resize(rec.hdr.channel + 1, false);
+                }
+
+                if (!channels_written_[rec.hdr.channel])
+                {
+                    std::string name;
+                    {
+                        std::lock_guard<std::mutex> l(mtx_);
+                        name = names_[rec.hdr.channel];
+                    }
+
+                    record_header hdr = rec.hdr;
+                    hdr.kind = static_cast<std::uint16_t>(record_kind::channel);
+                    hdr.size = static_cast<std::uint32_t>(name.size());
+                    binary_out_.write(reinterpret_cast<char const*>(&hdr),
+                        sizeof(record_header));
+                    binary_out_.write(name.data(), name.size());
+
+                    channels_written_[rec.hdr.channel] = true;
+                }
+
+                binary_out_.write(reinterpret_cast<char const*>(&rec.hdr),
+                    sizeof(record_header));
+                binary_out_.write(rec.payload.data(), rec.payload.size());
+                return;
+            }
+
+            logger* lg = nullptr;
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+                lg = loggers_[rec.hdr.channel];
+            }
+
+            std::stringstream out;
+            out << rec.payload;
+            lg->writer().write_formatted(message(HPX_MOVE(out)));
+        }
+
+        void run()
+        {
+            while (running_.load(std::memory_order_acquire))
+            {
+                drain();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        std::mutex mtx_;          // protects registration data
+        std::mutex drain_mtx_;    // serializes consumers
+
+        std::atomic<bool> running_{false};
+        std::thread thread_;
+
+        std::size_t buffer_size_ = 0;
+        std::atomic<std::uint64_t> generation_{0};
+        std::atomic<bool> binary_mode_{false};
+        std::uint32_t next_thread_ = 0;
+
+        std::vector<std::shared_ptr<ring_buffer>> rings_;
+        std::vector<logger*> loggers_;
+        std::vector<std::string> names_;
+
+        std::vector<pending_record> records_;
+
+        std::ofstream binary_out_;
+        std::vector<bool> channels_written_;
+    };
+
+    async_backend& get_async_backend()
+    {
+        static async_backend backend;
+        return backend;
+    }
+
+    void async_write(logger& l, message const& msg)
+    {
+        get_async_backend().write(l, msg);
+    }
+}}}}    // namespace hpx::util::logging::detail
+
+namespace hpx { namespace util { namespace logging {
+
+    void enable_async_logging(async_logging_settings const& settings)
+    {
+        detail::get_async_backend().start(settings);
+    }
+
+    void disable_async_logging()
+    {
+        detail::get_async_backend().stop();
+    }
+
+    bool is_async_logging_enabled() noexcept
+    {
+        return detail::get_async_backend().is_running();
+    }
+
+    void flush_async_logging()
+    {
+        detail::get_async_backend().drain();
+    }
+
+    void try_flush_async_logging() noexcept
+    {
+        try
+        {
+            detail::get_async_backend().drain(false);
+        }
+        catch (...)
+        {
+            // nothing we can do while terminating
+        }
+    }
+
+    void register_async_logger(logger& l, std::string const& name)
+    {
+        detail::get_async_backend().register_logger(l, name);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool decode_binary_log(std::istream& in, std::ostream& out)
+    {
+        char signature[sizeof(detail::binary_log_signature)];
+        if (!in.read(signature, sizeof(signature)) ||
+            std::memcmp(signature, detail::binary_log_signature,
+                sizeof(signature)) != 0)
+        {
+            return false;
+        }
+
+        std::vector<std::string> channels;
+        std::string payload;
+
+        detail::record_header hdr;
+        while (in.read(reinterpret_cast<char*>(&hdr), sizeof(hdr)))
+        {
+            payload.resize(hdr.size);
+            if (hdr.size != 0 && !in.read(&payload[0], hdr.size))
+            {
+                return false;    // truncated record
+            }
+
+            switch (static_cast<detail::record_kind>(hdr.kind))
+            {
+            case detail::record_kind::channel:
+                if (channels.size() <= hdr.channel)
+                {
+                    channels.resize(hdr.channel + 1);
+                }
+                channels[hdr.channel] = payload;
+                break;
+
+            case detail::record_kind::message:
+            {
+                std::string const& name = hdr.channel < channels.size() ?
+                    channels[hdr.channel] :
+                    std::string();
+
+                util::format_to(out, "[{}] {:016x} (T{:08x}) {}", name,
+                    hdr.timestamp, hdr.thread, payload);
+                if (payload.empty() || payload.back() != '\n')
+                {
+                    out << '\n';
+                }
+                break;
+            }
+
+            default:
+                return false;
+            }
+        }
+        return in.eof();
+    }
+}}}    // namespace hpx::util::logging
+
+#endif    // HPX_HAVE_LOGGING
@@ -0,0 +1,205 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Write to a logger from several threads through the asynchronous logging
+// backend and verify that the binary log file decodes to all messages, in the
+// order they were written by each thread, and that no messages are lost if
+// the backend is stopped while the threads are writing.
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_LOGGING)
+#include <hpx/modules/filesystem.hpp>
+#include <hpx/modules/logging.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace logging = hpx::util::logging;
+
+constexpr std::size_t num_threads = 4;
+constexpr std::size_t num_messages = 1000;
+
+///////////////////////////////////////////////////////////////////////////////
+void write_messages(logging::logger& lg, std::size_t thread)
+{
+    for (std::size_t i = 0; i != num_messages; ++i)
+    {
+        lg.gather().format("message {} {}", thread, i);
+
+        // make sure flushing concurrently with the background thread works
+        if (thread == 0 && i == num_messages / 2)
+        {
+            logging::flush_async_logging();
+        }
+    }
+}
+
+void test_binary_log(std::string const& path)
+{
+    logging::logger lg;
+    lg.mark_as_initialized();
+
+    // use small ring buffers to make the writers wait for the backend
+    logging::async_logging_settings settings;
+    settings.buffer_size = 1024;
+    settings.binary_file = path;
+
+    logging::enable_async_logging(settings);
+    HPX_TEST(logging::is_async_logging_enabled());
+
+    logging::register_async_logger(lg, "TEST");
+    HPX_TEST_NEQ(lg.async_channel(), logging::detail::no_async_channel);
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t != num_threads; ++t)
+    {
+        threads.emplace_back(write_messages, std::ref(lg), t);
+    }
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    logging::disable_async_logging();
+    HPX_TEST(!logging::is_async_logging_enabled());
+    HPX_TEST_EQ(lg.async_channel(), logging::detail::no_async_channel);
+
+    // decode the binary log, each line has the form
+    // '[TEST] <timestamp> (T<thread>) message <thread> <i>'
+    std::ifstream in(path, std::ios_base::in | std::ios_base::binary);
+    std::stringstream out;
+    HPX_TEST(logging::decode_binary_log(in, out));
+
+    std::vector<std::size_t> next(num_threads, 0);
+    std::size_t received = 0;
+
+    std::string line;
+    while (std::getline(out, line))
+    {
+        HPX_TEST_EQ(line.compare(0, 7, "[TEST] "), 0);
+
+        std::string::size_type const pos = line.find(") ");
+        HPX_TEST_NEQ(pos, std::string::npos);
+        if (pos == std::string::npos)
+        {
+            continue;
+        }
+
+        std::istringstream payload(line.substr(pos + 2));
+        std::string text;
+        std::size_t thread = num_threads;
+        std::size_t i = 0;
+        payload >> text >> thread >> i;
+
+        HPX_TEST_EQ(text, std::string("message"));
+        HPX_TEST_LT(thread, num_threads);
+        if (thread < num_threads)
+        {
+            HPX_TEST_EQ(i, next[thread]);
+            next[thread] = i + 1;
+        }
+        ++received;
+    }
+
+    HPX_TEST_EQ(received, num_threads * num_messages);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct counting_destination : logging::destination::manipulator
+{
+    explicit counting_destination(std::atomic<std::size_t>& count)
+      : count_(count)
+    {
+    }
+
+    void operator()(logging::message const&) override
+    {
+        ++count_;
+    }
+
+    std::atomic<std::size_t>& count_;
+};
+
+void test_stop_while_writing()
+{
+    constexpr std::size_t num_stop_messages = 20000;
+
+    std::atomic<std::size_t> received(0);
+
+    logging::logger lg;
+    lg.writer().set_destination("counter", counting_destination(received));
+    lg.writer().write("|\n", "counter");
+    lg.mark_as_initialized();
+
+    logging::async_logging_settings settings;
+    settings.buffer_size = 1024;
+
+    logging::enable_async_logging(settings);
+    logging::register_async_logger(lg, "STOP");
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t != num_threads; ++t)
+    {
+        threads.emplace_back([&lg, t]() {
+            for (std::size_t i = 0; i != num_stop_messages; ++i)
+            {
+                lg.gather().format("message {} {}", t, i);
+            }
+        });
+    }
+
+    // messages written after this are handed to the destination directly
+    while (received.load() == 0)
+    {
+        std::this_thread::yield();
+    }
+    logging::disable_async_logging();
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    HPX_TEST_EQ(received.load(), num_threads * num_stop_messages);
+}
+
+void test_invalid_log()
+{
+    std::stringstream in("not a binary log file");
+    std::stringstream out;
+    HPX_TEST(!logging::decode_binary_log(in, out));
+}
+
+int main()
+{
+    hpx::filesystem::path const path =
+        hpx::filesystem::temp_directory_path() /
+        ("hpx_async_logging_" +
+            std::to_string(
+                std::hash<std::thread::id>()(std::this_thread::get_id())));
+
+    test_binary_log(path.string());
+    test_stop_while_writing();
+    test_invalid_log();
+
+    hpx::filesystem::remove(path);
+
+    return hpx::util::report_errors();
+}
+#else
+int main()
+{
+    return 0;
+}
+#endif
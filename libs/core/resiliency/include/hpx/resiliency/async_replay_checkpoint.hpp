@@ -0,0 +1,297 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/resiliency/config.hpp>
+#include <hpx/resiliency/resiliency_cpos.hpp>
+#include <hpx/resiliency/util.hpp>
+
+#include <hpx/functional/detail/invoke.hpp>
+#include <hpx/futures/future.hpp>
+#include <hpx/modules/async_local.hpp>
+#include <hpx/serialization/input_archive.hpp>
+#include <hpx/serialization/output_archive.hpp>
+#include <hpx/serialization/serialize.hpp>
+#include <hpx/type_support/pack.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace resiliency { namespace experimental {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Statistics collected by all invocations of async_replay_checkpoint on
+    // this locality.
+
+    // return the number of checkpoints taken
+    HPX_CORE_EXPORT std::int64_t get_replay_checkpoint_count(bool reset);
+
+    // return the accumulated size of all checkpoints taken (in bytes)
+    HPX_CORE_EXPORT std::int64_t get_replay_checkpoint_bytes(bool reset);
+
+    // return the number of replays that resumed from a checkpoint
+    HPX_CORE_EXPORT std::int64_t get_replay_resumed_count(bool reset);
+
+    // return the number of replays that had to restart from scratch as no
+    // checkpoint was available
+    HPX_CORE_EXPORT std::int64_t get_replay_restarted_count(bool reset);
+
+    // return the accumulated amount of work (as reported by the progress
+    // given to replay_checkpoint::save) that did not have to be redone
+    // because a replay resumed from a checkpoint
+    HPX_CORE_EXPORT std::int64_t get_replay_work_saved(bool reset);
+
+    namespace detail {
+
+        HPX_CORE_EXPORT void record_replay_checkpoint(std::size_t bytes);
+        HPX_CORE_EXPORT void record_replay_resumed(std::uint64_t progress);
+        HPX_CORE_EXPORT void record_replay_restarted();
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    // In-memory checkpoint handed to the function launched by
+    // async_replay_checkpoint. The function calls save() periodically to
+    // record its state and calls restore() on entry to resume from the last
+    // checkpoint taken by a previous (failed) attempt. The state is
+    // serialized using the HPX serialization archives, i.e. all types have
+    // to be serializable.
+    class replay_checkpoint
+    {
+    public:
+        replay_checkpoint() = default;
+
+        replay_checkpoint(replay_checkpoint const&) = delete;
+        replay_checkpoint(replay_checkpoint&&) = delete;
+        replay_checkpoint& operator=(replay_checkpoint const&) = delete;
+        replay_checkpoint& operator=(replay_checkpoint&&) = delete;
+
+        // return whether a checkpoint is available
+        bool has_value() const noexcept
+        {
+            return valid_;
+        }
+
+        // return the progress recorded with the last checkpoint
+        std::uint64_t progress() const noexcept
+        {
+            return progress_;
+        }
+
+        // Record the given state as the new checkpoint. The progress is an
+        // application defined measure of the work done so far (for instance
+        // the number of completed iterations). The previous checkpoint stays
+        // valid if serializing the state fails.
+        template <typename... Ts>
+        void save(std::uint64_t progress, Ts const&... state)
+        {
+            std::vector<char> data;
+            {
+                hpx::serialization::output_archive archive(data);
+                (archive << ... << state);
+            }
+
+            detail::record_replay_checkpoint(data.size());
+
+            data_ = HPX_MOVE(data);
+            progress_ = progress;
+            valid_ = true;
+        }
+
+        // Restore the state recorded by the last checkpoint, return false
+        // (leaving the arguments untouched) if no checkpoint is available.
+        template <typename... Ts>
+        bool restore(Ts&... state)
+        {
+            if (!valid_)
+            {
+                return false;
+            }
+
+            hpx::serialization::input_archive archive(data_, data_.size());
+            (archive >> ... >> state);
+            return true;
+        }
+
+        // discard the current checkpoint
+        void reset() noexcept
+        {
+            data_.clear();
+            progress_ = 0;
+            valid_ = false;
+        }
+
+    private:
+        std::vector<char> data_;
+        std::uint64_t progress_ = 0;
+        bool valid_ = false;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail {
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Result, typename Pred, typename F, typename Tuple>
+        struct async_replay_checkpoint_helper
+          : std::enable_shared_from_this<
+                async_replay_checkpoint_helper<Result, Pred, F, Tuple>>
+        {
+            template <typename Pred_, typename F_, typename Tuple_>
+            async_replay_checkpoint_helper(
+                Pred_&& pred, F_&& f, Tuple_&& tuple)
+              : pred_(HPX_FORWARD(Pred_, pred))
+              , f_(HPX_FORWARD(F_, f))
+              , t_(HPX_FORWARD(Tuple_, tuple))
+            {
+            }
+
+            template <std::size_t... Is>
+            hpx::future<Result> invoke(hpx::util::index_pack<Is...>)
+            {
+                return hpx::async(
+                    f_, std::ref(checkpoint_), std::get<Is>(t_)...);
+            }
+
+            hpx::future<Result> call(std::size_t n, bool retry = false)
+            {
+                if (retry)
+                {
+                    if (checkpoint_.has_value())
+                    {
+                        record_replay_resumed(checkpoint_.progress());
+                    }
+                    else
+                    {
+                        record_replay_restarted();
+                    }
+                }
+
+                // launch given function asynchronously
+                hpx::future<Result> f = invoke(hpx::util::make_index_pack<
+                    std::tuple_size<Tuple>::value>{});
+
+                // attach a continuation that will relaunch the task, if
+                // necessary
+                auto this_ = this->shared_from_this();
+                return f.then(hpx::launch::sync,
+                    [this_ = HPX_MOVE(this_), n](hpx::future<Result>&& f) {
+                        if (f.has_exception())
+                        {
+                            // rethrow abort_replay_exception, if caught
+                            auto ex = rethrow_on_abort_replay(f);
+
+                            // execute the task again (resuming from the last
+                            // checkpoint) if an error occurred and this was
+                            // not the last attempt
+                            if (n != 0)
+                            {
+                                return this_->call(n - 1, true);
+                            }
+
+                            // rethrow exception if the number of replays has
+                            // been exhausted
+                            std::rethrow_exception(ex);
+                        }
+
+                        auto&& result = f.get();
+
+                        if (!HPX_INVOKE(this_->pred_, result))
+                        {
+                            // an invalid result may have been computed from
+                            // a corrupted checkpoint, start over
+                            this_->checkpoint_.reset();
+
+                            if (n != 0)
+                            {
+                                return this_->call(n - 1, true);
+                            }
+
+                            // throw aborting exception as attempts were
+                            // exhausted
+                            throw abort_replay_exception();
+                        }
+
+                        if (n != 0)
+                        {
+                            // return result
+                            return hpx::make_ready_future(HPX_MOVE(result));
+                        }
+
+                        // throw aborting exception as attempts were
+                        // exhausted
+                        throw abort_replay_exception();
+                    });
+            }
+
+            Pred pred_;
+            F f_;
+            Tuple t_;
+            replay_checkpoint checkpoint_;
+        };
+
+        template <typename Result, typename Pred, typename F, typename... Ts>
+        std::shared_ptr<async_replay_checkpoint_helper<Result,
+            typename std::decay<Pred>::type, typename std::decay<F>::type,
+            std::tuple<typename std::decay<Ts>::type...>>>
+        make_async_replay_checkpoint_helper(Pred&& pred, F&& f, Ts&&... ts)
+        {
+            using return_type = async_replay_checkpoint_helper<Result,
+                typename std::decay<Pred>::type, typename std::decay<F>::type,
+                std::tuple<typename std::decay<Ts>::type...>>;
+
+            return std::make_shared<return_type>(HPX_FORWARD(Pred, pred),
+                HPX_FORWARD(F, f), std::make_tuple(HPX_FORWARD(Ts, ts)...));
+        }
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Asynchronously launch given function \a f, passing a replay_checkpoint
+    // as its first argument. Verify the result of those invocations using
+    // the given predicate \a pred. Repeat launching on error exactly \a n
+    // times (except if abort_replay_exception is thrown), each repeated
+    // invocation can resume from the last checkpoint taken.
+    template <typename Pred, typename F, typename... Ts>
+    hpx::future<typename hpx::util::detail::invoke_deferred_result<F,
+        std::reference_wrapper<replay_checkpoint>, Ts...>::type>
+    tag_invoke(async_replay_checkpoint_validate_t, std::size_t n, Pred&& pred,
+        F&& f, Ts&&... ts)
+    {
+        using result_type = typename hpx::util::detail::invoke_deferred_result<
+            F, std::reference_wrapper<replay_checkpoint>, Ts...>::type;
+
+        auto helper = detail::make_async_replay_checkpoint_helper<result_type>(
+            HPX_FORWARD(Pred, pred), HPX_FORWARD(F, f), HPX_FORWARD(Ts, ts)...);
+
+        return helper->call(n);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Asynchronously launch given function \a f, passing a replay_checkpoint
+    // as its first argument. Repeat launching on error exactly \a n times
+    // (except if abort_replay_exception is thrown), each repeated invocation
+    // can resume from the last checkpoint taken.
+    template <typename F, typename... Ts>
+    hpx::future<typename hpx::util::detail::invoke_deferred_result<F,
+        std::reference_wrapper<replay_checkpoint>, Ts...>::type>
+    tag_invoke(async_replay_checkpoint_t, std::size_t n, F&& f, Ts&&... ts)
+    {
+        using result_type = typename hpx::util::detail::invoke_deferred_result<
+            F, std::reference_wrapper<replay_checkpoint>, Ts...>::type;
+
+        auto helper = detail::make_async_replay_checkpoint_helper<result_type>(
+            detail::replay_validator{}, HPX_FORWARD(F, f),
+            HPX_FORWARD(Ts, ts)...);
+
+        return helper->call(n);
+    }
+}}}    // namespace hpx::resiliency::experimental
@@ -15,12 +15,20 @@
 #include <hpx/resiliency/util.hpp>
 
 #include <hpx/functional/detail/invoke.hpp>
+#include <hpx/functional/traits/is_invocable.hpp>
 #include <hpx/futures/future.hpp>
+#include <hpx/futures/promise.hpp>
 #include <hpx/modules/async_local.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+#include <hpx/synchronization/stop_token.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <exception>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -29,24 +37,195 @@ namespace hpx { namespace resiliency { namespace experimental {
     ///////////////////////////////////////////////////////////////////////////
     namespace detail {
 
+        ///////////////////////////////////////////////////////////////////////
+        // thrown by replicas which were cancelled before they started running
+        struct replica_cancelled : std::exception
+        {
+        };
+
+        // Wraps the function executed by a replica. The replica is skipped if
+        // a stop was requested before it started running. The stop token is
+        // passed as the first argument to functions accepting it, which
+        // allows for replicas to stop early once their result is not needed
+        // anymore.
+        template <typename F>
+        struct replica_function
+        {
+            hpx::stop_token token;
+            F f;
+
+            template <typename... Ts>
+            decltype(auto) operator()(Ts&&... ts)
+            {
+                if (token.stop_requested())
+                {
+                    throw replica_cancelled{};
+                }
+
+                if constexpr (hpx::is_invocable_v<F, hpx::stop_token const&,
+                                  Ts&&...>)
+                {
+                    return HPX_INVOKE(
+                        HPX_MOVE(f), token, HPX_FORWARD(Ts, ts)...);
+                }
+                else
+                {
+                    return HPX_INVOKE(HPX_MOVE(f), HPX_FORWARD(Ts, ts)...);
+                }
+            }
+        };
+
+        template <typename F, typename... Ts>
+        using replicate_result = hpx::util::detail::invoke_deferred_result<
+            replica_function<std::decay_t<F>>, Ts...>;
+
+        template <typename F, typename... Ts>
+        using replicate_result_t = typename replicate_result<F, Ts...>::type;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Shared state of all replicas of a call to async_replicate or
+        // async_replicate_validate. The first valid result is returned
+        // without waiting for the remaining replicas, those are asked to
+        // stop.
+        template <typename Result, typename Pred>
+        struct replicate_first_valid_state
+        {
+            template <typename Pred_>
+            replicate_first_valid_state(std::size_t n, Pred_&& pred)
+              : pred_(HPX_FORWARD(Pred_, pred))
+              , remaining_(n)
+            {
+            }
+
+            void set_value(Result&& result)
+            {
+                if (!done_.exchange(true))
+                {
+                    stop_source_.request_stop();
+                    promise_.set_value(HPX_MOVE(result));
+                }
+            }
+
+            void set_exception(std::exception_ptr ex)
+            {
+                if (!done_.exchange(true))
+                {
+                    stop_source_.request_stop();
+                    promise_.set_exception(HPX_MOVE(ex));
+                }
+            }
+
+            void store_exception(std::exception_ptr ex)
+            {
+                std::lock_guard<hpx::spinlock> l(mtx_);
+                ex_ = HPX_MOVE(ex);
+            }
+
+            // handle the (ready) future of one replica
+            void replica_ready(hpx::future<Result>&& f)
+            {
+                try
+                {
+                    auto&& result = f.get();
+                    if (!done_.load(std::memory_order_relaxed) &&
+                        HPX_INVOKE(pred_, result))
+                    {
+                        set_value(HPX_MOVE(result));
+                    }
+                }
+                catch (replica_cancelled const&)
+                {
+                    // this replica was not needed anymore
+                }
+                catch (abort_replicate_exception const&)
+                {
+                    set_exception(std::current_exception());
+                }
+                catch (...)
+                {
+                    store_exception(std::current_exception());
+                }
+
+                if (--remaining_ == 0 && !done_.load())
+                {
+                    // no valid result was produced
+                    std::exception_ptr ex;
+                    {
+                        std::lock_guard<hpx::spinlock> l(mtx_);
+                        ex = HPX_MOVE(ex_);
+                    }
+
+                    if (!ex)
+                    {
+                        ex = std::make_exception_ptr(
+                            abort_replicate_exception{});
+                    }
+                    set_exception(HPX_MOVE(ex));
+                }
+            }
+
+            Pred pred_;
+            hpx::stop_source stop_source_;
+            hpx::promise<Result> promise_;
+            std::atomic<std::size_t> remaining_;
+            std::atomic<bool> done_{false};
+            hpx::spinlock mtx_;
+            std::exception_ptr ex_;
+        };
+
+        template <typename Pred, typename F, typename... Ts>
+        hpx::future<replicate_result_t<F, Ts...>> async_replicate_first_valid(
+            std::size_t n, Pred&& pred, F&& f, Ts&&... ts)
+        {
+            using result_type = replicate_result_t<F, Ts...>;
+            using state_type =
+                replicate_first_valid_state<result_type, std::decay_t<Pred>>;
+
+            if (n == 0)
+            {
+                return hpx::make_exceptional_future<result_type>(
+                    abort_replicate_exception{});
+            }
+
+            auto state =
+                std::make_shared<state_type>(n, HPX_FORWARD(Pred, pred));
+            hpx::future<result_type> result = state->promise_.get_future();
+
+            // launch given function n times, the replicas which have not
+            // started running by the time a valid result is available are
+            // skipped
+            replica_function<std::decay_t<F>> replica{
+                state->stop_source_.get_token(), HPX_FORWARD(F, f)};
+
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                hpx::async(replica, ts...)
+                    .then(hpx::launch::sync,
+                        [state](hpx::future<result_type>&& f) {
+                            state->replica_ready(HPX_MOVE(f));
+                        });
+            }
+
+            return result;
+        }
+
         ///////////////////////////////////////////////////////////////////////
         template <typename Vote, typename Pred, typename F, typename... Ts>
-        hpx::future<
-            typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type>
-        async_replicate_vote_validate(
+        hpx::future<replicate_result_t<F, Ts...>> async_replicate_vote_all(
             std::size_t n, Vote&& vote, Pred&& pred, F&& f, Ts&&... ts)
         {
-            using result_type =
-                typename hpx::util::detail::invoke_deferred_result<F,
-                    Ts...>::type;
+            using result_type = replicate_result_t<F, Ts...>;
 
             // launch given function n times
             std::vector<hpx::future<result_type>> results;
             results.reserve(n);
 
+            replica_function<std::decay_t<F>> replica{
+                hpx::stop_token(), HPX_FORWARD(F, f)};
+
             for (std::size_t i = 0; i != n; ++i)
             {
-                results.emplace_back(hpx::async(f, ts...));
+                results.emplace_back(hpx::async(replica, ts...));
             }
 
             // wait for all threads to finish executing and return the first result
@@ -94,17 +273,36 @@ namespace hpx { namespace resiliency { namespace experimental {
                 },
                 HPX_MOVE(results));
         }
+
+        template <typename Vote, typename Pred, typename F, typename... Ts>
+        hpx::future<replicate_result_t<F, Ts...>>
+        async_replicate_vote_validate(
+            std::size_t n, Vote&& vote, Pred&& pred, F&& f, Ts&&... ts)
+        {
+            // The default voter selects the first valid result, there is no
+            // need to wait for all replicas in this case.
+            if constexpr (std::is_same_v<std::decay_t<Vote>, replicate_voter>)
+            {
+                return async_replicate_first_valid(n, HPX_FORWARD(Pred, pred),
+                    HPX_FORWARD(F, f), HPX_FORWARD(Ts, ts)...);
+            }
+            else
+            {
+                return async_replicate_vote_all(n, HPX_FORWARD(Vote, vote),
+                    HPX_FORWARD(Pred, pred), HPX_FORWARD(F, f),
+                    HPX_FORWARD(Ts, ts)...);
+            }
+        }
     }    // namespace detail
 
     ///////////////////////////////////////////////////////////////////////////
     // Asynchronously launch given function \a f exactly \a n times. Verify
     // the result of those invocations using the given predicate \a pred.
     // Run all the valid results against a user provided voting function.
-    // Return the valid output.
+    // Return the valid output. All replicas are run to completion.
     template <typename Vote, typename Pred, typename F, typename... Ts>
-    hpx::future<
-        typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type>
-    tag_invoke(async_replicate_vote_validate_t, std::size_t n, Vote&& vote,
+    hpx::future<detail::replicate_result_t<F, Ts...>> tag_invoke(
+        async_replicate_vote_validate_t, std::size_t n, Vote&& vote,
         Pred&& pred, F&& f, Ts&&... ts)
     {
         return detail::async_replicate_vote_validate(n, HPX_FORWARD(Vote, vote),
@@ -115,11 +313,9 @@ namespace hpx { namespace resiliency { namespace experimental {
     // Asynchronously launch given function \a f exactly \a n times. Verify
     // the result of those invocations using the given predicate \a pred. Run
     // all the valid results against a user provided voting function.
-    // Return the valid output.
+    // Return the valid output. All replicas are run to completion.
     template <typename Vote, typename F, typename... Ts>
-    hpx::future<
-        typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type>
-    tag_invoke(
+    hpx::future<detail::replicate_result_t<F, Ts...>> tag_invoke(
         async_replicate_vote_t, std::size_t n, Vote&& vote, F&& f, Ts&&... ts)
     {
         return detail::async_replicate_vote_validate(n, HPX_FORWARD(Vote, vote),
@@ -130,11 +326,11 @@ namespace hpx { namespace resiliency { namespace experimental {
     ///////////////////////////////////////////////////////////////////////////
     // Asynchronously launch given function \a f exactly \a n times. Verify
     // the result of those invocations using the given predicate \a pred.
-    // Return the first valid result.
+    // Return the first valid result, the remaining replicas are asked to stop
+    // once it is available.
     template <typename Pred, typename F, typename... Ts>
-    hpx::future<
-        typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type>
-    tag_invoke(async_replicate_validate_t, std::size_t n, Pred&& pred, F&& f,
+    hpx::future<detail::replicate_result_t<F, Ts...>> tag_invoke(
+        async_replicate_validate_t, std::size_t n, Pred&& pred, F&& f,
         Ts&&... ts)
     {
         return detail::async_replicate_vote_validate(n,
@@ -145,11 +341,11 @@ namespace hpx { namespace resiliency { namespace experimental {
     ///////////////////////////////////////////////////////////////////////////
     // Asynchronously launch given function \a f exactly \a n times. Verify
     // the result of those invocations by checking for exception.
-    // Return the first valid result.
+    // Return the first valid result, the remaining replicas are asked to stop
+    // once it is available.
     template <typename F, typename... Ts>
-    hpx::future<
-        typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type>
-    tag_invoke(async_replicate_t, std::size_t n, F&& f, Ts&&... ts)
+    hpx::future<detail::replicate_result_t<F, Ts...>> tag_invoke(
+        async_replicate_t, std::size_t n, F&& f, Ts&&... ts)
     {
         return detail::async_replicate_vote_validate(n,
             detail::replicate_voter{}, detail::replicate_validator{},
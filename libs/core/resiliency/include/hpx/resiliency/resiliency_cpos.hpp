@@ -73,6 +73,27 @@ namespace hpx { namespace resiliency { namespace experimental {
     {
     } dataflow_replay{};
 
+    /// Customization point for asynchronously launching the given function \a f
+    /// repeatedly, passing a replay_checkpoint as its first argument. Verify
+    /// the result of those invocations using the given predicate \a pred.
+    /// Repeat launching on error exactly \a n times (except if
+    /// abort_replay_exception is thrown), resuming from the last checkpoint
+    /// saved by the previous attempt.
+    inline constexpr struct async_replay_checkpoint_validate_t final
+      : hpx::functional::tag<async_replay_checkpoint_validate_t>
+    {
+    } async_replay_checkpoint_validate{};
+
+    /// Customization point for asynchronously launching given function \a f
+    /// repeatedly, passing a replay_checkpoint as its first argument. Repeat
+    /// launching on error exactly \a n times (except if abort_replay_exception
+    /// is thrown), resuming from the last checkpoint saved by the previous
+    /// attempt.
+    inline constexpr struct async_replay_checkpoint_t final
+      : hpx::functional::tag<async_replay_checkpoint_t>
+    {
+    } async_replay_checkpoint{};
+
     ///////////////////////////////////////////////////////////////////////////
     // Replicate customization points
 
@@ -0,0 +1,72 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/resiliency/async_replay_checkpoint.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace resiliency { namespace experimental {
+
+    namespace {
+
+        std::atomic<std::int64_t> checkpoint_count(0);
+        std::atomic<std::int64_t> checkpoint_bytes(0);
+        std::atomic<std::int64_t> resumed_count(0);
+        std::atomic<std::int64_t> restarted_count(0);
+        std::atomic<std::int64_t> work_saved(0);
+    }    // namespace
+
+    namespace detail {
+
+        void record_replay_checkpoint(std::size_t bytes)
+        {
+            checkpoint_count.fetch_add(1, std::memory_order_relaxed);
+            checkpoint_bytes.fetch_add(static_cast<std::int64_t>(bytes),
+                std::memory_order_relaxed);
+        }
+
+        void record_replay_resumed(std::uint64_t progress)
+        {
+            resumed_count.fetch_add(1, std::memory_order_relaxed);
+            work_saved.fetch_add(static_cast<std::int64_t>(progress),
+                std::memory_order_relaxed);
+        }
+
+        void record_replay_restarted()
+        {
+            restarted_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }    // namespace detail
+
+    std::int64_t get_replay_checkpoint_count(bool reset)
+    {
+        return hpx::util::get_and_reset_value(checkpoint_count, reset);
+    }
+
+    std::int64_t get_replay_checkpoint_bytes(bool reset)
+    {
+        return hpx::util::get_and_reset_value(checkpoint_bytes, reset);
+    }
+
+    std::int64_t get_replay_resumed_count(bool reset)
+    {
+        return hpx::util::get_and_reset_value(resumed_count, reset);
+    }
+
+    std::int64_t get_replay_restarted_count(bool reset)
+    {
+        return hpx::util::get_and_reset_value(restarted_count, reset);
+    }
+
+    std::int64_t get_replay_work_saved(bool reset)
+    {
+        return hpx::util::get_and_reset_value(work_saved, reset);
+    }
+}}}    // namespace hpx::resiliency::experimental
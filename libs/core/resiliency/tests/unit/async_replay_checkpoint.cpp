@@ -0,0 +1,140 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/local/init.hpp>
+#include <hpx/modules/futures.hpp>
+#include <hpx/modules/resiliency.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+namespace resiliency = hpx::resiliency::experimental;
+
+struct vogon_exception : std::exception
+{
+};
+
+std::atomic<int> iterations_executed(0);
+std::atomic<int> attempts(0);
+
+// sum up the numbers 1..n, fail once in iteration fail_at
+std::int64_t long_running_sum(
+    resiliency::replay_checkpoint& cp, std::int64_t n, std::int64_t fail_at)
+{
+    bool const first_attempt = attempts++ == 0;
+
+    std::int64_t i = 0;
+    std::int64_t sum = 0;
+    cp.restore(i, sum);
+
+    for (/**/; i != n; ++i)
+    {
+        if (first_attempt && i == fail_at)
+        {
+            throw vogon_exception();
+        }
+
+        ++iterations_executed;
+        sum += i + 1;
+
+        cp.save(i + 1, i + 1, sum);
+    }
+    return sum;
+}
+
+std::int64_t always_fails(resiliency::replay_checkpoint& cp)
+{
+    std::int64_t i = 0;
+    cp.restore(i);
+    cp.save(i + 1, i + 1);
+    throw vogon_exception();
+}
+
+bool validate(std::int64_t result)
+{
+    return result == 55;
+}
+
+int hpx_main()
+{
+    // reset statistics
+    resiliency::get_replay_checkpoint_count(true);
+    resiliency::get_replay_checkpoint_bytes(true);
+    resiliency::get_replay_resumed_count(true);
+    resiliency::get_replay_restarted_count(true);
+    resiliency::get_replay_work_saved(true);
+
+    {
+        // a failed attempt resumes from the last checkpoint
+        hpx::future<std::int64_t> f = resiliency::async_replay_checkpoint(
+            3, &long_running_sum, std::int64_t(10), std::int64_t(7));
+        HPX_TEST_EQ(f.get(), 55);
+
+        // no iteration was executed twice
+        HPX_TEST_EQ(iterations_executed.load(), 10);
+        HPX_TEST_EQ(attempts.load(), 2);
+
+        HPX_TEST_EQ(resiliency::get_replay_checkpoint_count(false), 10);
+        HPX_TEST_NEQ(resiliency::get_replay_checkpoint_bytes(false), 0);
+        HPX_TEST_EQ(resiliency::get_replay_resumed_count(false), 1);
+        HPX_TEST_EQ(resiliency::get_replay_restarted_count(false), 0);
+        HPX_TEST_EQ(resiliency::get_replay_work_saved(false), 7);
+    }
+
+    {
+        // failure before the first checkpoint restarts from scratch
+        iterations_executed = 0;
+        attempts = 0;
+        resiliency::get_replay_restarted_count(true);
+
+        hpx::future<std::int64_t> f =
+            resiliency::async_replay_checkpoint_validate(3, &validate,
+                &long_running_sum, std::int64_t(10), std::int64_t(0));
+        HPX_TEST_EQ(f.get(), 55);
+
+        HPX_TEST_EQ(iterations_executed.load(), 10);
+        HPX_TEST_EQ(resiliency::get_replay_restarted_count(false), 1);
+    }
+
+    {
+        // checkpoints are carried across all attempts, the exception is
+        // rethrown once the number of replays has been exhausted
+        resiliency::get_replay_checkpoint_count(true);
+
+        hpx::future<std::int64_t> f =
+            resiliency::async_replay_checkpoint(4, &always_fails);
+
+        bool exception_caught = false;
+        try
+        {
+            f.get();
+            HPX_TEST(false);
+        }
+        catch (vogon_exception const&)
+        {
+            exception_caught = true;
+        }
+        catch (...)
+        {
+            HPX_TEST(false);
+        }
+        HPX_TEST(exception_caught);
+        HPX_TEST_EQ(resiliency::get_replay_checkpoint_count(false), 5);
+    }
+
+    return hpx::local::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::local::init(hpx_main, argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -9,11 +9,13 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/local/init.hpp>
+#include <hpx/local/thread.hpp>
 #include <hpx/modules/futures.hpp>
 #include <hpx/modules/resiliency.hpp>
 #include <hpx/modules/testing.hpp>
 
 #include <atomic>
+#include <chrono>
 #include <stdexcept>
 
 std::atomic<int> answer(35);
@@ -47,6 +49,32 @@ int deep_thought()
         throw vogon_exception();
 }
 
+std::atomic<int> replicas_started(0);
+std::atomic<int> replicas_stopped(0);
+
+// the first replica produces the result right away, all others wait for
+// being asked to stop
+int cancellable_answer(hpx::stop_token const& token)
+{
+    if (replicas_started++ == 0)
+    {
+        return 42;
+    }
+
+    auto const until =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!token.stop_requested() && std::chrono::steady_clock::now() < until)
+    {
+        hpx::this_thread::yield();
+    }
+
+    if (token.stop_requested())
+    {
+        ++replicas_stopped;
+    }
+    return 0;
+}
+
 int hpx_main()
 {
     {
@@ -135,6 +163,25 @@ int hpx_main()
         HPX_TEST(exception_caught);
     }
 
+    {
+        // replicas accepting a stop_token are asked to stop once the first
+        // valid result is available
+        hpx::future<int> f = hpx::resiliency::experimental::async_replicate(
+            4, &cancellable_answer);
+        HPX_TEST_EQ(f.get(), 42);
+
+        // wait for the running replicas to observe the stop request, the
+        // ones which had not started yet are skipped
+        auto const until =
+            std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (replicas_stopped.load() != replicas_started.load() - 1 &&
+            std::chrono::steady_clock::now() < until)
+        {
+            hpx::this_thread::yield();
+        }
+        HPX_TEST_EQ(replicas_stopped.load(), replicas_started.load() - 1);
+    }
+
     return hpx::local::finalize();
 }
 
@@ -70,6 +70,10 @@ namespace hpx { namespace resource { namespace detail {
         std::size_t num_threads_;
         hpx::threads::policies::scheduler_mode mode_;
         scheduler_function create_function_;
+
+        // parameters of the elasticity controller, if enabled
+        bool elastic_;
+        elasticity_parameters elasticity_;
     };
 
     ///////////////////////////////////////////////////////////////////////
@@ -148,6 +152,11 @@ namespace hpx { namespace resource { namespace detail {
         hpx::threads::policies::scheduler_mode get_scheduler_mode(
             std::size_t pool_index) const;
 
+        void set_elasticity(
+            std::string const& pool_name, elasticity_parameters const& params);
+        bool has_elasticity(std::size_t pool_index) const;
+        elasticity_parameters get_elasticity(std::size_t pool_index) const;
+
         std::string const& get_pool_name(std::size_t index) const;
         std::size_t get_pool_index(std::string const& pool_name) const;
 
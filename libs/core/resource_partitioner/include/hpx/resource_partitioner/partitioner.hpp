@@ -161,6 +161,12 @@ namespace hpx { namespace resource {
 
         HPX_CORE_EXPORT const std::string& get_default_pool_name() const;
 
+        // Let a controller suspend and resume the processing units of the
+        // given pool depending on its load. This enables
+        // scheduler_mode::enable_elasticity for the pool.
+        HPX_CORE_EXPORT void set_elasticity(std::string const& pool_name,
+            elasticity_parameters const& params = elasticity_parameters());
+
         ///////////////////////////////////////////////////////////////////////
         // Functions to add processing units to thread pools via
         // the pu/core/numa_domain API
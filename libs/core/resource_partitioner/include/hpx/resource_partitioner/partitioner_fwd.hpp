@@ -12,6 +12,7 @@
 #include <hpx/threading_base/thread_pool_base.hpp>
 #include <hpx/threading_base/thread_queue_init_parameters.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <memory>
 #include <string>
@@ -72,4 +73,36 @@ namespace hpx { namespace resource {
         abp_priority_lifo = 6,
         shared_priority = 7,
     };
+
+    /// This structure holds the parameters of the controller that suspends
+    /// and resumes the processing units of a thread pool depending on its
+    /// load (see partitioner::set_elasticity). The controller samples which
+    /// worker threads are idle and how many threads are pending in the queues
+    /// of the pool. After each \a samples_per_decision samples it decides
+    /// whether to suspend or resume a single processing unit.
+    struct elasticity_parameters
+    {
+        /// The time between two samples of the state of the worker threads.
+        std::chrono::milliseconds sample_interval{10};
+
+        /// The number of samples each decision is based on.
+        std::size_t samples_per_decision = 10;
+
+        /// A processing unit is suspended if the running worker threads were
+        /// idle in at least this fraction of all samples during
+        /// \a suspend_after consecutive decisions.
+        double suspend_idle_fraction = 0.9;
+        std::size_t suspend_after = 3;
+
+        /// A previously suspended processing unit is resumed if the running
+        /// worker threads were idle in at most this fraction of all samples,
+        /// or if more than \a resume_queue_length threads per running worker
+        /// thread were pending, during \a resume_after consecutive decisions.
+        double resume_idle_fraction = 0.5;
+        std::size_t resume_queue_length = 4;
+        std::size_t resume_after = 1;
+
+        /// The number of processing units that are never suspended.
+        std::size_t min_processing_units = 1;
+    };
 }}    // namespace hpx::resource
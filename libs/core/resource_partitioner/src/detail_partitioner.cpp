@@ -53,6 +53,7 @@ namespace hpx { namespace resource { namespace detail {
       , scheduling_policy_(sched)
       , num_threads_(0)
       , mode_(mode)
+      , elastic_(false)
     {
         if (name.empty())
         {
@@ -70,6 +71,7 @@ namespace hpx { namespace resource { namespace detail {
       , num_threads_(0)
       , mode_(mode)
       , create_function_(HPX_MOVE(create_func))
+      , elastic_(false)
     {
         if (name.empty())
         {
@@ -830,6 +832,38 @@ namespace hpx { namespace resource { namespace detail {
         return get_pool_data(l, pool_index).mode_;
     }
 
+    void partitioner::set_elasticity(
+        std::string const& pool_name, elasticity_parameters const& params)
+    {
+        if (params.samples_per_decision == 0 ||
+            params.suspend_idle_fraction < params.resume_idle_fraction)
+        {
+            throw_invalid_argument("partitioner::set_elasticity",
+                "invalid elasticity parameters for pool '" + pool_name + "'");
+        }
+
+        std::unique_lock<mutex_type> l(mtx_);
+        detail::init_pool_data& data = get_pool_data(l, pool_name);
+
+        data.mode_ = data.mode_ |
+            threads::policies::scheduler_mode::enable_elasticity;
+        data.elastic_ = true;
+        data.elasticity_ = params;
+    }
+
+    bool partitioner::has_elasticity(std::size_t pool_index) const
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+        return get_pool_data(l, pool_index).elastic_;
+    }
+
+    elasticity_parameters partitioner::get_elasticity(
+        std::size_t pool_index) const
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+        return get_pool_data(l, pool_index).elasticity_;
+    }
+
     detail::init_pool_data const& partitioner::get_pool_data(
         std::unique_lock<mutex_type>& l, std::size_t pool_index) const
     {
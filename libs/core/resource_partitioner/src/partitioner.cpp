@@ -161,6 +161,12 @@ namespace hpx { namespace resource {
         return partitioner_.get_default_pool_name();
     }
 
+    void partitioner::set_elasticity(
+        std::string const& pool_name, elasticity_parameters const& params)
+    {
+        partitioner_.set_elasticity(pool_name, params);
+    }
+
     void partitioner::add_resource(pu const& p, std::string const& pool_name,
         bool exclusive, std::size_t num_threads /*= 1*/)
     {
@@ -0,0 +1,159 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that the elasticity controller suspends processing units of an idle
+// pool and resumes them once the pool is loaded again.
+
+#include <hpx/local/execution.hpp>
+#include <hpx/local/future.hpp>
+#include <hpx/local/init.hpp>
+#include <hpx/local/thread.hpp>
+#include <hpx/modules/resource_partitioner.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/modules/threadmanager.hpp>
+#include <hpx/runtime_local/runtime_local_fwd.hpp>
+#include <hpx/runtime_local/thread_pool_helpers.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+std::size_t const max_threads = (std::min)(
+    std::size_t(4), std::size_t(hpx::threads::hardware_concurrency()));
+
+constexpr std::chrono::milliseconds sample_interval(1);
+constexpr std::size_t samples_per_decision = 5;
+constexpr std::size_t suspend_after = 2;
+
+// wait for the predicate to hold, giving up after the controller has made the
+// given number of decisions
+template <typename F>
+bool wait_for_decisions(hpx::threads::elastic_pool_controller& controller,
+    F&& f, std::int64_t max_decisions)
+{
+    std::int64_t const last =
+        controller.get_decision_count(false) + max_decisions;
+    while (true)
+    {
+        std::int64_t const decisions = controller.get_decision_count(false);
+        if (f())
+        {
+            return true;
+        }
+        if (decisions >= last)
+        {
+            return false;
+        }
+        hpx::this_thread::sleep_for(sample_interval);
+    }
+}
+
+int hpx_main()
+{
+    std::size_t const pool_index = hpx::resource::get_pool_index("worker");
+    hpx::threads::elastic_pool_controller* controller =
+        hpx::threads::get_thread_manager().get_elastic_controller(pool_index);
+
+    HPX_TEST(controller != nullptr);
+    HPX_TEST(hpx::threads::get_thread_manager().get_elastic_controller(
+                 hpx::resource::get_pool_index("default")) == nullptr);
+    if (controller == nullptr)
+    {
+        return hpx::local::finalize();
+    }
+
+    // the idle pool is shrunk down to its minimal size
+    std::int64_t const num_threads =
+        std::int64_t(hpx::resource::get_num_threads("worker"));
+    HPX_TEST(wait_for_decisions(
+        *controller,
+        [&]() {
+            return controller->get_suspended_processing_units(false) ==
+                num_threads - 1;
+        },
+        10 * num_threads * std::int64_t(suspend_after)));
+    HPX_TEST_EQ(controller->get_suspension_count(false), num_threads - 1);
+    if (num_threads == 1)
+    {
+        return hpx::local::finalize();
+    }
+
+    // keep the pool busy until at least one processing unit is resumed
+    hpx::execution::parallel_executor exec(
+        &hpx::resource::get_thread_pool("worker"));
+
+    std::vector<hpx::future<void>> fs;
+    wait_for_decisions(
+        *controller,
+        [&]() {
+            if (controller->get_resumption_count(false) != 0)
+            {
+                return true;
+            }
+            for (std::size_t i = 0; i != 4 * max_threads; ++i)
+            {
+                fs.push_back(hpx::async(exec, []() {
+                    hpx::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }));
+            }
+            return false;
+        },
+        100);
+    hpx::wait_all(fs);
+
+    HPX_TEST_NEQ(controller->get_resumption_count(false), std::int64_t(0));
+
+    return hpx::local::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // one core is left to the default pool, the worker pool needs at least
+    // one other core
+    if (max_threads < 2)
+    {
+        return hpx::util::report_errors();
+    }
+
+    hpx::local::init_params init_args;
+    init_args.cfg = {"hpx.os_threads=" + std::to_string(max_threads)};
+    init_args.rp_callback = [](hpx::resource::partitioner& rp,
+                                hpx::program_options::variables_map const&) {
+        rp.create_thread_pool("worker",
+            hpx::resource::scheduling_policy::local_priority_fifo);
+
+        bool first = true;
+        for (hpx::resource::numa_domain const& d : rp.numa_domains())
+        {
+            for (hpx::resource::core const& c : d.cores())
+            {
+                for (hpx::resource::pu const& p : c.pus())
+                {
+                    // leave the first processing unit to the default pool
+                    if (!first)
+                    {
+                        rp.add_resource(p, "worker");
+                    }
+                    first = false;
+                }
+            }
+        }
+
+        hpx::resource::elasticity_parameters params;
+        params.sample_interval = sample_interval;
+        params.samples_per_decision = samples_per_decision;
+        params.suspend_after = suspend_after;
+        params.min_processing_units = 1;
+        rp.set_elasticity("worker", params);
+    };
+
+    HPX_TEST_EQ(hpx::local::init(hpx_main, argc, argv, init_args), 0);
+
+    return hpx::util::report_errors();
+}
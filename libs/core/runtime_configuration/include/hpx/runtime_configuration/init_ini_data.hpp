@@ -1,4 +1,4 @@
-//  Copyright (c) 2005-2014 Hartmut Kaiser
+//  Copyright (c) 2005-2022 Hartmut Kaiser
 //  Copyright (c)      2011 Bryce Lelbach
 //
 //  SPDX-License-Identifier: BSL-1.0
@@ -7,12 +7,15 @@
 
 #pragma once
 
+#include <hpx/config.hpp>
 #include <hpx/ini/ini.hpp>
 #include <hpx/modules/filesystem.hpp>
 #include <hpx/modules/plugin.hpp>
 #include <hpx/runtime_configuration/component_registry_base.hpp>
 #include <hpx/runtime_configuration/plugin_registry_base.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -43,6 +46,50 @@ namespace hpx { namespace util {
     // global function to read component ini information
     void merge_component_inis(section& ini);
 
+    ///////////////////////////////////////////////////////////////////////////
+    // On-disk cache of shared libraries found in the component directories
+    // which have been loaded once and turned out not to expose any HPX
+    // component or plugin factories. Each entry is keyed by the canonical
+    // path, the modification time, and the size of the library, cached
+    // libraries are skipped without being loaded. The cache is enabled by
+    // setting hpx.module_cache to the name of the cache file.
+    class HPX_CORE_EXPORT module_cache
+    {
+    public:
+        explicit module_cache(std::string filename);
+
+        bool enabled() const noexcept
+        {
+            return !filename_.empty();
+        }
+
+        // read the cache file, discards the cache if it was written by a
+        // different version of HPX
+        void load();
+
+        // write the cache file if it has been modified
+        void save();
+
+        // return whether the given library is known not to be an HPX module
+        bool is_known_non_module(filesystem::path const& p) const;
+
+        // remember that the given library is not an HPX module
+        void add_non_module(filesystem::path const& p);
+
+    private:
+        struct entry
+        {
+            std::int64_t last_write_time;
+            std::uintmax_t size;
+        };
+
+        static bool get_entry(filesystem::path const& p, entry& e);
+
+        std::string filename_;
+        std::map<std::string, entry> non_modules_;
+        bool modified_;
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     // iterate over all shared libraries in the given directory and construct
     // default ini settings assuming all of those are components
@@ -51,5 +98,6 @@ namespace hpx { namespace util {
         std::map<std::string, filesystem::path>& basenames,
         std::map<std::string, hpx::util::plugin::dll>& modules,
         std::vector<std::shared_ptr<components::component_registry_base>>&
-            component_registries);
+            component_registries,
+        module_cache* cache = nullptr);
 }}    // namespace hpx::util
@@ -14,6 +14,7 @@
 #include <hpx/modules/plugin.hpp>
 #include <hpx/runtime_configuration/agas_service_mode.hpp>
 #include <hpx/runtime_configuration/component_registry_base.hpp>
+#include <hpx/runtime_configuration/init_ini_data.hpp>
 #include <hpx/runtime_configuration/plugin_registry_base.hpp>
 #include <hpx/runtime_configuration/runtime_configuration_fwd.hpp>
 #include <hpx/runtime_configuration/runtime_mode.hpp>
@@ -90,6 +91,10 @@ namespace hpx { namespace util {
 
         std::size_t get_agas_max_pending_refcnt_requests() const;
 
+        // maximum time (in milliseconds) reference count decrements are
+        // buffered before being sent to AGAS
+        std::size_t get_agas_max_pending_refcnt_delay() const;
+
         // Load application specific configuration and merge it with the
         // default configuration loaded from hpx.ini
         bool load_application_configuration(
@@ -172,7 +177,8 @@ namespace hpx { namespace util {
             std::string const& component_base_paths,
             std::string const& component_path_suffixes,
             std::set<std::string>& component_paths,
-            std::map<std::string, filesystem::path>& basenames);
+            std::map<std::string, filesystem::path>& basenames,
+            module_cache& cache);
 
         void load_component_path(
             std::vector<std::shared_ptr<plugins::plugin_registry_base>>&
@@ -180,7 +186,8 @@ namespace hpx { namespace util {
             std::vector<std::shared_ptr<components::component_registry_base>>&
                 component_registries,
             std::string const& path, std::set<std::string>& component_paths,
-            std::map<std::string, filesystem::path>& basenames);
+            std::map<std::string, filesystem::path>& basenames,
+            module_cache& cache);
 
     public:
         runtime_mode mode_;
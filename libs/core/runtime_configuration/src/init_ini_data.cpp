@@ -1,4 +1,4 @@
-//  Copyright (c) 2005-2017 Hartmut Kaiser
+//  Copyright (c) 2005-2022 Hartmut Kaiser
 //  Copyright (c)      2011 Bryce Lelbach
 //
 //  SPDX-License-Identifier: BSL-1.0
@@ -21,6 +21,11 @@
 #include <boost/tokenizer.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -30,6 +35,16 @@
 #include <utility>
 #include <vector>
 
+#if defined(HPX_WINDOWS)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+#include <fcntl.h>
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace util {
     ///////////////////////////////////////////////////////////////////////////
@@ -382,7 +397,152 @@ namespace hpx { namespace util {
         return plugin_registries;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    module_cache::module_cache(std::string filename)
+      : filename_(HPX_MOVE(filename))
+      , modified_(false)
+    {
+    }
+
+    void module_cache::load()
+    {
+        if (filename_.empty())
+            return;
+
+        std::ifstream in(filename_);
+        if (!in.is_open())
+            return;
+
+        // the first line holds the version of HPX that wrote the cache
+        std::string line;
+        if (!std::getline(in, line) || line != hpx::full_version_as_string())
+        {
+            LRT_(info).format("module cache ({}): ignoring outdated cache file",
+                filename_);
+            modified_ = true;    // rewrite cache
+            return;
+        }
+
+        // every other line has the format: <mtime> <size> <path>
+        entry e{};
+        while (in >> e.last_write_time >> e.size)
+        {
+            in.get();    // skip single space separating the path
+            if (!std::getline(in, line) || line.empty())
+                break;
+            non_modules_[line] = e;
+        }
+
+        LRT_(info).format("module cache ({}): loaded {} entries", filename_,
+            non_modules_.size());
+    }
+
+    void module_cache::save()
+    {
+        if (filename_.empty() || !modified_)
+            return;
+
+        // write to a temporary file first and move it into place afterwards
+        // to avoid clashes with other processes (or threads) reading or
+        // writing the cache
+        static std::atomic<std::size_t> sequence(0);
+        std::string const tmpname = filename_ + "." +
+            std::to_string(getpid()) + "." + std::to_string(++sequence);
+        {
+            std::ofstream out(tmpname, std::ios::trunc);
+            if (!out.is_open())
+            {
+                LRT_(warning).format(
+                    "module cache ({}): could not write cache file", filename_);
+                return;
+            }
+
+            out << hpx::full_version_as_string() << "\n";
+            for (auto const& e : non_modules_)
+            {
+                out << e.second.last_write_time << " " << e.second.size << " "
+                    << e.first << "\n";
+            }
+        }
+
+        // replace an existing cache file (std::rename fails on Windows if
+        // the target exists)
+        std::error_code ec;
+        filesystem::rename(tmpname, filename_, ec);
+        if (ec)
+        {
+            LRT_(warning).format(
+                "module cache ({}): could not replace cache file: {}",
+                filename_, ec.message());
+            std::remove(tmpname.c_str());
+            return;
+        }
+        modified_ = false;
+    }
+
+    bool module_cache::get_entry(filesystem::path const& p, entry& e)
+    {
+        namespace fs = filesystem;
+        try
+        {
+#if !defined(HPX_FILESYSTEM_HAVE_BOOST_FILESYSTEM_COMPATIBILITY)
+            e.last_write_time = static_cast<std::int64_t>(
+                fs::last_write_time(p).time_since_epoch().count());
+#else
+            e.last_write_time =
+                static_cast<std::int64_t>(fs::last_write_time(p));
+#endif
+            e.size = static_cast<std::uintmax_t>(fs::file_size(p));
+        }
+        catch (fs::filesystem_error const& /*e*/)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    bool module_cache::is_known_non_module(filesystem::path const& p) const
+    {
+        auto it = non_modules_.find(p.string());
+        if (it == non_modules_.end())
+            return false;
+
+        entry e{};
+        return get_entry(p, e) &&
+            e.last_write_time == it->second.last_write_time &&
+            e.size == it->second.size;
+    }
+
+    void module_cache::add_non_module(filesystem::path const& p)
+    {
+        entry e{};
+        if (get_entry(p, e))
+        {
+            non_modules_[p.string()] = e;
+            modified_ = true;
+        }
+    }
+
     namespace detail {
+        ///////////////////////////////////////////////////////////////////////
+        // Ask the operating system to start reading the given library into
+        // the page cache. Issuing this for all libraries upfront overlaps the
+        // file system accesses which otherwise would happen one by one while
+        // loading the libraries.
+        inline void prefetch_module(filesystem::path const& p)
+        {
+#if defined(__linux) || defined(linux) || defined(__linux__)
+            int fd = ::open(p.string().c_str(), O_RDONLY);
+            if (fd != -1)
+            {
+                ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+                ::close(fd);
+            }
+#else
+            HPX_UNUSED(p);
+#endif
+        }
+
         inline bool cmppath_less(
             std::pair<filesystem::path, std::string> const& lhs,
             std::pair<filesystem::path, std::string> const& rhs)
@@ -404,7 +564,8 @@ namespace hpx { namespace util {
         std::map<std::string, filesystem::path>& basenames,
         std::map<std::string, hpx::util::plugin::dll>& modules,
         std::vector<std::shared_ptr<components::component_registry_base>>&
-            component_registries)
+            component_registries,
+        module_cache* cache)
     {
         namespace fs = filesystem;
 
@@ -472,6 +633,14 @@ namespace hpx { namespace util {
 
                 if (p.second)
                 {
+                    if (cache != nullptr &&
+                        cache->is_known_non_module(canonical_curr))
+                    {
+                        LRT_(debug).format(
+                            "skipping module {} ({}): cached as non-HPX module",
+                            basename, canonical_curr.string());
+                        continue;
+                    }
                     libdata.push_back(std::make_pair(canonical_curr, name));
                 }
                 else
@@ -498,6 +667,11 @@ namespace hpx { namespace util {
         std::shuffle(libdata.begin(), libdata.end(), HPX_MOVE(generator));
 
         typedef std::pair<fs::path, std::string> libdata_type;
+        for (libdata_type const& p : libdata)
+        {
+            detail::prefetch_module(p.first);
+        }
+
         for (libdata_type const& p : libdata)
         {
             LRT_(info).format("attempting to load: {}", p.first.string());
@@ -558,6 +732,12 @@ namespace hpx { namespace util {
             {
                 modules.insert(std::make_pair(p.second, HPX_MOVE(d)));
             }
+            else if (cache != nullptr)
+            {
+                // the library was loaded successfully, but it does not
+                // expose any factories, no need to load it next time
+                cache->add_non_module(p.first);
+            }
         }
         return plugin_registries;
     }
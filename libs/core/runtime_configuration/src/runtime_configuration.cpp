@@ -106,6 +106,7 @@ namespace hpx { namespace util {
             "[hpx]",
             "location = ${HPX_LOCATION:$[system.prefix]}",
             "component_paths = ${HPX_COMPONENT_PATHS}",
+            "module_cache = ${HPX_MODULE_CACHE}",
             "component_base_paths = $[hpx.location]"    // NOLINT
                 HPX_INI_PATH_DELIMITER "$[system.executable_prefix]",
             "component_path_suffixes = " +
@@ -302,7 +303,11 @@ namespace hpx { namespace util {
             "${HPX_AGAS_MAX_PENDING_REFCNT_REQUESTS:" HPX_PP_STRINGIZE(
                 HPX_PP_EXPAND(
                     HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS)) "}",
+            "max_pending_refcnt_delay = "
+            "${HPX_AGAS_MAX_PENDING_REFCNT_DELAY:" HPX_PP_STRINGIZE(
+                HPX_PP_EXPAND(HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_DELAY)) "}",
             "service_mode = hosted",
+            "bootstrap_fanout = ${HPX_AGAS_BOOTSTRAP_FANOUT:16}",
             "local_cache_size = ${HPX_AGAS_LOCAL_CACHE_SIZE:" HPX_PP_STRINGIZE(
                 HPX_PP_EXPAND(HPX_AGAS_LOCAL_CACHE_SIZE)) "}",
             "use_range_caching = ${HPX_AGAS_USE_RANGE_CACHING:1}",
@@ -484,7 +489,13 @@ namespace hpx { namespace util {
             "destination = ${HPX_CONSOLE_DEB_LOGDESTINATION:"
                 "file(hpx.debuglog.$[system.pid].log)}",
 #endif
-            "format = ${HPX_CONSOLE_DEB_LOGFORMAT:|}"
+            "format = ${HPX_CONSOLE_DEB_LOGFORMAT:|}",
+
+            // asynchronous logging backend
+            "[hpx.logging.async]",
+            "enable = ${HPX_LOG_ASYNC:0}",
+            "buffer_size = ${HPX_LOG_ASYNC_BUFFER_SIZE:65536}",
+            "binary_file = ${HPX_LOG_ASYNC_BINARY_FILE:}"
 
 #undef HPX_TIMEFORMAT
 #undef HPX_LOGFORMAT
@@ -543,7 +554,8 @@ namespace hpx { namespace util {
         std::vector<std::shared_ptr<components::component_registry_base>>&
             component_registries,
         std::string const& path, std::set<std::string>& component_paths,
-        std::map<std::string, filesystem::path>& basenames)
+        std::map<std::string, filesystem::path>& basenames,
+        module_cache& cache)
     {
         namespace fs = filesystem;
 
@@ -568,9 +580,10 @@ namespace hpx { namespace util {
                 fs::path this_path(*p.first);
                 if (fs::exists(this_path, fsec) && !fsec)
                 {
-                    plugin_list_type tmp_regs =
-                        util::init_ini_data_default(this_path.string(), *this,
-                            basenames, modules_, component_registries);
+                    plugin_list_type tmp_regs = util::init_ini_data_default(
+                        this_path.string(), *this, basenames, modules_,
+                        component_registries,
+                        cache.enabled() ? &cache : nullptr);
 
                     std::copy(tmp_regs.begin(), tmp_regs.end(),
                         std::back_inserter(plugin_registries));
@@ -587,7 +600,8 @@ namespace hpx { namespace util {
         std::string const& component_base_paths,
         std::string const& component_path_suffixes,
         std::set<std::string>& component_paths,
-        std::map<std::string, filesystem::path>& basenames)
+        std::map<std::string, filesystem::path>& basenames,
+        module_cache& cache)
     {
         namespace fs = filesystem;
 
@@ -615,13 +629,13 @@ namespace hpx { namespace util {
                     std::string p = path;
                     p += *jt;
                     load_component_path(plugin_registries, component_registries,
-                        p, component_paths, basenames);
+                        p, component_paths, basenames, cache);
                 }
             }
             else
             {
                 load_component_path(plugin_registries, component_registries,
-                    path, component_paths, basenames);
+                    path, component_paths, basenames, cache);
             }
         }
     }
@@ -644,6 +658,10 @@ namespace hpx { namespace util {
         // plugin registry object
         plugin_list_type plugin_registries;
 
+        // cache of libraries known not to be HPX modules
+        module_cache cache(get_entry("hpx.module_cache", ""));
+        cache.load();
+
         // load plugin paths from component_base_paths and suffixes
         std::string component_base_paths(
             get_entry("hpx.component_base_paths", HPX_DEFAULT_COMPONENT_PATH));
@@ -652,12 +670,14 @@ namespace hpx { namespace util {
 
         load_component_paths(plugin_registries, component_registries,
             component_base_paths, component_path_suffixes, component_paths,
-            basenames);
+            basenames, cache);
 
         // load additional explicit plugin paths from plugin_paths key
         std::string plugin_paths(get_entry("hpx.component_paths", ""));
         load_component_paths(plugin_registries, component_registries,
-            plugin_paths, "", component_paths, basenames);
+            plugin_paths, "", component_paths, basenames, cache);
+
+        cache.save();
 
         // read system and user ini files _again_, to allow the user to
         // overwrite the settings from the default component ini's.
@@ -917,6 +937,18 @@ namespace hpx { namespace util {
         return HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS;
     }
 
+    std::size_t runtime_configuration::get_agas_max_pending_refcnt_delay()
+        const
+    {
+        if (util::section const* sec = get_section("hpx.agas"); nullptr != sec)
+        {
+            return hpx::util::get_entry_as<std::size_t>(*sec,
+                "max_pending_refcnt_delay",
+                HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_DELAY);
+        }
+        return HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_DELAY;
+    }
+
     bool runtime_configuration::get_itt_notify_mode() const
     {
 #if HPX_HAVE_ITTNOTIFY != 0
@@ -0,0 +1,242 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that the cache of libraries which are not HPX modules survives a
+// save/load round trip, that entries are invalidated if the library changes,
+// that caches written by a different version of HPX are ignored, and that a
+// cache file being rewritten concurrently is never seen half written.
+
+#include <hpx/config.hpp>
+#include <hpx/modules/filesystem.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/runtime_configuration/init_ini_data.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = hpx::filesystem;
+
+///////////////////////////////////////////////////////////////////////////////
+void write_file(fs::path const& p, std::string const& data)
+{
+    std::ofstream out(p.string(), std::ios_base::out | std::ios_base::trunc);
+    out << data;
+}
+
+void append_file(fs::path const& p, std::string const& data)
+{
+    std::ofstream out(p.string(), std::ios_base::out | std::ios_base::app);
+    out << data;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_disabled(fs::path const& dir)
+{
+    hpx::util::module_cache cache("");
+    HPX_TEST(!cache.enabled());
+
+    cache.add_non_module(dir / "liba.so");
+    cache.save();
+    HPX_TEST(!cache.is_known_non_module(dir / "libb.so"));
+}
+
+void test_round_trip(fs::path const& dir, std::string const& filename)
+{
+    {
+        hpx::util::module_cache cache(filename);
+        HPX_TEST(cache.enabled());
+
+        cache.load();    // the cache file does not exist yet
+        HPX_TEST(!cache.is_known_non_module(dir / "liba.so"));
+
+        cache.add_non_module(dir / "liba.so");
+        cache.add_non_module(dir / "libb.so");
+        cache.add_non_module(dir / "libmissing.so");    // ignored
+        cache.save();
+    }
+
+    hpx::util::module_cache cache(filename);
+    cache.load();
+    HPX_TEST(cache.is_known_non_module(dir / "liba.so"));
+    HPX_TEST(cache.is_known_non_module(dir / "libb.so"));
+    HPX_TEST(!cache.is_known_non_module(dir / "libc.so"));
+    HPX_TEST(!cache.is_known_non_module(dir / "libmissing.so"));
+}
+
+void test_invalidation(fs::path const& dir, std::string const& filename)
+{
+    // changing the size of a library invalidates its entry
+    append_file(dir / "liba.so", "more data");
+
+    {
+        hpx::util::module_cache cache(filename);
+        cache.load();
+        HPX_TEST(!cache.is_known_non_module(dir / "liba.so"));
+        HPX_TEST(cache.is_known_non_module(dir / "libb.so"));
+    }
+
+#if !defined(HPX_FILESYSTEM_HAVE_BOOST_FILESYSTEM_COMPATIBILITY)
+    // changing the modification time of a library invalidates its entry
+    fs::last_write_time(dir / "libb.so",
+        fs::last_write_time(dir / "libb.so") - std::chrono::hours(1));
+
+    {
+        hpx::util::module_cache cache(filename);
+        cache.load();
+        HPX_TEST(!cache.is_known_non_module(dir / "libb.so"));
+    }
+#endif
+}
+
+void test_version_mismatch(fs::path const& dir, std::string const& filename)
+{
+    // write a cache file for another version of HPX, all entries are valid
+    {
+        hpx::util::module_cache cache(filename);
+        cache.add_non_module(dir / "liba.so");
+        cache.save();
+    }
+
+    std::string contents;
+    {
+        std::ifstream in(filename);
+        std::string line;
+        std::getline(in, line);    // skip version
+        contents = "0.0.0 (other version)\n";
+        while (std::getline(in, line))
+        {
+            contents += line + "\n";
+        }
+    }
+    write_file(filename, contents);
+
+    {
+        hpx::util::module_cache cache(filename);
+        cache.load();
+        HPX_TEST(!cache.is_known_non_module(dir / "liba.so"));
+
+        // the outdated cache is rewritten even if nothing was added
+        cache.save();
+    }
+
+    {
+        hpx::util::module_cache cache(filename);
+        cache.load();
+        HPX_TEST(!cache.is_known_non_module(dir / "liba.so"));
+
+        cache.add_non_module(dir / "liba.so");
+        cache.save();
+    }
+
+    hpx::util::module_cache cache(filename);
+    cache.load();
+    HPX_TEST(cache.is_known_non_module(dir / "liba.so"));
+}
+
+void test_concurrent_writers(fs::path const& dir, std::string const& filename)
+{
+    constexpr std::size_t num_writers = 2;
+    constexpr std::size_t num_iterations = 200;
+
+    std::vector<fs::path> libs;
+    for (std::size_t i = 0; i != 50; ++i)
+    {
+        libs.push_back(dir / ("libconcurrent" + std::to_string(i) + ".so"));
+        write_file(libs.back(), std::string(i + 1, 'x'));
+    }
+
+    auto writer = [&]() {
+        for (std::size_t i = 0; i != num_iterations; ++i)
+        {
+            hpx::util::module_cache cache(filename);
+            for (fs::path const& p : libs)
+            {
+                cache.add_non_module(p);
+            }
+            cache.save();
+        }
+    };
+
+    std::atomic<bool> done(false);
+    std::vector<std::thread> writers;
+    for (std::size_t i = 0; i != num_writers; ++i)
+    {
+        writers.emplace_back(writer);
+    }
+
+    // readers must see either no cache file or a complete one
+    std::thread reader([&]() {
+        while (!done.load())
+        {
+            hpx::util::module_cache cache(filename);
+            cache.load();
+
+            bool const first = cache.is_known_non_module(libs.front());
+            for (fs::path const& p : libs)
+            {
+                HPX_TEST_EQ(cache.is_known_non_module(p), first);
+            }
+        }
+    });
+
+    for (std::thread& t : writers)
+    {
+        t.join();
+    }
+    done = true;
+    reader.join();
+
+    hpx::util::module_cache cache(filename);
+    cache.load();
+    for (fs::path const& p : libs)
+    {
+        HPX_TEST(cache.is_known_non_module(p));
+    }
+
+    // no temporary files are left behind
+    std::size_t num_files = 0;
+    for (fs::directory_iterator it(dir); it != fs::directory_iterator(); ++it)
+    {
+        ++num_files;
+    }
+    HPX_TEST_EQ(num_files, libs.size() + 4);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    fs::path const dir = fs::temp_directory_path() /
+        ("hpx_module_cache_" +
+            std::to_string(
+                std::hash<std::thread::id>()(std::this_thread::get_id())));
+
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    write_file(dir / "liba.so", "a");
+    write_file(dir / "libb.so", "bb");
+    write_file(dir / "libc.so", "ccc");
+
+    std::string const filename = (dir / "modules.cache").string();
+
+    test_disabled(dir);
+    test_round_trip(dir, filename);
+    test_invalidation(dir, filename);
+    test_version_mismatch(dir, filename);
+
+    fs::remove(filename);
+    test_concurrent_writers(dir, filename);
+
+    fs::remove_all(dir);
+
+    return hpx::util::report_errors();
+}
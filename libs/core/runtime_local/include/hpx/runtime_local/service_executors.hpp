@@ -9,6 +9,7 @@
 #pragma once
 
 #include <hpx/config.hpp>
+#include <hpx/executors/io_context.hpp>
 #include <hpx/executors/service_executors.hpp>
 #include <hpx/modules/execution.hpp>
 #include <hpx/runtime_local/runtime_local_fwd.hpp>
@@ -196,3 +197,23 @@ namespace hpx { namespace parallel { namespace execution {
     };
     /// \endcond
 }}}    // namespace hpx::parallel::execution
+
+namespace hpx::execution::experimental {
+
+    /// An \a io_context executing the blocking I/O operations on the
+    /// runtime's io-pool.
+    struct io_pool_context : io_context
+    {
+        explicit io_pool_context(
+            hpx::threads::thread_pool_base* pool =
+                hpx::threads::detail::get_self_or_default_pool(),
+            hpx::threads::thread_priority priority =
+                hpx::threads::thread_priority::normal)
+          : io_context(parallel::execution::detail::get_service_pool(
+                           parallel::execution::service_executor_type::
+                               io_thread_pool),
+                pool, priority)
+        {
+        }
+    };
+}    // namespace hpx::execution::experimental
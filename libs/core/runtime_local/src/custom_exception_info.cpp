@@ -1,4 +1,4 @@
-//  Copyright (c) 2007-2016 Hartmut Kaiser
+//  Copyright (c) 2007-2022 Hartmut Kaiser
 //  Copyright (c)      2011 Bryce Lelbach
 //
 //  SPDX-License-Identifier: BSL-1.0
@@ -239,22 +239,31 @@ namespace hpx { namespace detail {
         std::cerr << diagnostic_information(e) << std::endl;
     }
 
+    [[noreturn]] void terminate_after_report()
+    {
+#if defined(HPX_HAVE_LOGGING)
+        // write out the log records collected so far
+        hpx::util::logging::try_flush_async_logging();
+#endif
+        std::abort();
+    }
+
     void report_exception_and_terminate(std::exception const& e)
     {
         report_exception_and_continue(e);
-        std::abort();
+        terminate_after_report();
     }
 
     void report_exception_and_terminate(std::exception_ptr const& e)
     {
         report_exception_and_continue(e);
-        std::abort();
+        terminate_after_report();
     }
 
     void report_exception_and_terminate(hpx::exception const& e)
     {
         report_exception_and_continue(e);
-        std::abort();
+        terminate_after_report();
     }
 
     hpx::exception_info construct_exception_info(std::string const& func,
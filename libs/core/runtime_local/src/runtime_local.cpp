@@ -65,6 +65,11 @@ namespace hpx {
     ///////////////////////////////////////////////////////////////////////////
     void handle_termination(char const* reason)
     {
+#if defined(HPX_HAVE_LOGGING)
+        // write out the log records collected so far
+        util::logging::try_flush_async_logging();
+#endif
+
         if (hpx::threads::coroutines::attach_debugger_on_sigv)
         {
             util::attach_debugger();
@@ -451,6 +456,12 @@ namespace hpx {
 #endif
         LRT_(debug).format("~runtime_local(finished)");
 
+#if defined(HPX_HAVE_LOGGING)
+        // all threads which could log have exited, write out the remaining
+        // records and switch the loggers back to synchronous operation
+        util::logging::disable_async_logging();
+#endif
+
         LPROGRESS_;
 
         // allow to reuse instance number if this was the only instance
@@ -11,6 +11,7 @@
 
 #include <hpx/serialization/brace_initializable_fwd.hpp>
 #include <hpx/serialization/serialization_fwd.hpp>
+#include <hpx/serialization/serialize_members.hpp>
 #include <hpx/serialization/std_tuple.hpp>
 #include <hpx/serialization/traits/brace_initializable_traits.hpp>
 
@@ -32,8 +33,7 @@ namespace hpx::serialization {
         hpx::traits::detail::size<1>)
     {
         auto& [p1] = t;
-        auto&& data = std::forward_as_tuple(p1);
-        serialize(archive, data, version);
+        detail::serialize_fused_members<true>(archive, version, p1);
     }
 
     template <typename Archive, typename T>
@@ -41,8 +41,7 @@ namespace hpx::serialization {
         hpx::traits::detail::size<2>)
     {
         auto& [p1, p2] = t;
-        auto&& data = std::forward_as_tuple(p1, p2);
-        serialize(archive, data, version);
+        detail::serialize_fused_members<true>(archive, version, p1, p2);
     }
 
     template <typename Archive, typename T>
@@ -50,8 +49,7 @@ namespace hpx::serialization {
         hpx::traits::detail::size<3>)
     {
         auto& [p1, p2, p3] = t;
-        auto&& data = std::forward_as_tuple(p1, p2, p3);
-        serialize(archive, data, version);
+        detail::serialize_fused_members<true>(archive, version, p1, p2, p3);
     }
 
     template <typename Archive, typename T>
@@ -59,8 +57,7 @@ namespace hpx::serialization {
         hpx::traits::detail::size<4>)
     {
         auto& [p1, p2, p3, p4] = t;
-        auto&& data = std::forward_as_tuple(p1, p2, p3, p4);
-        serialize(archive, data, version);
+        detail::serialize_fused_members<true>(archive, version, p1, p2, p3, p4);
     }
 
     template <typename Archive, typename T>
@@ -68,8 +65,8 @@ namespace hpx::serialization {
         hpx::traits::detail::size<5>)
     {
         auto& [p1, p2, p3, p4, p5] = t;
-        auto&& data = std::forward_as_tuple(p1, p2, p3, p4, p5);
-        serialize(archive, data, version);
+        detail::serialize_fused_members<true>(
+            archive, version, p1, p2, p3, p4, p5);
     }
 
     template <typename Archive, typename T>
@@ -77,8 +74,8 @@ namespace hpx::serialization {
         hpx::traits::detail::size<6>)
     {
         auto& [p1, p2, p3, p4, p5, p6] = t;
-        auto&& data = std::forward_as_tuple(p1, p2, p3, p4, p5, p6);
-        serialize(archive, data, version);
+        detail::serialize_fused_members<true>(
+            archive, version, p1, p2, p3, p4, p5, p6);
     }
 
     template <typename Archive, typename T>
@@ -86,8 +83,8 @@ namespace hpx::serialization {
         hpx::traits::detail::size<7>)
     {
         auto& [p1, p2, p3, p4, p5, p6, p7] = t;
-        auto&& data = std::forward_as_tuple(p1, p2, p3, p4, p5, p6, p7);
-        serialize(archive, data, version);
+        detail::serialize_fused_members<true>(
+            archive, version, p1, p2, p3, p4, p5, p6, p7);
     }
 
     template <typename Archive, typename T>
@@ -95,8 +92,8 @@ namespace hpx::serialization {
         hpx::traits::detail::size<8>)
     {
         auto& [p1, p2, p3, p4, p5, p6, p7, p8] = t;
-        auto&& data = std::forward_as_tuple(p1, p2, p3, p4, p5, p6, p7, p8);
-        serialize(archive, data, version);
+        detail::serialize_fused_members<true>(
+            archive, version, p1, p2, p3, p4, p5, p6, p7, p8);
     }
 
     template <typename Archive, typename T>
@@ -104,8 +101,8 @@ namespace hpx::serialization {
         hpx::traits::detail::size<9>)
     {
         auto& [p1, p2, p3, p4, p5, p6, p7, p8, p9] = t;
-        auto&& data = std::forward_as_tuple(p1, p2, p3, p4, p5, p6, p7, p8, p9);
-        serialize(archive, data, version);
+        detail::serialize_fused_members<true>(
+            archive, version, p1, p2, p3, p4, p5, p6, p7, p8, p9);
     }
 
     template <typename Archive, typename T>
@@ -113,9 +110,8 @@ namespace hpx::serialization {
         hpx::traits::detail::size<10>)
     {
         auto& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10] = t;
-        auto&& data =
-            std::forward_as_tuple(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);
-        serialize(archive, data, version);
+        detail::serialize_fused_members<true>(
+            archive, version, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);
     }
 
     template <typename Archive, typename T>
@@ -123,9 +119,8 @@ namespace hpx::serialization {
         hpx::traits::detail::size<11>)
     {
         auto& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11] = t;
-        auto&& data =
-            std::forward_as_tuple(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11);
-        serialize(archive, data, version);
+        detail::serialize_fused_members<true>(
+            archive, version, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11);
     }
 
     template <typename Archive, typename T>
@@ -133,9 +128,9 @@ namespace hpx::serialization {
         hpx::traits::detail::size<12>)
     {
         auto& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12] = t;
-        auto&& data = std::forward_as_tuple(
-            p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12);
-        serialize(archive, data, version);
+        detail::serialize_fused_members<true>(
+            archive, version, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11,
+            p12);
     }
 
     template <typename Archive, typename T>
@@ -143,9 +138,9 @@ namespace hpx::serialization {
         hpx::traits::detail::size<13>)
     {
         auto& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13] = t;
-        auto&& data = std::forward_as_tuple(
-            p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13);
-        serialize(archive, data, version);
+        detail::serialize_fused_members<true>(
+            archive, version, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12,
+            p13);
     }
 
     template <typename Archive, typename T>
@@ -153,9 +148,9 @@ namespace hpx::serialization {
         hpx::traits::detail::size<14>)
     {
         auto& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14] = t;
-        auto&& data = std::forward_as_tuple(
-            p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14);
-        serialize(archive, data, version);
+        detail::serialize_fused_members<true>(
+            archive, version, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12,
+            p13, p14);
     }
 
     template <typename Archive, typename T>
@@ -164,9 +159,9 @@ namespace hpx::serialization {
     {
         auto& [p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14,
             p15] = t;
-        auto&& data = std::forward_as_tuple(
-            p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15);
-        serialize(archive, data, version);
+        detail::serialize_fused_members<true>(
+            archive, version, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12,
+            p13, p14, p15);
     }
 
     template <typename Archive, typename T>
@@ -0,0 +1,223 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file serialize_members.hpp
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/serialization/serialization_fwd.hpp>
+#include <hpx/serialization/std_tuple.hpp>
+#include <hpx/serialization/traits/is_bitwise_serializable.hpp>
+#include <hpx/serialization/traits/is_not_bitwise_serializable.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace hpx::serialization {
+
+    namespace detail {
+
+        ///////////////////////////////////////////////////////////////////////
+        // Data members which can be copied bitwise as part of a larger
+        // memory range. Note that integral members are archived in their
+        // native size (instead of being widened to 64 bit) if they are part
+        // of such a range.
+        template <typename T>
+        inline constexpr bool is_fusable_member_v =
+            std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> &&
+            !std::is_array_v<T> &&
+            (std::is_arithmetic_v<T> || std::is_enum_v<T> ||
+                hpx::traits::is_bitwise_serializable_v<T> ||
+                !hpx::traits::is_not_bitwise_serializable_v<T>);
+
+        // The compile-time plan for serializing the given members: runs of
+        // at least two adjacent fusable members are copied at once, all
+        // other members are archived one by one.
+        template <typename... Ts>
+        struct fused_members_plan
+        {
+            static constexpr std::size_t size = sizeof...(Ts);
+
+            static constexpr bool fusable[sizeof...(Ts) + 1] = {
+                is_fusable_member_v<std::remove_cv_t<Ts>>..., false};
+
+            // Return the index one past the end of the run of fusable
+            // members starting at the given index
+            static constexpr std::size_t run_end(std::size_t i) noexcept
+            {
+                while (fusable[i])
+                {
+                    ++i;
+                }
+                return i;
+            }
+        };
+
+        // Verify that the given members are laid out in memory in the given
+        // order without any other data in between. If padding is allowed,
+        // the members may be separated by the bytes needed for aligning the
+        // next member, which is valid only if the members are all data
+        // members of the same object. Padding bytes are archived as zeros.
+        template <bool AllowPadding, typename... Ts>
+        bool members_are_contiguous(Ts const&... ts) noexcept
+        {
+            std::uintptr_t const begin[] = {
+                reinterpret_cast<std::uintptr_t>(std::addressof(ts))...};
+            constexpr std::size_t sizes[] = {sizeof(Ts)...};
+            constexpr std::size_t alignments[] = {alignof(Ts)...};
+
+            for (std::size_t i = 1; i != sizeof...(Ts); ++i)
+            {
+                std::uintptr_t const end = begin[i - 1] + sizes[i - 1];
+                if (begin[i] < end)
+                {
+                    return false;
+                }
+
+                std::size_t const gap = begin[i] - end;
+                if (AllowPadding ? gap >= alignments[i] : gap != 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Save the memory range covered by the given (contiguous) members.
+        // The padding bytes between the members are not initialized, those
+        // are archived as zeros instead.
+        template <typename Archive, typename... Ts>
+        void save_zero_padded(
+            Archive& ar, std::uintptr_t begin, std::size_t count, Ts&... ts)
+        {
+            constexpr std::size_t max_count =
+                ((sizeof(Ts) + alignof(Ts) - 1) + ...);
+            HPX_ASSERT(count <= max_count);
+
+            char buffer[max_count] = {};
+
+            // clang-format off
+            (std::memcpy(buffer +
+                    (reinterpret_cast<std::uintptr_t>(std::addressof(ts)) -
+                        begin),
+                std::addressof(ts), sizeof(Ts)), ...);
+            // clang-format on
+
+            ar.save_binary(buffer, count);
+        }
+
+        template <bool AllowPadding, std::size_t First, typename Archive,
+            typename Tuple, std::size_t... Is>
+        void serialize_fused_run(
+            Archive& ar, Tuple& t, std::index_sequence<Is...>)
+        {
+            if (!members_are_contiguous<AllowPadding>(
+                    std::get<First + Is>(t)...))
+            {
+                // normal serialization
+                // clang-format off
+                ((ar & std::get<First + Is>(t)), ...);
+                // clang-format on
+                return;
+            }
+
+            constexpr std::size_t last = First + sizeof...(Is) - 1;
+            auto& first_member = std::get<First>(t);
+            auto& last_member = std::get<last>(t);
+
+            std::size_t const count =
+                reinterpret_cast<std::uintptr_t>(std::addressof(last_member)) +
+                sizeof(last_member) -
+                reinterpret_cast<std::uintptr_t>(std::addressof(first_member));
+
+            if constexpr (std::is_same_v<Archive, input_archive>)
+            {
+                ar.load_binary(std::addressof(first_member), count);
+            }
+            else
+            {
+                if constexpr (AllowPadding)
+                {
+                    constexpr std::size_t members_size =
+                        (sizeof(std::get<First + Is>(t)) + ...);
+                    if (count != members_size)
+                    {
+                        save_zero_padded(ar,
+                            reinterpret_cast<std::uintptr_t>(
+                                std::addressof(first_member)),
+                            count, std::get<First + Is>(t)...);
+                        return;
+                    }
+                }
+                ar.save_binary(std::addressof(first_member), count);
+            }
+        }
+
+        template <bool AllowPadding, std::size_t I, typename Plan,
+            typename Archive, typename Tuple>
+        void serialize_fused(Archive& ar, Tuple& t)
+        {
+            if constexpr (I != Plan::size)
+            {
+                constexpr std::size_t end = Plan::run_end(I);
+                if constexpr (end - I >= 2)
+                {
+                    serialize_fused_run<AllowPadding, I>(
+                        ar, t, std::make_index_sequence<end - I>());
+                    serialize_fused<AllowPadding, end, Plan>(ar, t);
+                }
+                else
+                {
+                    // clang-format off
+                    ar & std::get<I>(t);
+                    // clang-format on
+                    serialize_fused<AllowPadding, I + 1, Plan>(ar, t);
+                }
+            }
+        }
+
+        template <bool AllowPadding, typename Archive, typename... Ts>
+        void serialize_fused_members(
+            Archive& ar, unsigned int version, Ts&... members)
+        {
+            auto&& data = std::forward_as_tuple(members...);
+
+            // NOLINTNEXTLINE(bugprone-branch-clone)
+            if (ar.disable_array_optimization() || ar.endianess_differs())
+            {
+                // normal serialization
+                serialize(ar, data, version);
+                return;
+            }
+
+            serialize_fused<AllowPadding, 0, fused_members_plan<Ts...>>(
+                ar, data);
+        }
+    }    // namespace detail
+
+    /// Serialize the given data members of an object in the given order.
+    /// Adjacent members which are bitwise serializable (e.g. arithmetic
+    /// types, enums, or types for which \a is_bitwise_serializable is
+    /// specialized) are archived using a single copy operation if they
+    /// immediately follow each other in memory, all other members are
+    /// archived one by one.
+    ///
+    /// \note The archived data is not compatible with archiving the members
+    ///       one by one, the same list of members has to be used for saving
+    ///       and loading an object.
+    template <typename Archive, typename... Ts>
+    void serialize_members(Archive& ar, Ts&... members)
+    {
+        detail::serialize_fused_members<false>(ar, 0, members...);
+    }
+}    // namespace hpx::serialization
@@ -5,6 +5,7 @@
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <hpx/serialization/brace_initializable.hpp>
 #include <hpx/serialization/detail/preprocess_container.hpp>
 #include <hpx/serialization/serialize.hpp>
 #include <hpx/serialization/string.hpp>
@@ -168,6 +169,59 @@ namespace hpx_test {
         hpx::serialization::input_archive archiver(data);
         archiver >> record;
     }
+
+    // nested aggregates, the bitwise serializable members of which are
+    // copied at once
+    struct Position
+    {
+        double x;
+        double y;
+        double z;
+    };
+
+    struct Sample
+    {
+        std::int64_t id;
+        std::int32_t kind;
+        float weight;
+        Position position;
+        std::vector<std::int64_t> neighbors;
+        std::uint16_t flags;
+        bool valid;
+    };
+
+    bool operator==(Position const& lhs, Position const& rhs)
+    {
+        return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z;
+    }
+
+    bool operator==(Sample const& lhs, Sample const& rhs)
+    {
+        return lhs.id == rhs.id && lhs.kind == rhs.kind &&
+            lhs.weight == rhs.weight && lhs.position == rhs.position &&
+            lhs.neighbors == rhs.neighbors && lhs.flags == rhs.flags &&
+            lhs.valid == rhs.valid;
+    }
+
+    template <typename T>
+    void to_string(T const& value, std::string& data, std::uint32_t flags)
+    {
+        {
+            hpx::serialization::detail::preprocess_container p;
+            hpx::serialization::output_archive archiver(p, flags);
+            archiver << value;
+            data.resize(p.size());
+        }
+        hpx::serialization::output_archive archiver(data, flags);
+        archiver << value;
+    }
+
+    template <typename T>
+    void from_string(T& value, std::string const& data)
+    {
+        hpx::serialization::input_archive archiver(data);
+        archiver >> value;
+    }
 }    // namespace hpx_test
 
 void hpx_serialization_test(std::size_t iterations)
@@ -217,6 +271,53 @@ void hpx_serialization_test(std::size_t iterations)
               << std::endl;
 }
 
+void hpx_nested_serialization_test(
+    std::size_t iterations, char const* name, std::uint32_t flags)
+{
+    using namespace hpx_test;
+
+    std::vector<Sample> s1, s2;
+    for (std::size_t i = 0; i != kIntegers.size(); ++i)
+    {
+        Sample s{kIntegers[i], static_cast<std::int32_t>(i % 7),
+            static_cast<float>(i) * 0.5f,
+            Position{static_cast<double>(kIntegers[i]), -1.0, 2.5},
+            {kIntegers[i], kIntegers[(i + 1) % kIntegers.size()]},
+            static_cast<std::uint16_t>(i), i % 2 == 0};
+        s1.push_back(s);
+    }
+
+    std::string serialized;
+    to_string(s1, serialized, flags);
+    from_string(s2, serialized);
+
+    if (s1 != s2)
+    {
+        throw std::logic_error("hpx's nested case: deserialization failed");
+    }
+
+    std::cout << "hpx (" << name << "): size    = " << serialized.size()
+              << " bytes" << std::endl;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        serialized.clear();
+        to_string(s1, serialized, flags);
+        from_string(s2, serialized);
+    }
+
+    auto finish = std::chrono::high_resolution_clock::now();
+    auto duration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(finish - start)
+            .count();
+
+    std::cout << "hpx (" << name << "): time    = " << duration
+              << " milliseconds" << std::endl
+              << std::endl;
+}
+
 int main(int argc, char** argv)
 {
     if (argc < 2)
@@ -242,4 +343,10 @@ int main(int argc, char** argv)
     }
 
     hpx_serialization_test(iterations);
+
+    // nested aggregates with and without fusing adjacent members
+    hpx_nested_serialization_test(iterations, "fused", 0);
+    hpx_nested_serialization_test(iterations, "per member",
+        std::uint32_t(
+            hpx::serialization::archive_flags::disable_array_optimization));
 }
@@ -0,0 +1,259 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that adjacent bitwise serializable members are correctly archived
+// with a single copy operation.
+
+#include <hpx/config.hpp>
+
+#include <hpx/modules/serialization.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <tuple>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+enum class color : std::uint8_t
+{
+    red,
+    green,
+    blue
+};
+
+// all members can be copied at once
+struct point
+{
+    double x;
+    double y;
+    std::int32_t id;
+    color c;
+};
+
+bool operator==(point const& lhs, point const& rhs)
+{
+    return std::tie(lhs.x, lhs.y, lhs.id, lhs.c) ==
+        std::tie(rhs.x, rhs.y, rhs.id, rhs.c);
+}
+
+// the vector splits the bitwise serializable members into two runs
+struct particle
+{
+    char tag;
+    std::int64_t id;
+    float mass;
+    std::vector<double> history;
+    bool active;
+    std::uint16_t flags;
+    std::uint64_t step;
+    point position;
+    std::string name;
+};
+
+bool operator==(particle const& lhs, particle const& rhs)
+{
+    return std::tie(lhs.tag, lhs.id, lhs.mass, lhs.history, lhs.active,
+               lhs.flags, lhs.step, lhs.position, lhs.name) ==
+        std::tie(rhs.tag, rhs.id, rhs.mass, rhs.history, rhs.active,
+            rhs.flags, rhs.step, rhs.position, rhs.name);
+}
+
+// all members can be copied at once, but there is padding between them
+struct padded
+{
+    char c;
+    std::int64_t i;
+    std::int16_t s;
+    double d;
+};
+
+bool operator==(padded const& lhs, padded const& rhs)
+{
+    return std::tie(lhs.c, lhs.i, lhs.s, lhs.d) ==
+        std::tie(rhs.c, rhs.i, rhs.s, rhs.d);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// opt-in member list, the members are listed in declaration order
+class sample
+{
+public:
+    sample() = default;
+
+    sample(std::int32_t a, std::int32_t b, double c, std::string d)
+      : a_(a)
+      , b_(b)
+      , c_(c)
+      , d_(HPX_MOVE(d))
+    {
+    }
+
+    friend bool operator==(sample const& lhs, sample const& rhs)
+    {
+        return std::tie(lhs.a_, lhs.b_, lhs.c_, lhs.d_) ==
+            std::tie(rhs.a_, rhs.b_, rhs.c_, rhs.d_);
+    }
+
+private:
+    friend class hpx::serialization::access;
+
+    template <typename Archive>
+    void serialize(Archive& ar, unsigned)
+    {
+        hpx::serialization::serialize_members(ar, a_, b_, c_, d_);
+    }
+
+    std::int32_t a_ = 0;
+    std::int32_t b_ = 0;
+    double c_ = 0.0;
+    std::string d_;
+};
+
+// opt-in member list, the members are not listed in declaration order
+class reversed_sample
+{
+public:
+    reversed_sample() = default;
+
+    reversed_sample(std::int32_t a, std::int32_t b, std::int32_t c)
+      : a_(a)
+      , b_(b)
+      , c_(c)
+    {
+    }
+
+    friend bool operator==(
+        reversed_sample const& lhs, reversed_sample const& rhs)
+    {
+        return std::tie(lhs.a_, lhs.b_, lhs.c_) ==
+            std::tie(rhs.a_, rhs.b_, rhs.c_);
+    }
+
+private:
+    friend class hpx::serialization::access;
+
+    template <typename Archive>
+    void serialize(Archive& ar, unsigned)
+    {
+        hpx::serialization::serialize_members(ar, c_, b_, a_);
+    }
+
+    std::int32_t a_ = 0;
+    std::int32_t b_ = 0;
+    std::int32_t c_ = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t test_roundtrip(T const& value, std::uint32_t flags = 0)
+{
+    std::vector<char> buffer;
+    hpx::serialization::output_archive oarchive(buffer, flags);
+    oarchive << value;
+
+    hpx::serialization::input_archive iarchive(buffer);
+    T deserialized;
+    iarchive >> deserialized;
+
+    HPX_TEST(value == deserialized);
+    HPX_TEST_EQ(oarchive.bytes_written(), iarchive.bytes_read());
+
+    return oarchive.bytes_written();
+}
+
+// the padding bytes of the archived object are set to the given value
+std::vector<char> save_padded(unsigned char fill)
+{
+    alignas(padded) unsigned char storage[sizeof(padded)];
+    std::memset(storage, fill, sizeof(padded));
+    padded* p = ::new (storage) padded{'a', -1, 2, 3.5};
+
+    std::vector<char> buffer;
+    hpx::serialization::output_archive oarchive(buffer);
+    oarchive << *p;
+
+    p->~padded();
+    return buffer;
+}
+
+particle make_particle(std::int64_t id)
+{
+    return particle{'p', id, 1.5f * static_cast<float>(id), {1.0, 2.0, 3.0},
+        true, 0x1234, 42,
+        point{0.5 * static_cast<double>(id), -1.0,
+            static_cast<std::int32_t>(id), color::green},
+        "particle"};
+}
+
+int main()
+{
+    std::uint32_t const disable_array_optimization = std::uint32_t(
+        hpx::serialization::archive_flags::disable_array_optimization);
+
+    {
+        point p{1.0, 2.0, 3, color::blue};
+
+        std::size_t const fused = test_roundtrip(p);
+        std::size_t const unfused =
+            test_roundtrip(p, disable_array_optimization);
+
+        // the members (including padding, excluding tail padding) are
+        // copied at once instead of being archived as four 64 bit values
+        HPX_TEST_EQ(unfused - fused,
+            4 * sizeof(std::int64_t) - (offsetof(point, c) + sizeof(color)));
+    }
+
+    {
+        padded p{'a', -1, 2, 3.5};
+        test_roundtrip(p);
+        test_roundtrip(p, disable_array_optimization);
+
+        // the padding bytes are not archived as they are in memory
+        HPX_TEST(save_padded(0x00) == save_padded(0xff));
+    }
+
+    {
+        particle p = make_particle(7);
+
+        std::size_t const fused = test_roundtrip(p);
+        std::size_t const unfused =
+            test_roundtrip(p, disable_array_optimization);
+
+        // integral members are not widened if they are copied at once
+        HPX_TEST_LT(fused, unfused);
+    }
+
+    {
+        std::vector<particle> particles;
+        for (std::int64_t i = 0; i != 100; ++i)
+        {
+            particles.push_back(make_particle(i));
+        }
+
+        test_roundtrip(particles);
+        test_roundtrip(particles, disable_array_optimization);
+    }
+
+    {
+        sample s(-1, 2, 3.5, "sample");
+        test_roundtrip(s);
+        test_roundtrip(s, disable_array_optimization);
+    }
+
+    {
+        // members which are not contiguous in the given order are archived
+        // one by one
+        reversed_sample s(1, 2, 3);
+        HPX_TEST_EQ(test_roundtrip(s),
+            test_roundtrip(s, disable_array_optimization));
+    }
+
+    return hpx::util::report_errors();
+}
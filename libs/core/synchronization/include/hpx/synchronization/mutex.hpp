@@ -16,6 +16,9 @@
 #include <hpx/synchronization/spinlock.hpp>
 #include <hpx/timing/steady_clock.hpp>
 
+#include <cstddef>
+#include <mutex>
+
 namespace hpx { namespace threads {
 
     using thread_id_ref_type = thread_id_ref;
@@ -33,6 +36,11 @@ namespace hpx { namespace threads {
 namespace hpx {
 
     ///////////////////////////////////////////////////////////////////////////
+    // Threads waiting for the mutex are queued in FIFO order. On unlock, the
+    // ownership of the mutex is handed directly to the first waiting thread,
+    // which prevents newly arriving threads from overtaking it. Before
+    // suspending, lock() spins for a short, adaptively adjusted time while the
+    // current owner of the mutex is running.
     class mutex
     {
     public:
@@ -64,10 +72,32 @@ namespace hpx {
 
         HPX_CORE_EXPORT void unlock(error_code& ec = throws);
 
+    protected:
+        // lock() spins for at most the given number of iterations before
+        // suspending (instead of HPX_MUTEX_MAX_SPIN_COUNT)
+        HPX_CORE_EXPORT mutex(
+            char const* const description, std::size_t max_spin_count);
+
+        // spin while the owner of the mutex is running, returns true if the
+        // mutex was released in the meantime
+        bool spin(std::unique_lock<mutex_type>& l);
+
+        // release the ownership of the mutex, handing it over to the first
+        // waiting thread, if any
+        void hand_over(std::unique_lock<mutex_type> l, error_code& ec);
+
     protected:
         mutable mutex_type mtx_;
         threads::thread_id_type owner_id_;
         hpx::lcos::local::detail::condition_variable cond_;
+
+        // the ownership of the mutex was handed to the first waiting thread,
+        // which has not resumed yet
+        bool handoff_;
+
+        // running estimate of the number of spins needed to acquire the mutex
+        std::size_t spin_count_;
+        std::size_t max_spin_count_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -18,6 +18,8 @@
 #include <hpx/timing/steady_clock.hpp>
 #include <hpx/type_support/unused.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <mutex>
 #include <utility>
 
@@ -25,7 +27,15 @@ namespace hpx {
 
     ///////////////////////////////////////////////////////////////////////////
     mutex::mutex(char const* const description)
+      : mutex(description, HPX_MUTEX_MAX_SPIN_COUNT)
+    {
+    }
+
+    mutex::mutex(char const* const description, std::size_t max_spin_count)
       : owner_id_(threads::invalid_thread_id)
+      , handoff_(false)
+      , spin_count_(0)
+      , max_spin_count_(max_spin_count)
     {
         HPX_ITT_SYNC_CREATE(this, "hpx::mutex", description);
         HPX_ITT_SYNC_RENAME(this, "hpx::mutex");
@@ -53,13 +63,40 @@ namespace hpx {
             return;
         }
 
-        while (owner_id_ != threads::invalid_thread_id)
+        if ((owner_id_ != threads::invalid_thread_id || handoff_) &&
+            !spin(l))
         {
-            cond_.wait(l, ec);
-            if (ec)
+            // wait for the ownership to be handed over to this thread
+            for (;;)
             {
-                HPX_ITT_SYNC_CANCEL(this);
-                return;
+                threads::thread_restart_state const reason = cond_.wait(l, ec);
+                bool const signaled =
+                    reason == threads::thread_restart_state::signaled;
+
+                if (ec)
+                {
+                    HPX_ITT_SYNC_CANCEL(this);
+                    if (signaled && handoff_)
+                    {
+                        // pass on the ownership handed over to this thread
+                        handoff_ = false;
+                        error_code ec2(throwmode::lightweight);
+                        hand_over(HPX_MOVE(l), ec2);
+                    }
+                    return;
+                }
+
+                if (signaled && handoff_)
+                {
+                    handoff_ = false;
+                    break;
+                }
+
+                // woken up without being handed the ownership
+                if (owner_id_ == threads::invalid_thread_id && !handoff_)
+                {
+                    break;
+                }
             }
         }
 
@@ -75,7 +112,7 @@ namespace hpx {
         HPX_ITT_SYNC_PREPARE(this);
         std::unique_lock<mutex_type> l(mtx_);
 
-        if (owner_id_ != threads::invalid_thread_id)
+        if (owner_id_ != threads::invalid_thread_id || handoff_)
         {
             HPX_ITT_SYNC_CANCEL(this);
             return false;
@@ -107,8 +144,83 @@ namespace hpx {
         }
 
         HPX_ITT_SYNC_RELEASED(this);
+        hand_over(HPX_MOVE(l), ec);
+    }
+
+    bool mutex::spin(std::unique_lock<mutex_type>& l)
+    {
+        HPX_ASSERT(l.owns_lock());
+
+        // Spin for at most twice the number of iterations that were needed
+        // recently, adapting the limit with every call in the same way as
+        // glibc's adaptive mutexes do.
+        std::size_t const max_spins =
+            (std::min)(max_spin_count_, 2 * spin_count_ + 10);
+
+        std::size_t k = 0;
+        bool acquired = false;
+        for (/**/; k != max_spins; ++k)
+        {
+            // never overtake threads that are already waiting
+            if (handoff_ || !cond_.empty(l))
+            {
+                break;
+            }
+
+            if (owner_id_ == threads::invalid_thread_id)
+            {
+                acquired = true;
+                break;
+            }
+
+            // spinning is pointless if the owner is suspended or waiting to
+            // be scheduled
+            if (threads::get_thread_id_data(owner_id_)->get_state().state() !=
+                threads::thread_schedule_state::active)
+            {
+                break;
+            }
+
+            l.unlock();
+            for (std::size_t i = 0; i != 16; ++i)
+            {
+                HPX_SMT_PAUSE;
+            }
+            l.lock();
+        }
+
+        // The mutex may have been released while pausing during the last
+        // iteration. As no thread was waiting, nobody would wake up this
+        // thread if it suspended now.
+        if (!acquired && owner_id_ == threads::invalid_thread_id &&
+            !handoff_ && cond_.empty(l))
+        {
+            acquired = true;
+        }
+
+        if (k != 0)
+        {
+            spin_count_ = std::size_t(std::ptrdiff_t(spin_count_) +
+                (std::ptrdiff_t(k) - std::ptrdiff_t(spin_count_)) / 8);
+        }
+        return acquired;
+    }
+
+    void mutex::hand_over(std::unique_lock<mutex_type> l, error_code& ec)
+    {
+        HPX_ASSERT(l.owns_lock());
+
         owner_id_ = threads::invalid_thread_id;
+        if (cond_.empty(l))
+        {
+            if (&ec != &throws)
+                ec = make_success_code();
+            return;
+        }
 
+        // The first waiting thread will own the mutex as soon as it resumes,
+        // all other threads are kept from acquiring the mutex until then.
+        handoff_ = true;
         {
             util::ignore_while_checking il(&l);
             HPX_UNUSED(il);
@@ -135,26 +247,38 @@ namespace hpx {
         std::unique_lock<mutex_type> l(mtx_);
 
         threads::thread_id_type self_id = threads::get_self_id();
-        if (owner_id_ != threads::invalid_thread_id)
+        while (owner_id_ != threads::invalid_thread_id || handoff_)
         {
             threads::thread_restart_state const reason =
                 cond_.wait_until(l, abs_time, ec);
+            bool const signaled =
+                reason == threads::thread_restart_state::signaled;
+
             if (ec)
             {
                 HPX_ITT_SYNC_CANCEL(this);
+                if (signaled && handoff_)
+                {
+                    // pass on the ownership handed over to this thread
+                    handoff_ = false;
+                    error_code ec2(throwmode::lightweight);
+                    hand_over(HPX_MOVE(l), ec2);
+                }
                 return false;
             }
 
-            if (reason == threads::thread_restart_state::timeout)    //-V110
+            // a thread that timed out was still queued, thus the ownership
+            // can't have been handed over to it
+            if (!signaled)    //-V110
             {
                 HPX_ITT_SYNC_CANCEL(this);
                 return false;
             }
 
-            if (owner_id_ != threads::invalid_thread_id)    //-V110
+            if (handoff_)
             {
-                HPX_ITT_SYNC_CANCEL(this);
-                return false;
+                handoff_ = false;
+                break;
             }
         }
 
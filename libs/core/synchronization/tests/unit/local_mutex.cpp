@@ -8,7 +8,9 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/functional/bind.hpp>
+#include <hpx/local/future.hpp>
 #include <hpx/local/init.hpp>
+#include <hpx/local/thread.hpp>
 #include <hpx/modules/testing.hpp>
 #include <hpx/modules/threading.hpp>
 #include <hpx/modules/threadmanager.hpp>
@@ -16,6 +18,7 @@
 #include <hpx/synchronization/mutex.hpp>
 
 #include <chrono>
+#include <cstddef>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -273,10 +276,57 @@ struct test_recursive_lock
     }
 };
 
+// Many threads contending for the same mutex exercise the handoff of the
+// ownership to waiting threads as well as the spinning in lock().
+template <typename M>
+struct test_contention
+{
+    typedef M mutex_type;
+
+    void operator()()
+    {
+        std::size_t const num_threads = 4 * hpx::get_os_thread_count();
+        std::size_t const iterations = 1000;
+
+        mutex_type mtx;
+        std::size_t counter = 0;
+        bool inside = false;
+
+        std::vector<hpx::future<void>> fs;
+        fs.reserve(num_threads);
+        for (std::size_t i = 0; i != num_threads; ++i)
+        {
+            fs.push_back(hpx::async([&]() {
+                for (std::size_t j = 0; j != iterations; ++j)
+                {
+                    std::lock_guard<mutex_type> l(mtx);
+                    HPX_TEST(!inside);
+                    inside = true;
+
+                    // occasionally suspend while holding the mutex
+                    if (j % 100 == 0)
+                    {
+                        hpx::this_thread::yield();
+                    }
+
+                    ++counter;
+                    inside = false;
+                }
+            }));
+        }
+        hpx::wait_all(fs);
+
+        HPX_TEST_EQ(counter, num_threads * iterations);
+        HPX_TEST(mtx.try_lock());
+        mtx.unlock();
+    }
+};
+
 void test_mutex()
 {
     test_lock<hpx::mutex>()();
     test_trylock<hpx::mutex>()();
+    test_contention<hpx::mutex>()();
 }
 
 void test_timed_mutex()
@@ -284,6 +334,7 @@ void test_timed_mutex()
     test_lock<hpx::timed_mutex>()();
     test_trylock<hpx::timed_mutex>()();
     test_timedlock<hpx::timed_mutex>()();
+    test_contention<hpx::timed_mutex>()();
 }
 
 //void test_recursive_mutex()
@@ -0,0 +1,77 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Two threads repeatedly hand the ownership of a mutex to each other. The
+// mutex spins for a single iteration only, which makes it likely for the
+// owner to release the mutex while the other thread is pausing at the end of
+// its spin phase. That thread must not suspend afterwards as no other thread
+// would ever wake it up.
+
+#include <hpx/local/future.hpp>
+#include <hpx/local/init.hpp>
+#include <hpx/local/thread.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/synchronization/mutex.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct small_spin_mutex : hpx::mutex
+{
+    small_spin_mutex()
+      : hpx::mutex("small_spin_mutex", 1)
+    {
+    }
+};
+
+template <typename Mutex>
+void test_handoff(std::size_t iterations)
+{
+    Mutex mtx;
+    std::size_t counter = 0;
+    std::atomic<bool> inside(false);
+
+    auto f = [&]() {
+        for (std::size_t i = 0; i != iterations; ++i)
+        {
+            std::lock_guard<Mutex> l(mtx);
+            HPX_TEST(!inside.exchange(true));
+            ++counter;
+            inside.store(false);
+        }
+    };
+
+    hpx::future<void> f1 = hpx::async(f);
+    hpx::future<void> f2 = hpx::async(f);
+    hpx::wait_all(f1, f2);
+
+    HPX_TEST_EQ(counter, 2 * iterations);
+    HPX_TEST(mtx.try_lock());
+    mtx.unlock();
+}
+
+int hpx_main()
+{
+    test_handoff<small_spin_mutex>(100000);
+    test_handoff<hpx::mutex>(100000);
+
+    return hpx::local::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {"hpx.os_threads=2"};
+
+    hpx::local::init_params init_args;
+    init_args.cfg = cfg;
+
+    HPX_TEST_EQ(hpx::local::init(hpx_main, argc, argv, init_args), 0);
+    return hpx::util::report_errors();
+}
@@ -220,6 +220,10 @@ namespace hpx { namespace threads {
         mask_type get_used_processing_units() const;
         hwloc_bitmap_ptr get_numa_domain_bitmap() const;
 
+        // return the NUMA domain the given (pool-local) worker thread is
+        // bound to
+        std::size_t get_numa_domain(std::size_t thread_num) const;
+
         // performance counters
 #if defined(HPX_HAVE_THREAD_CUMULATIVE_COUNTS)
         virtual std::int64_t get_executed_threads(
@@ -21,6 +21,7 @@
 #include <hpx/threading_base/thread_init_data.hpp>
 #include <hpx/threading_base/thread_num_tss.hpp>
 #include <hpx/threading_base/thread_pool_base.hpp>
+#include <hpx/threadmanager/elastic_pool_controller.hpp>
 #include <hpx/threadmanager/threadmanager_fwd.hpp>
 #include <hpx/topology/cpu_mask.hpp>
 
@@ -85,6 +86,12 @@ namespace hpx { namespace threads {
         bool pool_exists(std::string const& pool_name) const;
         bool pool_exists(std::size_t pool_index) const;
 
+        // Return the elasticity controller of the given pool, or nullptr if
+        // elasticity was not enabled for the pool through the resource
+        // partitioner.
+        elastic_pool_controller* get_elastic_controller(
+            std::size_t pool_index) const;
+
         /// The function \a register_work adds a new work item to the thread
         /// manager. It doesn't immediately create a new \a thread, it just adds
         /// the task parameters (function, initial state and description) to
@@ -393,6 +400,9 @@ namespace hpx { namespace threads {
 #endif
 
     private:
+        void start_elastic_controllers();
+        void stop_elastic_controllers();
+
         mutable mutex_type mtx_;    // mutex protecting the members
 
         hpx::util::runtime_configuration& rtcfg_;
@@ -402,6 +412,8 @@ namespace hpx { namespace threads {
         util::io_service_pool& timer_pool_;    // used for timed set_state
 #endif
         pool_vector pools_;
+        std::vector<std::unique_ptr<elastic_pool_controller>>
+            elastic_controllers_;
 
         notification_policy_type& notifier_;
         detail::network_background_callback_type network_background_callback_;
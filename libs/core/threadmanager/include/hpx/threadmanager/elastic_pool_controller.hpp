@@ -0,0 +1,99 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/resource_partitioner/partitioner_fwd.hpp>
+#include <hpx/threading_base/thread_pool_base.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace threads {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The elastic_pool_controller periodically samples the worker threads of
+    /// a thread pool and suspends processing units while the pool is mostly
+    /// idle, and resumes them as soon as the load increases again. Suspended
+    /// processing units do not spin in the scheduling loop, which leaves
+    /// their cores to other processes running on the same node.
+    ///
+    /// The controller runs on its own OS-thread. It only ever resumes
+    /// processing units it has suspended itself.
+    class HPX_CORE_EXPORT elastic_pool_controller
+    {
+    public:
+        elastic_pool_controller(thread_pool_base& pool,
+            resource::elasticity_parameters const& params);
+        ~elastic_pool_controller();
+
+        elastic_pool_controller(elastic_pool_controller const&) = delete;
+        elastic_pool_controller(elastic_pool_controller&&) = delete;
+        elastic_pool_controller& operator=(
+            elastic_pool_controller const&) = delete;
+        elastic_pool_controller& operator=(elastic_pool_controller&&) = delete;
+
+        // start sampling the pool
+        void start();
+
+        // stop sampling the pool and resume all processing units suspended
+        // by this controller
+        void stop();
+
+        thread_pool_base& get_pool() const noexcept
+        {
+            return pool_;
+        }
+
+        // performance counter data
+        std::int64_t get_suspended_processing_units(bool reset);
+        std::int64_t get_suspension_count(bool reset);
+        std::int64_t get_resumption_count(bool reset);
+        std::int64_t get_decision_count(bool reset);
+
+    private:
+        void run();
+
+        void sample();
+        void decide();
+
+        bool suspend_processing_unit();
+        bool resume_processing_unit();
+
+        thread_pool_base& pool_;
+        resource::elasticity_parameters const params_;
+
+        std::mutex mtx_;
+        std::condition_variable cond_;
+        bool stop_requested_;
+        std::thread thread_;
+
+        // the members below are accessed by the controller thread only
+        std::vector<std::size_t> idle_samples_;
+        std::size_t num_samples_;
+        std::int64_t pending_samples_;
+        std::size_t suspend_streak_;
+        std::size_t resume_streak_;
+
+        // processing units suspended by this controller, most recent last
+        std::vector<std::size_t> suspended_;
+
+        std::atomic<std::int64_t> num_suspended_;
+        std::atomic<std::int64_t> suspensions_;
+        std::atomic<std::int64_t> resumptions_;
+        std::atomic<std::int64_t> decisions_;
+    };
+}}    // namespace hpx::threads
+
+#include <hpx/config/warnings_suffix.hpp>
@@ -0,0 +1,313 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/logging.hpp>
+#include <hpx/resource_partitioner/partitioner_fwd.hpp>
+#include <hpx/threading_base/scheduler_base.hpp>
+#include <hpx/threading_base/scheduler_mode.hpp>
+#include <hpx/threading_base/scheduler_state.hpp>
+#include <hpx/threading_base/thread_pool_base.hpp>
+#include <hpx/threadmanager/elastic_pool_controller.hpp>
+#include <hpx/topology/cpu_mask.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace hpx { namespace threads {
+
+    elastic_pool_controller::elastic_pool_controller(thread_pool_base& pool,
+        resource::elasticity_parameters const& params)
+      : pool_(pool)
+      , params_(params)
+      , stop_requested_(false)
+      , num_samples_(0)
+      , pending_samples_(0)
+      , suspend_streak_(0)
+      , resume_streak_(0)
+      , num_suspended_(0)
+      , suspensions_(0)
+      , resumptions_(0)
+      , decisions_(0)
+    {
+    }
+
+    elastic_pool_controller::~elastic_pool_controller()
+    {
+        stop();
+    }
+
+    void elastic_pool_controller::start()
+    {
+        std::lock_guard<std::mutex> l(mtx_);
+        if (thread_.joinable())
+        {
+            return;    // already running
+        }
+
+        policies::scheduler_base* sched = pool_.get_scheduler();
+        if (sched == nullptr ||
+            !sched->has_scheduler_mode(
+                policies::scheduler_mode::enable_elasticity))
+        {
+            LTM_(warning).format(
+                "elastic_pool_controller: the scheduler of pool {} does not "
+                "support suspending processing units, not starting the "
+                "controller",
+                pool_.get_pool_name());
+            return;
+        }
+
+        stop_requested_ = false;
+        thread_ = std::thread(&elastic_pool_controller::run, this);
+
+        LTM_(info).format(
+            "elastic_pool_controller: started for pool {}", pool_.get_pool_name());
+    }
+
+    void elastic_pool_controller::stop()
+    {
+        {
+            std::lock_guard<std::mutex> l(mtx_);
+            if (!thread_.joinable())
+            {
+                return;
+            }
+            stop_requested_ = true;
+        }
+
+        cond_.notify_all();
+        thread_.join();
+
+        // leave the pool with all processing units running that were running
+        // when the controller was started
+        while (resume_processing_unit())
+        {
+        }
+
+        LTM_(info).format(
+            "elastic_pool_controller: stopped for pool {}", pool_.get_pool_name());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void elastic_pool_controller::run()
+    {
+        std::size_t const num_threads = pool_.get_os_thread_count();
+
+        idle_samples_.assign(num_threads, 0);
+        num_samples_ = 0;
+        pending_samples_ = 0;
+        suspend_streak_ = 0;
+        resume_streak_ = 0;
+
+        std::unique_lock<std::mutex> l(mtx_);
+        while (!stop_requested_)
+        {
+            cond_.wait_for(l, params_.sample_interval);
+            if (stop_requested_)
+            {
+                break;
+            }
+
+            l.unlock();
+
+            sample();
+            if (num_samples_ >= params_.samples_per_decision)
+            {
+                decide();
+
+                std::fill(idle_samples_.begin(), idle_samples_.end(), 0);
+                num_samples_ = 0;
+                pending_samples_ = 0;
+            }
+
+            l.lock();
+        }
+    }
+
+    void elastic_pool_controller::sample()
+    {
+        if (pool_.get_state() != hpx::state::running)
+        {
+            return;
+        }
+
+        std::size_t const num_threads = idle_samples_.size();
+
+        // worker threads which have no work and whose queues are empty
+        mask_type idle_mask = mask_type();
+        threads::resize(idle_mask, num_threads);
+        pool_.get_idle_core_mask(idle_mask);
+
+        for (std::size_t i = 0; i != num_threads; ++i)
+        {
+            if (threads::test(idle_mask, i))
+            {
+                ++idle_samples_[i];
+            }
+        }
+
+        pending_samples_ +=
+            pool_.get_thread_count_pending(std::size_t(-1), false);
+        ++num_samples_;
+    }
+
+    void elastic_pool_controller::decide()
+    {
+        std::size_t running = 0;
+        std::size_t idle = 0;
+        for (std::size_t i = 0; i != idle_samples_.size(); ++i)
+        {
+            if (pool_.get_state(i) == hpx::state::running)
+            {
+                ++running;
+                idle += idle_samples_[i];
+            }
+        }
+
+        if (running == 0)
+        {
+            ++decisions_;
+            return;
+        }
+
+        double const idle_fraction =
+            double(idle) / double(running * num_samples_);
+        double const pending_per_thread =
+            double(pending_samples_) / double(running * num_samples_);
+
+        bool const overloaded = idle_fraction <= params_.resume_idle_fraction ||
+            pending_per_thread > double(params_.resume_queue_length);
+
+        // Both directions require the condition to hold for a number of
+        // consecutive decisions, and any change resets both streaks. Together
+        // with the gap between suspend_idle_fraction and resume_idle_fraction
+        // this avoids oscillating between suspending and resuming.
+        if (overloaded && !suspended_.empty())
+        {
+            suspend_streak_ = 0;
+            if (++resume_streak_ >= params_.resume_after)
+            {
+                resume_streak_ = 0;
+                resume_processing_unit();
+            }
+        }
+        else if (!overloaded &&
+            idle_fraction >= params_.suspend_idle_fraction &&
+            running > params_.min_processing_units)
+        {
+            resume_streak_ = 0;
+            if (++suspend_streak_ >= params_.suspend_after)
+            {
+                suspend_streak_ = 0;
+                suspend_processing_unit();
+            }
+        }
+        else
+        {
+            suspend_streak_ = 0;
+            resume_streak_ = 0;
+        }
+
+        ++decisions_;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool elastic_pool_controller::suspend_processing_unit()
+    {
+        // suspend the running worker thread with the highest index, this
+        // keeps the running worker threads packed on the first cores
+        std::size_t virt_core = idle_samples_.size();
+        while (virt_core != 0)
+        {
+            if (pool_.get_state(--virt_core) == hpx::state::running)
+            {
+                error_code ec(throwmode::lightweight);
+                pool_.suspend_processing_unit_direct(virt_core, ec);
+                if (ec)
+                {
+                    LTM_(warning).format("elastic_pool_controller: "
+                                         "suspending processing unit {} of "
+                                         "pool {} failed: {}",
+                        virt_core, pool_.get_pool_name(), ec.get_message());
+                    return false;
+                }
+
+                suspended_.push_back(virt_core);
+                ++num_suspended_;
+                ++suspensions_;
+
+                LTM_(info).format("elastic_pool_controller: suspended "
+                                  "processing unit {} of pool {}",
+                    virt_core, pool_.get_pool_name());
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool elastic_pool_controller::resume_processing_unit()
+    {
+        if (suspended_.empty())
+        {
+            return false;
+        }
+
+        std::size_t const virt_core = suspended_.back();
+        suspended_.pop_back();
+
+        error_code ec(throwmode::lightweight);
+        pool_.resume_processing_unit_direct(virt_core, ec);
+        if (ec)
+        {
+            LTM_(warning).format("elastic_pool_controller: resuming "
+                                 "processing unit {} of pool {} failed: {}",
+                virt_core, pool_.get_pool_name(), ec.get_message());
+        }
+        else
+        {
+            ++resumptions_;
+
+            LTM_(info).format("elastic_pool_controller: resumed processing "
+                              "unit {} of pool {}",
+                virt_core, pool_.get_pool_name());
+        }
+
+        --num_suspended_;
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t elastic_pool_controller::get_suspended_processing_units(
+        bool /*reset*/)
+    {
+        return num_suspended_.load(std::memory_order_relaxed);
+    }
+
+    std::int64_t elastic_pool_controller::get_suspension_count(bool reset)
+    {
+        return reset ? suspensions_.exchange(0, std::memory_order_relaxed) :
+                       suspensions_.load(std::memory_order_relaxed);
+    }
+
+    std::int64_t elastic_pool_controller::get_resumption_count(bool reset)
+    {
+        return reset ? resumptions_.exchange(0, std::memory_order_relaxed) :
+                       resumptions_.load(std::memory_order_relaxed);
+    }
+
+    std::int64_t elastic_pool_controller::get_decision_count(bool reset)
+    {
+        // synchronizes with the decision, its effects are visible afterwards
+        return reset ? decisions_.exchange(0, std::memory_order_acq_rel) :
+                       decisions_.load(std::memory_order_acquire);
+    }
+}}    // namespace hpx::threads
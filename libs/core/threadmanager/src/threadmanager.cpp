@@ -633,6 +633,16 @@ namespace hpx { namespace threads {
         return pool_index < pools_.size();
     }
 
+    elastic_pool_controller* threadmanager::get_elastic_controller(
+        std::size_t pool_index) const
+    {
+        if (pool_index >= elastic_controllers_.size())
+        {
+            return nullptr;
+        }
+        return elastic_controllers_[pool_index].get();
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     std::int64_t threadmanager::get_thread_count(thread_schedule_state state,
         thread_priority priority, std::size_t num_thread, bool reset)
@@ -1055,6 +1065,20 @@ namespace hpx { namespace threads {
                 sched->set_all_states(hpx::state::running);
         }
 
+        // start the elasticity controllers requested through the resource
+        // partitioner
+        elastic_controllers_.resize(pools_.size());
+        for (std::size_t i = 0; i != pools_.size(); ++i)
+        {
+            if (!elastic_controllers_[i] && rp.has_elasticity(i))
+            {
+                elastic_controllers_[i] =
+                    std::make_unique<elastic_pool_controller>(
+                        *pools_[i], rp.get_elasticity(i));
+            }
+        }
+        start_elastic_controllers();
+
         LTM_(info).format("run: running");
         return true;
     }
@@ -1063,6 +1087,10 @@ namespace hpx { namespace threads {
     {
         LTM_(info).format("stop: blocking({})", blocking ? "true" : "false");
 
+        // stopping the controllers resumes the processing units they have
+        // suspended, this must not be done while holding the lock
+        stop_elastic_controllers();
+
         std::unique_lock<mutex_type> lk(mtx_);
         for (auto& pool_iter : pools_)
         {
@@ -1071,6 +1099,28 @@ namespace hpx { namespace threads {
         deinit_tss();
     }
 
+    void threadmanager::start_elastic_controllers()
+    {
+        for (auto& controller : elastic_controllers_)
+        {
+            if (controller)
+            {
+                controller->start();
+            }
+        }
+    }
+
+    void threadmanager::stop_elastic_controllers()
+    {
+        for (auto& controller : elastic_controllers_)
+        {
+            if (controller)
+            {
+                controller->stop();
+            }
+        }
+    }
+
     bool threadmanager::is_busy()
     {
         bool busy = false;
@@ -1103,6 +1153,9 @@ namespace hpx { namespace threads {
     {
         wait();
 
+        // the controllers must not resume processing units of suspended pools
+        stop_elastic_controllers();
+
         if (threads::get_self_ptr())
         {
             std::vector<hpx::future<void>> fs;
@@ -1142,5 +1195,7 @@ namespace hpx { namespace threads {
                 pool_iter->resume_direct();
             }
         }
+
+        start_elastic_controllers();
     }
 }}    // namespace hpx::threads
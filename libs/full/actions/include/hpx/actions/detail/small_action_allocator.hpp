@@ -0,0 +1,243 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file small_action_allocator.hpp
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/thread_support/spinlock.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+namespace hpx { namespace actions { namespace detail {
+
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    // An action is considered to be 'small' if its arguments are stored
+    // inline in the transfer_action (i.e. they are default constructible) and
+    // if the argument pack does not exceed HPX_ACTIONS_SMALL_ARGUMENTS_SIZE
+    // bytes. The transfer_action instances for those actions are recycled
+    // through a thread-local free list instead of going through the global
+    // allocator for every received parcel.
+    template <typename Action>
+    struct is_small_action
+      : std::integral_constant<bool,
+            std::is_default_constructible<
+                typename Action::arguments_type>::value &&
+                sizeof(typename Action::arguments_type) <=
+                    HPX_ACTIONS_SMALL_ARGUMENTS_SIZE>
+    {
+    };
+
+    template <typename Action>
+    inline constexpr bool is_small_action_v = is_small_action<Action>::value;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Per-type, per-OS-thread cache of memory blocks of size sizeof(T). The
+    // cache holds at most HPX_ACTIONS_SMALL_OBJECT_CACHE_SIZE blocks. Actions
+    // are usually allocated on the thread decoding parcels but released on
+    // the worker threads executing them, so the caches fill unevenly. A full
+    // cache therefore hands half of its blocks over to a per-type shared
+    // pool, from which empty caches are refilled. The shared pool holds at
+    // most HPX_ACTIONS_SMALL_OBJECT_SHARED_CACHE_SIZE blocks, any excess
+    // memory is returned to the global allocator.
+    template <typename T>
+    struct small_action_allocator
+    {
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+            "small_action_allocator does not support over-aligned types");
+
+    private:
+        struct node
+        {
+            node* next;
+            node* next_batch;    // only used in the shared pool
+        };
+
+        static_assert(sizeof(T) >= sizeof(node),
+            "small_action_allocator requires sizeof(T) >= 2 * sizeof(void*)");
+
+        static_assert(HPX_ACTIONS_SMALL_OBJECT_CACHE_SIZE != 0,
+            "HPX_ACTIONS_SMALL_OBJECT_CACHE_SIZE must not be zero");
+
+        // number of blocks moved between a cache and the shared pool at once
+        static constexpr std::size_t batch_size =
+            (HPX_ACTIONS_SMALL_OBJECT_CACHE_SIZE + 1) / 2;
+
+        static void release(node* head) noexcept
+        {
+            while (head != nullptr)
+            {
+                node* n = head;
+                head = n->next;
+                ::operator delete(static_cast<void*>(n));
+            }
+        }
+
+        // Batches of batch_size blocks handed over between the caches of
+        // the OS-threads.
+        struct shared_pool
+        {
+            shared_pool() = default;
+
+            shared_pool(shared_pool const&) = delete;
+            shared_pool(shared_pool&&) = delete;
+            shared_pool& operator=(shared_pool const&) = delete;
+            shared_pool& operator=(shared_pool&&) = delete;
+
+            ~shared_pool()
+            {
+                while (batches_ != nullptr)
+                {
+                    node* batch = batches_;
+                    batches_ = batch->next_batch;
+                    release(batch);
+                }
+            }
+
+            // returns false if the pool is full
+            bool push(node* batch) noexcept
+            {
+                std::lock_guard<hpx::util::detail::spinlock> l(mtx_);
+                if (size_ + batch_size >
+                    HPX_ACTIONS_SMALL_OBJECT_SHARED_CACHE_SIZE)
+                {
+                    return false;
+                }
+
+                batch->next_batch = batches_;
+                batches_ = batch;
+                size_ += batch_size;
+                return true;
+            }
+
+            node* pop() noexcept
+            {
+                std::lock_guard<hpx::util::detail::spinlock> l(mtx_);
+                node* batch = batches_;
+                if (batch != nullptr)
+                {
+                    batches_ = batch->next_batch;
+                    size_ -= batch_size;
+                }
+                return batch;
+            }
+
+            hpx::util::detail::spinlock mtx_;
+            node* batches_ = nullptr;
+            std::size_t size_ = 0;
+        };
+
+        static shared_pool& get_shared_pool() noexcept
+        {
+            static shared_pool pool;
+            return pool;
+        }
+
+        struct free_list
+        {
+            free_list() = default;
+
+            free_list(free_list const&) = delete;
+            free_list(free_list&&) = delete;
+            free_list& operator=(free_list const&) = delete;
+            free_list& operator=(free_list&&) = delete;
+
+            ~free_list()
+            {
+                release(head_);
+                head_ = nullptr;
+                size_ = 0;
+
+                // make sure blocks released during thread shutdown after
+                // this point are handed back to the global allocator
+                destroyed_ = true;
+            }
+
+            node* head_ = nullptr;
+            std::size_t size_ = 0;
+            bool destroyed_ = false;
+        };
+
+        static free_list& get_free_list() noexcept
+        {
+            static thread_local free_list list;
+            return list;
+        }
+
+    public:
+        static void* allocate(std::size_t size)
+        {
+            HPX_ASSERT(size == sizeof(T));
+
+            free_list& list = get_free_list();
+            if (list.head_ == nullptr && !list.destroyed_)
+            {
+                // refill the cache from the shared pool
+                list.head_ = get_shared_pool().pop();
+                if (list.head_ != nullptr)
+                {
+                    list.size_ = batch_size;
+                }
+            }
+
+            if (list.head_ != nullptr)
+            {
+                node* n = list.head_;
+                list.head_ = n->next;
+                --list.size_;
+                return n;
+            }
+            return ::operator new(size);
+        }
+
+        static void deallocate(void* p) noexcept
+        {
+            if (p == nullptr)
+            {
+                return;
+            }
+
+            free_list& list = get_free_list();
+            if (list.destroyed_)
+            {
+                ::operator delete(p);
+                return;
+            }
+
+            if (list.size_ >= HPX_ACTIONS_SMALL_OBJECT_CACHE_SIZE)
+            {
+                // hand the first batch_size blocks over to the shared pool
+                node* batch = list.head_;
+                node* last = batch;
+                for (std::size_t i = 1; i != batch_size; ++i)
+                {
+                    last = last->next;
+                }
+                list.head_ = last->next;
+                list.size_ -= batch_size;
+                last->next = nullptr;
+
+                if (!get_shared_pool().push(batch))
+                {
+                    release(batch);
+                }
+            }
+
+            node* n = ::new (p) node{list.head_, nullptr};
+            list.head_ = n;
+            ++list.size_;
+        }
+    };
+
+    /// \endcond
+}}}    // namespace hpx::actions::detail
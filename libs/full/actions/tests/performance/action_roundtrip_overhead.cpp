@@ -0,0 +1,153 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the overhead of encoding, decoding, and scheduling
+// a parcel carrying an action with a small argument pack. No network is
+// involved, the parcel is serialized into a local buffer, deserialized from
+// there, and the embedded action is scheduled on the current locality.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+
+#include <hpx/iostream.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/modules/serialization.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/serialization/detail/preprocess_container.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::atomic<std::size_t> invocations(0);
+
+void small_function(std::int32_t, double)
+{
+    ++invocations;
+}
+HPX_PLAIN_ACTION(small_function, small_action)
+
+void small_direct_function(std::int32_t, double)
+{
+    ++invocations;
+}
+HPX_PLAIN_DIRECT_ACTION(small_direct_function, small_direct_action)
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Action>
+double benchmark_roundtrip(std::size_t iterations)
+{
+    hpx::id_type const here = hpx::find_here();
+
+    std::vector<char> out_buffer;
+    out_buffer.reserve(HPX_PARCEL_SERIALIZATION_OVERHEAD);
+
+    invocations.store(0);
+
+    hpx::chrono::high_resolution_timer t;
+
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        hpx::naming::address addr(hpx::get_locality(),
+            hpx::components::component_plain_function, nullptr);
+
+        hpx::naming::gid_type dest = here.get_gid();
+
+        hpx::parcelset::parcel outp(hpx::parcelset::detail::create_parcel::call(
+            std::move(dest), std::move(addr), Action(),
+            hpx::threads::thread_priority::normal, std::int32_t(i), 42.0));
+        outp.set_source_id(here);
+
+        std::size_t arg_size = 0;
+        {
+            // gather the required size for the archive
+            hpx::serialization::detail::preprocess_container gather_size;
+            hpx::serialization::output_archive archive(gather_size);
+            archive << outp;
+            arg_size = gather_size.size();
+        }
+
+        out_buffer.resize(arg_size + HPX_PARCEL_SERIALIZATION_OVERHEAD);
+
+        {
+            // create an output archive and serialize the parcel
+            hpx::serialization::output_archive archive(out_buffer);
+            archive << outp;
+            arg_size = archive.bytes_written();
+        }
+
+        hpx::parcelset::parcel inp;
+
+        {
+            // create an input archive and deserialize the parcel
+            hpx::serialization::input_archive archive(out_buffer, arg_size);
+            archive >> inp;
+        }
+
+        inp.schedule_action();
+    }
+
+    // wait for all scheduled actions to finish executing
+    hpx::util::yield_while([&]() { return invocations.load() != iterations; });
+
+    return t.elapsed();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    std::size_t const iterations = vm["iterations"].as<std::size_t>();
+    bool const print_header = vm.count("no-header") == 0;
+
+    double const elapsed = benchmark_roundtrip<small_action>(iterations);
+    double const elapsed_direct =
+        benchmark_roundtrip<small_direct_action>(iterations);
+
+    if (print_header)
+    {
+        hpx::cout << "action,testcount,average_time[us]\n" << std::flush;
+    }
+
+    hpx::util::format_to(hpx::cout, "small_action,{},{}\n", iterations,
+        1e6 * elapsed / iterations)
+        << std::flush;
+    hpx::util::format_to(hpx::cout, "small_direct_action,{},{}\n",
+        iterations, 1e6 * elapsed_direct / iterations)
+        << std::flush;
+
+    hpx::util::print_cdash_timing("ActionRoundtrip", elapsed);
+    hpx::util::print_cdash_timing("DirectActionRoundtrip", elapsed_direct);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    hpx::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("iterations",
+            hpx::program_options::value<std::size_t>()->default_value(100000),
+            "number of parcels to encode, decode, and schedule "
+            "(default: 100000)")
+        ("no-header", "do not print out the csv header row")
+        ;
+    // clang-format on
+
+    hpx::init_params init_args;
+    init_args.desc_cmdline = cmdline;
+
+    return hpx::init(argc, argv, init_args);
+}
+#endif
@@ -100,6 +100,7 @@ namespace hpx { namespace actions {
         symbol_namespace_unbind_action_id,
         symbol_namespace_iterate_action_id,
         symbol_namespace_on_event_action_id,
+        symbol_namespace_invalidate_action_id,
         symbol_namespace_statistics_counter_action_id,
         terminate_action_id,
         terminate_all_action_id,
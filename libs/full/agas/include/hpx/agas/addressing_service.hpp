@@ -25,6 +25,7 @@
 #include <hpx/synchronization/spinlock.hpp>
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <map>
@@ -79,13 +80,23 @@ namespace hpx { namespace agas {
         std::uint32_t console_cache_;
 
         std::size_t const max_refcnt_requests_;
+        std::chrono::milliseconds const max_refcnt_delay_;
 
         mutex_type refcnt_requests_mtx_;
         std::size_t refcnt_requests_count_;
         bool enable_refcnt_caching_;
+        bool refcnt_flush_scheduled_;
 
         std::shared_ptr<refcnt_requests_type> refcnt_requests_;
 
+        // number of decrements buffered since the last flush
+        std::int64_t refcnt_decrefs_pending_;
+
+        // statistics for the buffering of reference count requests
+        std::atomic<std::int64_t> refcnt_decref_requests_;
+        std::atomic<std::int64_t> refcnt_decref_parcels_;
+        std::atomic<std::int64_t> refcnt_parcels_saved_;
+
         service_mode const service_type;
         runtime_mode const runtime_type;
 
@@ -244,7 +255,17 @@ namespace hpx { namespace agas {
         void send_refcnt_requests_sync(
             std::unique_lock<mutex_type>& l, error_code& ec);
 
+        /// Flush the buffered reference count decrements once they have been
+        /// pending for max_refcnt_delay_.
+        void flush_refcnt_requests_delayed();
+
     public:
+        // Helper functions to access the statistics of the buffering of
+        // reference count requests
+        std::int64_t get_refcnt_decref_requests(bool reset);
+        std::int64_t get_refcnt_decref_parcels(bool reset);
+        std::int64_t get_refcnt_parcels_saved(bool reset);
+
         // Helper functions to access the current cache statistics
         std::uint64_t get_cache_entries(bool);
         std::uint64_t get_cache_hits(bool);
@@ -32,11 +32,14 @@
 #include <hpx/runtime_local/runtime_local_fwd.hpp>
 #include <hpx/serialization/serialize.hpp>
 #include <hpx/serialization/vector.hpp>
+#include <hpx/threading/thread.hpp>
 #include <hpx/thread_support/unlock_guard.hpp>
 #include <hpx/type_support/unused.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
 #include <hpx/util/get_entry_as.hpp>
 #include <hpx/util/insert_checked.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -122,9 +125,15 @@ namespace hpx { namespace agas {
       : gva_cache_(new gva_cache_type)
       , console_cache_(naming::invalid_locality_id)
       , max_refcnt_requests_(ini_.get_agas_max_pending_refcnt_requests())
+      , max_refcnt_delay_(ini_.get_agas_max_pending_refcnt_delay())
       , refcnt_requests_count_(0)
       , enable_refcnt_caching_(true)
+      , refcnt_flush_scheduled_(false)
       , refcnt_requests_(new refcnt_requests_type)
+      , refcnt_decrefs_pending_(0)
+      , refcnt_decref_requests_(0)
+      , refcnt_decref_parcels_(0)
+      , refcnt_parcels_saved_(0)
       , service_type(ini_.get_agas_service_mode())
       , runtime_type(ini_.mode_)
       , caching_(ini_.get_agas_caching_mode())
@@ -1329,10 +1338,12 @@ namespace hpx { namespace agas {
                     // credit == decref (case no. 3): if the incref offsets any
                     // pending decref, just remove the pending decref request.
                     refcnt_requests_->erase(matches);
+                    ++refcnt_parcels_saved_;
                 }
                 else
                 {
                     // credit < decref (case no. 2): do nothing
+                    ++refcnt_parcels_saved_;
                 }
             }
             else
@@ -1421,6 +1432,36 @@ namespace hpx { namespace agas {
                 }
             }
 
+            ++refcnt_decrefs_pending_;
+            ++refcnt_decref_requests_;
+
+            // make sure the buffered requests are sent even if no more
+            // decrefs arrive to fill the table
+            if (enable_refcnt_caching_ && !refcnt_flush_scheduled_ &&
+                max_refcnt_delay_.count() != 0 &&
+                refcnt_requests_count_ + 1 < max_refcnt_requests_)
+            {
+                refcnt_flush_scheduled_ = true;
+
+                threads::thread_init_data data(
+                    threads::make_thread_function_nullary(
+                        [HPX_CXX20_CAPTURE_THIS(=)]() -> void {
+                            return flush_refcnt_requests_delayed();
+                        }),
+                    "addressing_service::flush_refcnt_requests_delayed",
+                    threads::thread_priority::normal,
+                    threads::thread_schedule_hint(),
+                    threads::thread_stacksize::default_,
+                    threads::thread_schedule_state::pending, true);
+
+                error_code ec1(throwmode::lightweight);
+                threads::register_thread(data, ec1);
+                if (ec1)
+                {
+                    refcnt_flush_scheduled_ = false;
+                }
+            }
+
             send_refcnt_requests(l, ec);
         }
         catch (hpx::exception const& e)
@@ -1429,6 +1470,24 @@ namespace hpx { namespace agas {
         }
     }    // }}}
 
+    void addressing_service::flush_refcnt_requests_delayed()
+    {
+        hpx::this_thread::sleep_for(max_refcnt_delay_);
+
+        std::unique_lock<mutex_type> l(refcnt_requests_mtx_);
+        refcnt_flush_scheduled_ = false;
+
+        error_code ec(throwmode::lightweight);
+        send_refcnt_requests_non_blocking(l, ec);
+        if (ec)
+        {
+            LAGAS_(error).format(
+                "addressing_service::flush_refcnt_requests_delayed, "
+                "sending buffered decrefs failed: {1}",
+                ec.get_message());
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     static bool correct_credit_on_failure(future<bool> f, hpx::id_type id,
         std::int64_t mutable_gid_credit, std::int64_t new_gid_credit)
@@ -1562,15 +1621,28 @@ namespace hpx { namespace agas {
     future<hpx::id_type> addressing_service::on_symbol_namespace_event(
         std::string const& name, bool call_for_past_events)
     {
+        std::uint64_t generation = 0;
+        if (call_for_past_events)
+        {
+            // avoid creating the promise if the name is known already
+            hpx::id_type id;
+            if (symbol_ns_.get_cached(name, id))
+            {
+                return hpx::make_ready_future(HPX_MOVE(id));
+            }
+            generation = symbol_ns_.reserve_cache_entry(name);
+        }
+
         hpx::distributed::promise<hpx::id_type, naming::gid_type> p;
         auto result_f = p.get_future();
 
         hpx::future<bool> f =
             symbol_ns_.on_event(name, call_for_past_events, p.get_id());
 
-        return f.then(hpx::launch::sync,
-            util::one_shot(hpx::bind_back(
-                &detail::on_register_event, HPX_MOVE(result_f))));
+        return symbol_ns_.add_cache_entry(name, generation,
+            f.then(hpx::launch::sync,
+                util::one_shot(hpx::bind_back(
+                    &detail::on_register_event, HPX_MOVE(result_f)))));
     }
 
     // Return all matching entries in the symbol namespace
@@ -1813,6 +1885,24 @@ namespace hpx { namespace agas {
         send_refcnt_requests_sync(l, ec);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Helper functions to access the statistics of the buffering of reference
+    // count requests
+    std::int64_t addressing_service::get_refcnt_decref_requests(bool reset)
+    {
+        return util::get_and_reset_value(refcnt_decref_requests_, reset);
+    }
+
+    std::int64_t addressing_service::get_refcnt_decref_parcels(bool reset)
+    {
+        return util::get_and_reset_value(refcnt_decref_parcels_, reset);
+    }
+
+    std::int64_t addressing_service::get_refcnt_parcels_saved(bool reset)
+    {
+        return util::get_and_reset_value(refcnt_parcels_saved_, reset);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Helper functions to access the current cache statistics
     std::uint64_t addressing_service::get_cache_entries(bool /* reset */)
@@ -1990,6 +2080,9 @@ namespace hpx { namespace agas {
             p.swap(refcnt_requests_);
             refcnt_requests_count_ = 0;
 
+            std::int64_t const decrefs = refcnt_decrefs_pending_;
+            refcnt_decrefs_pending_ = 0;
+
             l.unlock();
 
             LAGAS_(info).format("addressing_service::send_refcnt_requests_non_"
@@ -2021,6 +2114,12 @@ namespace hpx { namespace agas {
                 requests[target].push_back(hpx::make_tuple(e.second, raw, raw));
             }
 
+            // one parcel is sent per locality for all of the buffered requests
+            std::int64_t const parcels =
+                static_cast<std::int64_t>(requests.size());
+            refcnt_decref_parcels_ += parcels;
+            refcnt_parcels_saved_ += decrefs - parcels;
+
             // send requests to all locality
             requests_type::iterator end = requests.end();
             for (requests_type::iterator it = requests.begin(); it != end; ++it)
@@ -2063,6 +2162,9 @@ namespace hpx { namespace agas {
         p.swap(refcnt_requests_);
         refcnt_requests_count_ = 0;
 
+        std::int64_t const decrefs = refcnt_decrefs_pending_;
+        refcnt_decrefs_pending_ = 0;
+
         l.unlock();
 
         LAGAS_(info).format(
@@ -2094,6 +2196,11 @@ namespace hpx { namespace agas {
             requests[target].push_back(hpx::make_tuple(e.second, raw, raw));
         }
 
+        // one parcel is sent per locality for all of the buffered requests
+        std::int64_t const parcels = static_cast<std::int64_t>(requests.size());
+        refcnt_decref_parcels_ += parcels;
+        refcnt_parcels_saved_ += decrefs - parcels;
+
         // send requests to all locality
         requests_type::iterator end = requests.end();
         for (requests_type::iterator it = requests.begin(); it != end; ++it)
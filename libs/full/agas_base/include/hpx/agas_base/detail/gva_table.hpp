@@ -0,0 +1,162 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/agas_base/gva.hpp>
+#include <hpx/naming_base/gid_type.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hpx::agas::detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The table of GVAs maintained by the primary namespace. Most bindings
+    // refer to a single GID, those are held in a hash table allowing for
+    // constant time lookup. Bindings covering a range of GIDs (created by
+    // bulk operations) are rare, those are held in a vector sorted by their
+    // first GID, which is searched using binary search.
+    //
+    // All GIDs passed to this table are expected to have their internal bits
+    // stripped.
+    class gva_table
+    {
+    public:
+        using data_type = std::pair<gva, naming::gid_type>;
+        using range_type = std::pair<naming::gid_type, data_type>;
+
+    private:
+        using single_table_type =
+            std::unordered_map<naming::gid_type, data_type>;
+        using range_table_type = std::vector<range_type>;
+
+        static constexpr bool is_range(data_type const& data) noexcept
+        {
+            return data.first.count > 1;
+        }
+
+        struct range_compare
+        {
+            bool operator()(
+                range_type const& lhs, naming::gid_type const& rhs) const
+            {
+                return lhs.first < rhs;
+            }
+            bool operator()(
+                naming::gid_type const& lhs, range_type const& rhs) const
+            {
+                return lhs < rhs.first;
+            }
+        };
+
+        range_table_type::iterator find_range_start(naming::gid_type const& id)
+        {
+            auto it = std::lower_bound(
+                ranges_.begin(), ranges_.end(), id, range_compare());
+            if (it != ranges_.end() && it->first == id)
+            {
+                return it;
+            }
+            return ranges_.end();
+        }
+
+    public:
+        // Return the binding starting at the given GID, if any
+        data_type* find(naming::gid_type const& id)
+        {
+            if (auto it = singles_.find(id); it != singles_.end())
+            {
+                return &it->second;
+            }
+
+            if (auto it = find_range_start(id); it != ranges_.end())
+            {
+                return &it->second;
+            }
+            return nullptr;
+        }
+
+        data_type const* find(naming::gid_type const& id) const
+        {
+            return const_cast<gva_table*>(this)->find(id);
+        }
+
+        // Return the binding for a range of GIDs starting before the given
+        // GID, if the range covers the GID
+        range_type const* find_range(naming::gid_type const& id) const
+        {
+            // find the last range starting before the given GID
+            auto it = std::lower_bound(
+                ranges_.begin(), ranges_.end(), id, range_compare());
+            if (it == ranges_.begin())
+            {
+                return nullptr;
+            }
+
+            --it;
+            if ((it->first + it->second.first.count) > id)
+            {
+                return &*it;
+            }
+            return nullptr;
+        }
+
+        // Add a new binding, return false if the given GID is bound already
+        bool insert(naming::gid_type const& id, data_type const& data)
+        {
+            if (!is_range(data))
+            {
+                return singles_.emplace(id, data).second;
+            }
+
+            auto it = std::lower_bound(
+                ranges_.begin(), ranges_.end(), id, range_compare());
+            if (it != ranges_.end() && it->first == id)
+            {
+                return false;
+            }
+
+            ranges_.emplace(it, id, data);
+            return true;
+        }
+
+        // Remove the binding starting at the given GID, return whether a
+        // binding was removed
+        bool erase(naming::gid_type const& id)
+        {
+            if (singles_.erase(id) != 0)
+            {
+                return true;
+            }
+
+            if (auto it = find_range_start(id); it != ranges_.end())
+            {
+                ranges_.erase(it);
+                return true;
+            }
+            return false;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return singles_.size() + ranges_.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return singles_.empty() && ranges_.empty();
+        }
+
+    private:
+        single_table_type singles_;
+        range_table_type ranges_;
+    };
+}    // namespace hpx::agas::detail
@@ -1,6 +1,6 @@
 ////////////////////////////////////////////////////////////////////////////////
 //  Copyright (c) 2011 Bryce Adelstein-Lelbach
-//  Copyright (c) 2012-2020 Hartmut Kaiser
+//  Copyright (c) 2012-2022 Hartmut Kaiser
 //  Copyright (c) 2016 Thomas Heller
 //
 //  SPDX-License-Identifier: BSL-1.0
@@ -14,6 +14,7 @@
 #include <hpx/actions/transfer_action.hpp>
 #include <hpx/actions_base/component_action.hpp>
 #include <hpx/agas_base/agas_fwd.hpp>
+#include <hpx/agas_base/detail/gva_table.hpp>
 #include <hpx/agas_base/gva.hpp>
 #include <hpx/allocator_support/internal_allocator.hpp>
 #include <hpx/async_distributed/base_lco_with_value.hpp>
@@ -119,8 +120,8 @@ namespace hpx::agas::server {
 
         using component_type = std::int32_t;
 
-        using gva_table_data_type = std::pair<gva, naming::gid_type>;
-        using gva_table_type = std::map<naming::gid_type, gva_table_data_type>;
+        using gva_table_type = detail::gva_table;
+        using gva_table_data_type = gva_table_type::data_type;
         using refcnt_table_type = std::map<naming::gid_type, std::int64_t>;
 
         using resolved_type =
@@ -1,5 +1,5 @@
 //  Copyright (c) 2011 Bryce Adelstein-Lelbach
-//  Copyright (c) 2012-2021 Hartmut Kaiser
+//  Copyright (c) 2012-2022 Hartmut Kaiser
 //  Copyright (c) 2016 Thomas Heller
 //
 //  SPDX-License-Identifier: BSL-1.0
@@ -17,14 +17,18 @@
 #include <hpx/components_base/component_type.hpp>
 #include <hpx/components_base/server/fixed_component_base.hpp>
 #include <hpx/functional/function.hpp>
+#include <hpx/modules/concurrency.hpp>
 #include <hpx/modules/errors.hpp>
 #include <hpx/naming_base/id_type.hpp>
 #include <hpx/synchronization/spinlock.hpp>
 
+#include <array>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -56,11 +60,49 @@ namespace hpx { namespace agas { namespace server {
 
         using on_event_data_map_type = std::multimap<std::string, hpx::id_type>;
 
+        // the localities which have cached the resolved names
+        using cached_by_map_type =
+            std::map<std::string, std::set<std::uint32_t>>;
+
+        // names owned by the instances on other localities which were
+        // resolved by this locality, the generation identifies the request
+        // which is allowed to fill an entry (an invalid id marks an entry
+        // for which a request is still in flight)
+        struct cache_entry
+        {
+            hpx::id_type id;
+            std::uint64_t generation;
+        };
+        using cache_type = std::map<std::string, cache_entry>;
+
     private:
-        mutex_type mutex_;
-        gid_table_type gids_;
+        // The names are distributed over several buckets based on their
+        // hash, each bucket is protected by its own lock.
+        struct bucket
+        {
+            mutex_type mutex_;
+            gid_table_type gids_;
+            on_event_data_map_type on_event_data_;
+            cached_by_map_type cached_by_;
+            cache_type cache_;
+        };
+
+        static constexpr std::size_t num_buckets = 16;
+
+        bucket& get_bucket(std::string const& key);
+
+        void invalidate_cached_names(
+            std::string const& key, std::set<std::uint32_t> const& localities);
+
+        std::array<util::cache_aligned_data_derived<bucket>, num_buckets>
+            buckets_;
         std::string instance_name_;
-        on_event_data_map_type on_event_data_;
+        std::atomic<std::uint64_t> cache_generation_{0};
+
+        // the cache is disabled (and emptied) once this instance has been
+        // unregistered, the cached ids hold credits which have to be
+        // returned while the parcel layer is still operational
+        std::atomic<bool> cache_enabled_{true};
 
     public:
         // data structure holding all counters for the omponent_namespace component
@@ -113,6 +155,13 @@ namespace hpx { namespace agas { namespace server {
 
             void enable_all();
 
+            // statistics of the cache of resolved names
+            std::int64_t get_cache_hits(bool);
+            std::int64_t get_cache_misses(bool);
+
+            std::atomic<std::int64_t> cache_hits_{0};
+            std::atomic<std::int64_t> cache_misses_{0};
+
             api_counter_data bind_;             // symbol_ns_bind
             api_counter_data resolve_;          // symbol_ns_resolve
             api_counter_data unbind_;           // symbol_ns_unbind
@@ -142,8 +191,12 @@ namespace hpx { namespace agas { namespace server {
 
         bool bind(std::string key, naming::gid_type gid);
 
-        naming::gid_type resolve(std::string const& key);
+        // The given locality (if valid) will be notified if the name is
+        // unbound (see invalidate)
+        naming::gid_type resolve(std::string const& key,
+            std::uint32_t cache_locality_id = naming::invalid_locality_id);
 
+        // Unbinding a name invalidates all copies cached by other localities
         naming::gid_type unbind(std::string const& key);
 
         iterate_names_return_type iterate(std::string const& pattern);
@@ -151,11 +204,23 @@ namespace hpx { namespace agas { namespace server {
         bool on_event(std::string const& name, bool call_for_past_events,
             hpx::id_type lco);
 
+        // Remove a name owned by another instance from the cache of resolved
+        // names of this instance
+        void invalidate(std::string const& key);
+
+        // access the cache of resolved names owned by other instances
+        void clear_cache();
+        bool get_cached(std::string const& key, hpx::id_type& id);
+        std::uint64_t reserve_cache_entry(std::string const& key);
+        void add_cache_entry(std::string const& key, std::uint64_t generation,
+            hpx::id_type const& id);
+
         HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, bind)
         HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, resolve)
         HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, unbind)
         HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, iterate)
         HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, on_event)
+        HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, invalidate)
     };
 
 }}}    // namespace hpx::agas::server
@@ -193,4 +258,8 @@ HPX_REGISTER_ACTION_DECLARATION(
     hpx::agas::server::symbol_namespace::on_event_action,
     symbol_namespace_on_event_action)
 
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::symbol_namespace::invalidate_action,
+    symbol_namespace_invalidate_action)
+
 #include <hpx/config/warnings_suffix.hpp>
@@ -52,6 +52,11 @@ namespace hpx { namespace agas {
 
         static hpx::id_type symbol_namespace_locality(std::string const& key);
 
+        // Return whether the given name (owned by the instance identified by
+        // dest) may be cached by this locality
+        static bool is_cacheable(
+            std::string const& key, hpx::id_type const& dest);
+
         symbol_namespace();
         ~symbol_namespace() = default;
 
@@ -71,6 +76,16 @@ namespace hpx { namespace agas {
         hpx::future<bool> on_event(std::string const& name,
             bool call_for_past_events, hpx::id_type lco);
 
+        // Names owned by other localities are cached after having been
+        // resolved, the cached entries are invalidated when the name is
+        // unbound. A request which may fill a cache entry has to reserve the
+        // entry before being sent, this allows to detect an invalidation of
+        // the entry while the request is in flight.
+        bool get_cached(std::string const& key, hpx::id_type& id) const;
+        std::uint64_t reserve_cache_entry(std::string const& key) const;
+        hpx::future<hpx::id_type> add_cache_entry(std::string key,
+            std::uint64_t generation, hpx::future<hpx::id_type> f) const;
+
         hpx::future<iterate_names_return_type> iterate_async(
             std::string const& pattern) const;
         iterate_names_return_type iterate(std::string const& pattern) const;
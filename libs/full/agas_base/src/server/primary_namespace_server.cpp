@@ -1,5 +1,5 @@
 //  Copyright (c) 2011 Bryce Adelstein-Lelbach
-//  Copyright (c) 2012-2021 Hartmut Kaiser
+//  Copyright (c) 2012-2022 Hartmut Kaiser
 //  Copyright (c) 2016 Thomas Heller
 //
 //  SPDX-License-Identifier: BSL-1.0
@@ -20,7 +20,6 @@
 #include <hpx/thread_support/assert_owns_lock.hpp>
 #include <hpx/timing/scoped_timer.hpp>
 #include <hpx/util/get_and_reset_value.hpp>
-#include <hpx/util/insert_checked.hpp>
 
 #include <atomic>
 #include <cstddef>
@@ -207,116 +206,86 @@ namespace hpx { namespace agas { namespace server {
 
         std::unique_lock<mutex_type> l(mutex_);
 
-        gva_table_type::iterator it = gvas_.lower_bound(id),
-                                 begin = gvas_.begin(), end = gvas_.end();
-
-        if (it != end)
+        // If we got an exact match, this is a request to update an existing
+        // binding (e.g. move semantics).
+        if (gva_table_data_type* data = gvas_.find(id))
         {
-            // If we got an exact match, this is a request to update an existing
-            // binding (e.g. move semantics).
-            if (it->first == id)
+            // non-migratable gids can't be rebound
+            if (naming::refers_to_local_lva(gid) &&
+                !naming::refers_to_virtual_memory(gid))
             {
-                // non-migratable gids can't be rebound
-                if (naming::refers_to_local_lva(gid) &&
-                    !naming::refers_to_virtual_memory(gid))
-                {
-                    l.unlock();
-
-                    HPX_THROW_EXCEPTION(bad_parameter,
-                        "primary_namespace::bind_gid",
-                        "cannot rebind gids for non-migratable objects");
-
-                    return false;
-                }
-
-                gva& gaddr = it->second.first;
-                naming::gid_type& loc = it->second.second;
+                l.unlock();
 
-                // Check for count mismatch (we can't change block sizes of
-                // existing bindings).
-                if (HPX_UNLIKELY(gaddr.count != g.count))
-                {
-                    // REVIEW: Is this the right error code to use?
-                    l.unlock();
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "primary_namespace::bind_gid",
+                    "cannot rebind gids for non-migratable objects");
 
-                    HPX_THROW_EXCEPTION(bad_parameter,
-                        "primary_namespace::bind_gid",
-                        "cannot change block size of existing binding");
-                }
+                return false;
+            }
 
-                if (HPX_UNLIKELY(components::component_invalid == g.type))
-                {
-                    l.unlock();
+            gva& gaddr = data->first;
+            naming::gid_type& loc = data->second;
 
-                    HPX_THROW_EXCEPTION(bad_parameter,
-                        "primary_namespace::bind_gid",
-                        "attempt to update a GVA with an invalid type, "
-                        "gid({1}), gva({2}), locality({3})",
-                        id, g, locality);
-                }
+            // Check for count mismatch (we can't change block sizes of
+            // existing bindings).
+            if (HPX_UNLIKELY(gaddr.count != g.count))
+            {
+                // REVIEW: Is this the right error code to use?
+                l.unlock();
 
-                if (HPX_UNLIKELY(!locality))
-                {
-                    l.unlock();
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "primary_namespace::bind_gid",
+                    "cannot change block size of existing binding");
+            }
 
-                    HPX_THROW_EXCEPTION(bad_parameter,
-                        "primary_namespace::bind_gid",
-                        "attempt to update a GVA with an invalid "
-                        "locality id, "
-                        "gid({1}), gva({2}), locality({3})",
-                        id, g, locality);
-                }
+            if (HPX_UNLIKELY(components::component_invalid == g.type))
+            {
+                l.unlock();
 
-                // Store the new endpoint and offset
-                gaddr.prefix = g.prefix;
-                gaddr.type = g.type;
-                gaddr.lva(g.lva());
-                gaddr.offset = g.offset;
-                loc = locality;
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "primary_namespace::bind_gid",
+                    "attempt to update a GVA with an invalid type, "
+                    "gid({1}), gva({2}), locality({3})",
+                    id, g, locality);
+            }
 
+            if (HPX_UNLIKELY(!locality))
+            {
                 l.unlock();
 
-                LAGAS_(info).format(
-                    "primary_namespace::bind_gid, gid({1}), gva({2}), "
-                    "locality({3}), response(repeated_request)",
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "primary_namespace::bind_gid",
+                    "attempt to update a GVA with an invalid "
+                    "locality id, "
+                    "gid({1}), gva({2}), locality({3})",
                     id, g, locality);
-
-                return false;
             }
 
-            // We're about to decrement the iterator it - first, we
-            // check that it's safe to do this.
-            else if (it != begin)
-            {
-                --it;
+            // Store the new endpoint and offset
+            gaddr.prefix = g.prefix;
+            gaddr.type = g.type;
+            gaddr.lva(g.lva());
+            gaddr.offset = g.offset;
+            loc = locality;
 
-                // Check that a previous range doesn't cover the new id.
-                if (HPX_UNLIKELY((it->first + it->second.first.count) > id))
-                {
-                    // REVIEW: Is this the right error code to use?
-                    l.unlock();
+            l.unlock();
 
-                    HPX_THROW_EXCEPTION(bad_parameter,
-                        "primary_namespace::bind_gid",
-                        "the new GID is contained in an existing range");
-                }
-            }
+            LAGAS_(info).format(
+                "primary_namespace::bind_gid, gid({1}), gva({2}), "
+                "locality({3}), response(repeated_request)",
+                id, g, locality);
+
+            return false;
         }
 
-        else if (HPX_LIKELY(!gvas_.empty()))
+        // Check that a previous range doesn't cover the new id.
+        if (HPX_UNLIKELY(gvas_.find_range(id) != nullptr))
         {
-            --it;
-
-            // Check that a previous range doesn't cover the new id.
-            if ((it->first + it->second.first.count) > id)
-            {
-                // REVIEW: Is this the right error code to use?
-                l.unlock();
+            // REVIEW: Is this the right error code to use?
+            l.unlock();
 
-                HPX_THROW_EXCEPTION(bad_parameter,
-                    "primary_namespace::bind_gid",
-                    "the new GID is contained in an existing range");
-            }
+            HPX_THROW_EXCEPTION(bad_parameter, "primary_namespace::bind_gid",
+                "the new GID is contained in an existing range");
         }
 
         // non-migratable gids don't need to be bound
@@ -353,8 +322,7 @@ namespace hpx { namespace agas { namespace server {
         }
 
         // Insert a GID -> GVA entry into the GVA table.
-        if (HPX_UNLIKELY(!util::insert_checked(
-                gvas_.insert(std::make_pair(id, std::make_pair(g, locality))))))
+        if (HPX_UNLIKELY(!gvas_.insert(id, std::make_pair(g, locality))))
         {
             l.unlock();
 
@@ -433,11 +401,9 @@ namespace hpx { namespace agas { namespace server {
 
         std::unique_lock<mutex_type> l(mutex_);
 
-        gva_table_type::iterator it = gvas_.find(id), end = gvas_.end();
-
-        if (it != end)
+        if (gva_table_data_type const* p = gvas_.find(id))
         {
-            if (HPX_UNLIKELY(it->second.first.count != count))
+            if (HPX_UNLIKELY(p->first.count != count))
             {
                 l.unlock();
 
@@ -445,9 +411,9 @@ namespace hpx { namespace agas { namespace server {
                     "primary_namespace::unbind_gid", "block sizes must match");
             }
 
-            gva_table_data_type data = it->second;
+            gva_table_data_type data = *p;
 
-            gvas_.erase(it);
+            gvas_.erase(id);
 
             l.unlock();
             LAGAS_(info).format(
@@ -1013,75 +979,34 @@ namespace hpx { namespace agas { namespace server {
         naming::gid_type id = gid;
         naming::detail::strip_internal_bits_from_gid(id);
 
-        gva_table_type::const_iterator it = gvas_.lower_bound(id),
-                                       begin = gvas_.begin(), end = gvas_.end();
-
-        if (it != end)
+        // Check for exact match
+        if (gva_table_data_type const* data = gvas_.find(id))
         {
-            // Check for exact match
-            if (it->first == id)
-            {
-                if (&ec != &throws)
-                    ec = make_success_code();
-
-                gva_table_data_type const& data = it->second;
-                return resolved_type(it->first, data.first, data.second);
-            }
-
-            // We need to decrement the iterator, first we check that it's safe
-            // to do this.
-            else if (it != begin)
-            {
-                --it;
+            if (&ec != &throws)
+                ec = make_success_code();
 
-                // Found the GID in a range
-                gva_table_data_type const& data = it->second;
-                if ((it->first + data.first.count) > id)
-                {
-                    if (HPX_UNLIKELY(id.get_msb() != it->first.get_msb()))
-                    {
-                        l.unlock();
-
-                        HPX_THROWS_IF(ec, internal_server_error,
-                            "primary_namespace::resolve_gid_locked",
-                            "MSBs of lower and upper range bound do not "
-                            "match");
-                        return resolved_type(
-                            naming::invalid_gid, gva(), naming::invalid_gid);
-                    }
-
-                    if (&ec != &throws)
-                        ec = make_success_code();
-
-                    return resolved_type(it->first, data.first, data.second);
-                }
-            }
+            return resolved_type(id, data->first, data->second);
         }
 
-        else if (HPX_LIKELY(!gvas_.empty()))
+        // Check whether the GID is contained in a range
+        if (auto const* range = gvas_.find_range(id))
         {
-            --it;
-
-            // Found the GID in a range
-            gva_table_data_type const& data = it->second;
-            if ((it->first + data.first.count) > id)
+            if (HPX_UNLIKELY(id.get_msb() != range->first.get_msb()))
             {
-                if (HPX_UNLIKELY(id.get_msb() != it->first.get_msb()))
-                {
-                    l.unlock();
+                l.unlock();
 
-                    HPX_THROWS_IF(ec, internal_server_error,
-                        "primary_namespace::resolve_gid_locked",
-                        "MSBs of lower and upper range bound do not match");
-                    return resolved_type(
-                        naming::invalid_gid, gva(), naming::invalid_gid);
-                }
+                HPX_THROWS_IF(ec, internal_server_error,
+                    "primary_namespace::resolve_gid_locked",
+                    "MSBs of lower and upper range bound do not match");
+                return resolved_type(
+                    naming::invalid_gid, gva(), naming::invalid_gid);
+            }
 
-                if (&ec != &throws)
-                    ec = make_success_code();
+            if (&ec != &throws)
+                ec = make_success_code();
 
-                return resolved_type(it->first, data.first, data.second);
-            }
+            gva_table_data_type const& data = range->second;
+            return resolved_type(range->first, data.first, data.second);
         }
 
         if (&ec != &throws)
@@ -1,5 +1,5 @@
 //  Copyright (c) 2011 Bryce Adelstein-Lelbach
-//  Copyright (c) 2012-2021 Hartmut Kaiser
+//  Copyright (c) 2012-2022 Hartmut Kaiser
 //  Copyright (c) 2016 Thomas Heller
 //
 //  SPDX-License-Identifier: BSL-1.0
@@ -9,14 +9,18 @@
 #include <hpx/config.hpp>
 #include <hpx/agas_base/server/symbol_namespace.hpp>
 #include <hpx/assert.hpp>
+#include <hpx/async_combinators/when_all.hpp>
 #include <hpx/async_distributed/applier/apply.hpp>
+#include <hpx/async_distributed/async.hpp>
 #include <hpx/async_distributed/base_lco_with_value.hpp>
+#include <hpx/components_base/agas_interface.hpp>
 #include <hpx/functional/bind_back.hpp>
 #include <hpx/functional/bind_front.hpp>
 #include <hpx/modules/errors.hpp>
 #include <hpx/modules/format.hpp>
 #include <hpx/naming/credit_handling.hpp>
 #include <hpx/naming/split_gid.hpp>
+#include <hpx/runtime_local/runtime_local_fwd.hpp>
 #include <hpx/thread_support/unlock_guard.hpp>
 #include <hpx/timing/scoped_timer.hpp>
 #include <hpx/type_support/unused.hpp>
@@ -25,12 +29,15 @@
 #include <hpx/util/regex_from_pattern.hpp>
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <regex>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -51,6 +58,9 @@ namespace hpx { namespace agas {
 
 namespace hpx { namespace agas { namespace server {
 
+    // maximal time to wait for another locality to invalidate a cached name
+    constexpr std::chrono::seconds invalidate_timeout(5);
+
     void symbol_namespace::register_server_instance(
         char const* servicename, std::uint32_t locality_id, error_code& ec)
     {
@@ -74,6 +84,11 @@ namespace hpx { namespace agas { namespace server {
     void symbol_namespace::unregister_server_instance(error_code& ec)
     {
         agas::unregister_name(launch::sync, instance_name_, ec);
+
+        // release the credits held by the cached names while the parcel
+        // layer is still running
+        clear_cache();
+
         this->base_type::finalize();
     }
 
@@ -86,6 +101,12 @@ namespace hpx { namespace agas { namespace server {
         }
     }
 
+    symbol_namespace::bucket& symbol_namespace::get_bucket(
+        std::string const& key)
+    {
+        return buckets_[std::hash<std::string>()(key) % num_buckets];
+    }
+
     bool symbol_namespace::bind(std::string key, naming::gid_type gid)
     {    // {{{ bind implementation
         // parameters
@@ -93,10 +114,11 @@ namespace hpx { namespace agas { namespace server {
             counter_data_.bind_.time_, counter_data_.bind_.enabled_);
         counter_data_.increment_bind_count();
 
-        std::unique_lock<mutex_type> l(mutex_);
+        bucket& b = get_bucket(key);
+        std::unique_lock<mutex_type> l(b.mutex_);
 
-        gid_table_type::iterator it = gids_.find(key);
-        gid_table_type::iterator end = gids_.end();
+        gid_table_type::iterator it = b.gids_.find(key);
+        gid_table_type::iterator end = b.gids_.end();
 
         if (it != end)
         {
@@ -139,7 +161,7 @@ namespace hpx { namespace agas { namespace server {
             return false;
         }
 
-        if (HPX_UNLIKELY(!util::insert_checked(gids_.insert(
+        if (HPX_UNLIKELY(!util::insert_checked(b.gids_.insert(
                 std::make_pair(key, std::make_shared<naming::gid_type>(gid))))))
         {
             l.unlock();
@@ -151,19 +173,28 @@ namespace hpx { namespace agas { namespace server {
 
         // handle registered events
         typedef on_event_data_map_type::iterator iterator;
-        std::pair<iterator, iterator> p = on_event_data_.equal_range(key);
+        std::pair<iterator, iterator> p = b.on_event_data_.equal_range(key);
 
         std::vector<hpx::id_type> lcos;
         if (p.first != p.second)
         {
             iterator it = p.first;
+            std::uint32_t const here = agas::get_locality_id();
             while (it != p.second)
             {
+                // the notified localities may cache the name
+                std::uint32_t const locality_id =
+                    naming::get_locality_id_from_id((*it).second);
+                if (locality_id != here)
+                {
+                    b.cached_by_[key].insert(locality_id);
+                }
+
                 lcos.push_back((*it).second);
                 ++it;
             }
 
-            on_event_data_.erase(p.first, p.second);
+            b.on_event_data_.erase(p.first, p.second);
 
             // notify all LCOS which were registered with this name
             for (hpx::id_type const& id : lcos)
@@ -171,8 +202,8 @@ namespace hpx { namespace agas { namespace server {
                 // re-locate the entry in the GID table for each LCO anew, as we
                 // need to unlock the mutex protecting the table for each iteration
                 // below
-                gid_table_type::iterator gid_it = gids_.find(key);
-                if (gid_it == gids_.end())
+                gid_table_type::iterator gid_it = b.gids_.find(key);
+                if (gid_it == b.gids_.end())
                 {
                     l.unlock();
 
@@ -211,17 +242,19 @@ namespace hpx { namespace agas { namespace server {
         return true;
     }    // }}}
 
-    naming::gid_type symbol_namespace::resolve(std::string const& key)
+    naming::gid_type symbol_namespace::resolve(
+        std::string const& key, std::uint32_t cache_locality_id)
     {    // {{{ resolve implementation
         // parameters
         util::scoped_timer<std::atomic<std::int64_t>> update(
             counter_data_.resolve_.time_, counter_data_.resolve_.enabled_);
         counter_data_.increment_resolve_count();
 
-        std::unique_lock<mutex_type> l(mutex_);
+        bucket& b = get_bucket(key);
+        std::unique_lock<mutex_type> l(b.mutex_);
 
-        gid_table_type::iterator it = gids_.find(key);
-        gid_table_type::iterator end = gids_.end();
+        gid_table_type::iterator it = b.gids_.find(key);
+        gid_table_type::iterator end = b.gids_.end();
 
         if (it == end)
         {
@@ -232,6 +265,12 @@ namespace hpx { namespace agas { namespace server {
             return naming::invalid_gid;
         }
 
+        // remember the locality which is going to cache the name
+        if (cache_locality_id != naming::invalid_locality_id)
+        {
+            b.cached_by_[key].insert(cache_locality_id);
+        }
+
         // hold on to gid before unlocking the map
         std::shared_ptr<naming::gid_type> current_gid(it->second);
 
@@ -253,10 +292,11 @@ namespace hpx { namespace agas { namespace server {
             counter_data_.unbind_.time_, counter_data_.unbind_.enabled_);
         counter_data_.increment_unbind_count();
 
-        std::unique_lock<mutex_type> l(mutex_);
+        bucket& b = get_bucket(key);
+        std::unique_lock<mutex_type> l(b.mutex_);
 
-        gid_table_type::iterator it = gids_.find(key);
-        gid_table_type::iterator end = gids_.end();
+        gid_table_type::iterator it = b.gids_.find(key);
+        gid_table_type::iterator end = b.gids_.end();
 
         if (it == end)
         {
@@ -269,10 +309,24 @@ namespace hpx { namespace agas { namespace server {
 
         naming::gid_type const gid = *(it->second);
 
-        gids_.erase(it);
+        b.gids_.erase(it);
+
+        std::set<std::uint32_t> cached_by;
+        cached_by_map_type::iterator cit = b.cached_by_.find(key);
+        if (cit != b.cached_by_.end())
+        {
+            cached_by = HPX_MOVE(cit->second);
+            b.cached_by_.erase(cit);
+        }
 
         l.unlock();
 
+        // make sure that no other locality keeps using the name
+        if (!cached_by.empty())
+        {
+            invalidate_cached_names(key, cached_by);
+        }
+
         LAGAS_(info).format(
             "symbol_namespace::unbind, key({1}), gid({2})", key, gid);
 
@@ -295,36 +349,42 @@ namespace hpx { namespace agas { namespace server {
             std::string str_rx(util::regex_from_pattern(pattern, throws));
             std::regex rx(str_rx);
 
-            std::unique_lock<mutex_type> l(mutex_);
-            for (gid_table_type::iterator it = gids_.begin(); it != gids_.end();
-                 ++it)
+            for (bucket& b : buckets_)
             {
-                if (!std::regex_match(it->first, rx))
-                    continue;
+                std::unique_lock<mutex_type> l(b.mutex_);
+                for (gid_table_type::iterator it = b.gids_.begin();
+                     it != b.gids_.end(); ++it)
+                {
+                    if (!std::regex_match(it->first, rx))
+                        continue;
 
-                // hold on to entry while map is unlocked
-                std::shared_ptr<naming::gid_type> current_gid(it->second);
-                util::unlock_guard<std::unique_lock<mutex_type>> ul(l);
+                    // hold on to entry while map is unlocked
+                    std::shared_ptr<naming::gid_type> current_gid(it->second);
+                    util::unlock_guard<std::unique_lock<mutex_type>> ul(l);
 
-                found[it->first] =
-                    naming::detail::split_gid_if_needed(*current_gid).get();
+                    found[it->first] =
+                        naming::detail::split_gid_if_needed(*current_gid).get();
+                }
             }
         }
         else
         {
-            std::unique_lock<mutex_type> l(mutex_);
-            for (gid_table_type::iterator it = gids_.begin(); it != gids_.end();
-                 ++it)
+            for (bucket& b : buckets_)
             {
-                if (!pattern.empty() && pattern != it->first)
-                    continue;
+                std::unique_lock<mutex_type> l(b.mutex_);
+                for (gid_table_type::iterator it = b.gids_.begin();
+                     it != b.gids_.end(); ++it)
+                {
+                    if (!pattern.empty() && pattern != it->first)
+                        continue;
 
-                // hold on to entry while map is unlocked
-                std::shared_ptr<naming::gid_type> current_gid(it->second);
-                util::unlock_guard<std::unique_lock<mutex_type>> ul(l);
+                    // hold on to entry while map is unlocked
+                    std::shared_ptr<naming::gid_type> current_gid(it->second);
+                    util::unlock_guard<std::unique_lock<mutex_type>> ul(l);
 
-                found[it->first] =
-                    naming::detail::split_gid_if_needed(*current_gid).get();
+                    found[it->first] =
+                        naming::detail::split_gid_if_needed(*current_gid).get();
+                }
             }
         }
 
@@ -340,16 +400,25 @@ namespace hpx { namespace agas { namespace server {
             counter_data_.on_event_.time_, counter_data_.on_event_.enabled_);
         counter_data_.increment_on_event_count();
 
-        std::unique_lock<mutex_type> l(mutex_);
+        bucket& b = get_bucket(name);
+        std::unique_lock<mutex_type> l(b.mutex_);
 
         bool handled = false;
         naming::gid_type new_gid;
 
         if (call_for_past_events)
         {
-            gid_table_type::iterator it = gids_.find(name);
-            if (it != gids_.end())
+            gid_table_type::iterator it = b.gids_.find(name);
+            if (it != b.gids_.end())
             {
+                // the notified locality may cache the name
+                std::uint32_t const locality_id =
+                    naming::get_locality_id_from_id(lco);
+                if (locality_id != agas::get_locality_id())
+                {
+                    b.cached_by_[name].insert(locality_id);
+                }
+
                 // hold on to entry while map is unlocked
                 std::shared_ptr<naming::gid_type> current_gid(it->second);
 
@@ -376,12 +445,12 @@ namespace hpx { namespace agas { namespace server {
 
         if (!handled)
         {
-            on_event_data_map_type::iterator it = on_event_data_.insert(
+            on_event_data_map_type::iterator it = b.on_event_data_.insert(
                 on_event_data_map_type::value_type(name, lco));
 
             // This overload of insert always returns the iterator pointing
             // to the inserted value. It should never point to end
-            HPX_ASSERT(it != on_event_data_.end());
+            HPX_ASSERT(it != b.on_event_data_.end());
             HPX_UNUSED(it);
         }
         l.unlock();
@@ -391,6 +460,148 @@ namespace hpx { namespace agas { namespace server {
         return true;
     }    // }}}
 
+    void symbol_namespace::invalidate_cached_names(
+        std::string const& key, std::set<std::uint32_t> const& localities)
+    {
+        std::uint32_t const here = agas::get_locality_id();
+
+        std::vector<hpx::future<void>> invalidated;
+        invalidated.reserve(localities.size());
+        for (std::uint32_t locality_id : localities)
+        {
+            if (locality_id == here)
+            {
+                invalidate(key);
+                continue;
+            }
+
+            hpx::id_type target(
+                naming::replace_locality_id(
+                    bootstrap_symbol_namespace_gid(), locality_id),
+                hpx::id_type::management_type::unmanaged);
+            invalidated.push_back(
+                hpx::async(invalidate_action(), HPX_MOVE(target), key));
+        }
+
+        // the other localities might have exited already while shutting
+        // down, their caches are being cleared anyways
+        if (hpx::is_stopped_or_shutting_down())
+        {
+            return;
+        }
+
+        // wait for all localities to have removed the name from their cache,
+        // failures are ignored as the target locality might have exited; all
+        // localities share the same deadline, so unresponsive localities
+        // don't add up
+        hpx::future<std::vector<hpx::future<void>>> all =
+            hpx::when_all(HPX_MOVE(invalidated));
+        if (all.wait_for(invalidate_timeout) == hpx::future_status::timeout)
+        {
+            LAGAS_(warning).format(
+                "symbol_namespace::invalidate_cached_names, timed out "
+                "waiting for the cached name to be invalidated, key({1})",
+                key);
+        }
+    }
+
+    void symbol_namespace::invalidate(std::string const& key)
+    {
+        bucket& b = get_bucket(key);
+
+        // the cached id is released without holding the lock
+        hpx::id_type id;
+        {
+            std::lock_guard<mutex_type> l(b.mutex_);
+            cache_type::iterator it = b.cache_.find(key);
+            if (it != b.cache_.end())
+            {
+                id = HPX_MOVE(it->second.id);
+                b.cache_.erase(it);
+            }
+        }
+
+        LAGAS_(info).format("symbol_namespace::invalidate, key({1})", key);
+    }
+
+    void symbol_namespace::clear_cache()
+    {
+        cache_enabled_.store(false);
+
+        for (bucket& b : buckets_)
+        {
+            cache_type cache;
+            {
+                std::lock_guard<mutex_type> l(b.mutex_);
+                cache.swap(b.cache_);
+            }
+
+            // the cached ids are released without holding the lock
+        }
+    }
+
+    bool symbol_namespace::get_cached(
+        std::string const& key, hpx::id_type& id)
+    {
+        bucket& b = get_bucket(key);
+
+        std::lock_guard<mutex_type> l(b.mutex_);
+        cache_type::iterator it = b.cache_.find(key);
+        if (it == b.cache_.end() || !it->second.id)
+        {
+            ++counter_data_.cache_misses_;
+            return false;    // not cached or request still in flight
+        }
+
+        ++counter_data_.cache_hits_;
+        id = it->second.id;
+        return true;
+    }
+
+    std::uint64_t symbol_namespace::reserve_cache_entry(std::string const& key)
+    {
+        std::uint64_t const generation = ++cache_generation_;
+
+        bucket& b = get_bucket(key);
+
+        std::lock_guard<mutex_type> l(b.mutex_);
+        if (!cache_enabled_.load(std::memory_order_relaxed))
+        {
+            return 0;    // don't cache anything anymore
+        }
+
+        cache_entry& entry = b.cache_[key];
+        if (!entry.id)
+        {
+            // the most recent request fills the entry
+            entry.generation = generation;
+        }
+        return generation;
+    }
+
+    void symbol_namespace::add_cache_entry(std::string const& key,
+        std::uint64_t generation, hpx::id_type const& id)
+    {
+        bucket& b = get_bucket(key);
+
+        std::lock_guard<mutex_type> l(b.mutex_);
+
+        // the entry has been invalidated while the request was in flight if
+        // it doesn't exist anymore or if it has been reserved again
+        cache_type::iterator it = b.cache_.find(key);
+        if (it != b.cache_.end() && it->second.generation == generation)
+        {
+            if (id)
+            {
+                it->second.id = id;
+            }
+            else if (!it->second.id)
+            {
+                b.cache_.erase(it);    // the name is not bound
+            }
+        }
+    }
+
     // access current counter values
     std::int64_t symbol_namespace::counter_data::get_bind_count(bool reset)
     {
@@ -427,6 +638,16 @@ namespace hpx { namespace agas { namespace server {
             util::get_and_reset_value(on_event_.count_, reset);
     }
 
+    std::int64_t symbol_namespace::counter_data::get_cache_hits(bool reset)
+    {
+        return util::get_and_reset_value(cache_hits_, reset);
+    }
+
+    std::int64_t symbol_namespace::counter_data::get_cache_misses(bool reset)
+    {
+        return util::get_and_reset_value(cache_misses_, reset);
+    }
+
     void symbol_namespace::counter_data::enable_all()
     {
         bind_.enabled_ = true;
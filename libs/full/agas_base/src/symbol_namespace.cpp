@@ -51,6 +51,10 @@ HPX_REGISTER_ACTION_ID(symbol_namespace::on_event_action,
     symbol_namespace_on_event_action,
     hpx::actions::symbol_namespace_on_event_action_id)
 
+HPX_REGISTER_ACTION_ID(symbol_namespace::invalidate_action,
+    symbol_namespace_invalidate_action,
+    hpx::actions::symbol_namespace_invalidate_action_id)
+
 namespace hpx { namespace agas {
 
     naming::gid_type symbol_namespace::get_service_instance(
@@ -98,6 +102,16 @@ namespace hpx { namespace agas {
             hpx::id_type::management_type::unmanaged);
     }
 
+    bool symbol_namespace::is_cacheable(
+        std::string const& key, hpx::id_type const& dest)
+    {
+        // keys starting with '/0/' are used by AGAS itself, names bound on
+        // this locality are not cached
+        return (key.size() < 3 || key[0] != '/' || key[1] != '0' ||
+                   key[2] != '/') &&
+            naming::get_locality_id_from_id(dest) != agas::get_locality_id();
+    }
+
     symbol_namespace::symbol_namespace()
       : server_(new server::symbol_namespace())
     {
@@ -166,6 +180,29 @@ namespace hpx { namespace agas {
     {
         hpx::id_type dest = symbol_namespace_locality(key);
 
+        if (is_cacheable(key, dest))
+        {
+            hpx::id_type id;
+            if (server_->get_cached(key, id))
+            {
+                return hpx::make_ready_future(HPX_MOVE(id));
+            }
+
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+            // the reservation has to be made before the request is sent to
+            // detect an invalidation of the entry while the request is in
+            // flight
+            std::uint64_t const generation =
+                server_->reserve_cache_entry(key);
+
+            server::symbol_namespace::resolve_action action;
+            hpx::future<hpx::id_type> f = hpx::async(
+                action, HPX_MOVE(dest), key, agas::get_locality_id());
+
+            return add_cache_entry(HPX_MOVE(key), generation, HPX_MOVE(f));
+#endif
+        }
+
         if (naming::get_locality_id_from_id(dest) == agas::get_locality_id())
         {
             naming::gid_type raw_gid = server_->resolve(HPX_MOVE(key));
@@ -179,7 +216,8 @@ namespace hpx { namespace agas {
         }
 #if !defined(HPX_COMPUTE_DEVICE_CODE)
         server::symbol_namespace::resolve_action action;
-        return hpx::async(action, HPX_MOVE(dest), HPX_MOVE(key));
+        return hpx::async(action, HPX_MOVE(dest), HPX_MOVE(key),
+            naming::invalid_locality_id);
 #else
         HPX_ASSERT(false);
         return hpx::make_ready_future(hpx::id_type{});
@@ -195,6 +233,10 @@ namespace hpx { namespace agas {
     {
         hpx::id_type dest = symbol_namespace_locality(key);
 
+        // the owning instance invalidates the cached entries on all other
+        // localities
+        server_->invalidate(key);
+
         if (naming::get_locality_id_from_id(dest) == agas::get_locality_id())
         {
             naming::gid_type raw_gid = server_->unbind(HPX_MOVE(key));
@@ -220,6 +262,51 @@ namespace hpx { namespace agas {
         return unbind_async(HPX_MOVE(key)).get();
     }
 
+    bool symbol_namespace::get_cached(
+        std::string const& key, hpx::id_type& id) const
+    {
+        if (!is_cacheable(key, symbol_namespace_locality(key)))
+        {
+            return false;
+        }
+        return server_->get_cached(key, id);
+    }
+
+    std::uint64_t symbol_namespace::reserve_cache_entry(
+        std::string const& key) const
+    {
+        if (!is_cacheable(key, symbol_namespace_locality(key)))
+        {
+            return 0;
+        }
+        return server_->reserve_cache_entry(key);
+    }
+
+    hpx::future<hpx::id_type> symbol_namespace::add_cache_entry(
+        std::string key, std::uint64_t generation,
+        hpx::future<hpx::id_type> f) const
+    {
+        if (generation == 0)
+        {
+            return f;
+        }
+
+        return f.then(hpx::launch::sync,
+            [server = server_.get(), key = HPX_MOVE(key), generation](
+                hpx::future<hpx::id_type>&& f) -> hpx::id_type {
+                if (f.has_exception())
+                {
+                    // release the reserved entry
+                    server->add_cache_entry(key, generation, hpx::invalid_id);
+                    return f.get();
+                }
+
+                hpx::id_type id = f.get();
+                server->add_cache_entry(key, generation, id);
+                return id;
+            });
+    }
+
     hpx::future<bool> symbol_namespace::on_event(
         std::string const& name, bool call_for_past_events, hpx::id_type lco)
     {
@@ -0,0 +1,242 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compare the GVA table used by the primary namespace with a std::map based
+// table which resolves GIDs using lower_bound.
+
+#include <hpx/config.hpp>
+#include <hpx/agas_base/detail/gva_table.hpp>
+#include <hpx/agas_base/gva.hpp>
+#include <hpx/local/chrono.hpp>
+#include <hpx/local/init.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/naming_base/gid_type.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using data_type = hpx::agas::detail::gva_table::data_type;
+
+// every range_stride'th binding covers range_size GIDs
+constexpr std::size_t range_stride = 100;
+constexpr std::uint64_t range_size = 16;
+
+struct map_table
+{
+    bool insert(hpx::naming::gid_type const& id, data_type const& data)
+    {
+        return table_.emplace(id, data).second;
+    }
+
+    hpx::naming::gid_type resolve(hpx::naming::gid_type const& id) const
+    {
+        auto it = table_.lower_bound(id);
+        if (it != table_.end() && it->first == id)
+        {
+            return it->first;
+        }
+
+        if (it != table_.begin())
+        {
+            --it;
+            if ((it->first + it->second.first.count) > id)
+            {
+                return it->first;
+            }
+        }
+        return hpx::naming::invalid_gid;
+    }
+
+    bool erase(hpx::naming::gid_type const& id)
+    {
+        return table_.erase(id) != 0;
+    }
+
+    std::map<hpx::naming::gid_type, data_type> table_;
+};
+
+struct hashed_table
+{
+    bool insert(hpx::naming::gid_type const& id, data_type const& data)
+    {
+        return table_.insert(id, data);
+    }
+
+    hpx::naming::gid_type resolve(hpx::naming::gid_type const& id) const
+    {
+        if (table_.find(id) != nullptr)
+        {
+            return id;
+        }
+
+        if (auto const* range = table_.find_range(id))
+        {
+            return range->first;
+        }
+        return hpx::naming::invalid_gid;
+    }
+
+    bool erase(hpx::naming::gid_type const& id)
+    {
+        return table_.erase(id);
+    }
+
+    hpx::agas::detail::gva_table table_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+struct timings
+{
+    double insert;
+    double resolve;
+    double erase;
+};
+
+using binding_type = std::pair<hpx::naming::gid_type, std::uint64_t>;
+
+template <typename Table>
+timings measure(std::vector<binding_type> const& bindings,
+    std::vector<hpx::naming::gid_type> const& lookups)
+{
+    Table table;
+    timings result{};
+
+    hpx::naming::gid_type const locality(
+        0x0000000100000000ull, std::uint64_t(0));
+
+    std::uint64_t start = hpx::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i != bindings.size(); ++i)
+    {
+        hpx::agas::gva g(locality, 1, bindings[i].second, i);
+        HPX_TEST(table.insert(bindings[i].first, data_type(g, locality)));
+    }
+    result.insert =
+        static_cast<double>(hpx::chrono::high_resolution_clock::now() - start);
+
+    std::size_t found = 0;
+    start = hpx::chrono::high_resolution_clock::now();
+    for (hpx::naming::gid_type const& id : lookups)
+    {
+        if (table.resolve(id) != hpx::naming::invalid_gid)
+        {
+            ++found;
+        }
+    }
+    result.resolve =
+        static_cast<double>(hpx::chrono::high_resolution_clock::now() - start);
+    HPX_TEST_EQ(found, lookups.size());
+
+    start = hpx::chrono::high_resolution_clock::now();
+    for (binding_type const& binding : bindings)
+    {
+        HPX_TEST(table.erase(binding.first));
+    }
+    result.erase =
+        static_cast<double>(hpx::chrono::high_resolution_clock::now() - start);
+
+    return result;
+}
+
+void print(char const* name, timings const& t, std::size_t entries,
+    std::size_t lookups)
+{
+    std::cout << std::left << std::setw(10) << name << std::right
+              << "insert: " << std::setw(8) << t.insert / entries
+              << " ns, resolve: " << std::setw(8) << t.resolve / lookups
+              << " ns, erase: " << std::setw(8) << t.erase / entries
+              << " ns\n";
+}
+
+void run(std::size_t entries, std::size_t lookups, unsigned int seed)
+{
+    // GIDs are handed out sequentially, bulk creation binds a range
+    std::vector<binding_type> bindings;
+    bindings.reserve(entries);
+
+    hpx::naming::gid_type next(0x0000000100000001ull, 1);
+    for (std::size_t i = 0; i != entries; ++i)
+    {
+        std::uint64_t const count = (i % range_stride) == 0 ? range_size : 1;
+        bindings.emplace_back(next, count);
+        next += count;
+    }
+
+    // resolve random GIDs, including GIDs inside of ranges
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<std::size_t> dist(0, entries - 1);
+
+    std::vector<hpx::naming::gid_type> lookup_ids;
+    lookup_ids.reserve(lookups);
+    for (std::size_t i = 0; i != lookups; ++i)
+    {
+        binding_type const& binding = bindings[dist(gen)];
+        lookup_ids.push_back(binding.first + (i % binding.second));
+    }
+
+    // bindings are not created in the order of their GIDs
+    std::shuffle(bindings.begin(), bindings.end(), gen);
+
+    std::cout << "entries: " << entries << ", lookups: " << lookups << "\n";
+    print("std::map", measure<map_table>(bindings, lookup_ids), entries,
+        lookups);
+    print("gva_table", measure<hashed_table>(bindings, lookup_ids), entries,
+        lookups);
+}
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    unsigned int const seed = vm["seed"].as<unsigned int>();
+    std::size_t const lookups = vm["lookups"].as<std::size_t>();
+
+    if (vm.count("entries"))
+    {
+        run(vm["entries"].as<std::size_t>(), lookups, seed);
+    }
+    else
+    {
+        run(1000000, lookups, seed);
+        run(10000000, lookups, seed);
+    }
+
+    return hpx::local::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {"hpx.os_threads=1"};
+
+    using namespace hpx::program_options;
+
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("entries", value<std::size_t>(),
+            "number of bindings in the table (default: 1000000 and 10000000)")
+        ("lookups", value<std::size_t>()->default_value(10000000),
+            "number of GIDs to resolve")
+        ("seed", value<unsigned int>()->default_value(0),
+            "the random number generator seed to use")
+        ;
+    // clang-format on
+
+    hpx::local::init_params init_args;
+    init_args.desc_cmdline = cmdline;
+    init_args.cfg = cfg;
+
+    HPX_TEST_EQ(hpx::local::init(hpx_main, argc, argv, init_args), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,166 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify the lookup of GIDs at the edges of ranges bound in the GVA table
+// used by the primary namespace.
+
+#include <hpx/config.hpp>
+#include <hpx/agas_base/detail/gva_table.hpp>
+#include <hpx/agas_base/gva.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/naming_base/gid_type.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+using hpx::agas::detail::gva_table;
+using hpx::naming::gid_type;
+
+///////////////////////////////////////////////////////////////////////////////
+gid_type const locality(0x0000000100000000ull, std::uint64_t(0));
+
+gva_table::data_type make_data(std::uint64_t count)
+{
+    return gva_table::data_type(
+        hpx::agas::gva(locality, 1, count, std::uint64_t(0x1000)), locality);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_range_edges()
+{
+    gid_type const first(0x0000000100000001ull, 100);
+    std::uint64_t const count = 16;
+    gid_type const last = first + (count - 1);
+    gid_type const past_end = first + count;
+
+    gva_table table;
+    HPX_TEST(table.insert(first, make_data(count)));
+    HPX_TEST_EQ(table.size(), std::size_t(1));
+
+    // the first GID of a range is found directly, not through find_range
+    HPX_TEST(table.find(first) != nullptr);
+    HPX_TEST(table.find_range(first) == nullptr);
+
+    // the last GID of the range resolves to the range
+    HPX_TEST(table.find(last) == nullptr);
+    gva_table::range_type const* range = table.find_range(last);
+    HPX_TEST(range != nullptr);
+    if (range != nullptr)
+    {
+        HPX_TEST_EQ(range->first, first);
+        HPX_TEST_EQ(range->second.first.count, count);
+    }
+
+    // the GID just past the end of the range is not bound
+    HPX_TEST(table.find(past_end) == nullptr);
+    HPX_TEST(table.find_range(past_end) == nullptr);
+
+    // the GID just before the start of the range is not bound
+    HPX_TEST(table.find(first - gid_type(0, 1)) == nullptr);
+    HPX_TEST(table.find_range(first - gid_type(0, 1)) == nullptr);
+
+    // a range can't be bound twice
+    HPX_TEST(!table.insert(first, make_data(count)));
+    HPX_TEST_EQ(table.size(), std::size_t(1));
+
+    // GIDs inside of a range can't be erased, only its first GID
+    HPX_TEST(!table.erase(last));
+    HPX_TEST(!table.erase(past_end));
+    HPX_TEST(table.erase(first));
+    HPX_TEST(table.empty());
+
+    HPX_TEST(table.find(first) == nullptr);
+    HPX_TEST(table.find_range(last) == nullptr);
+    HPX_TEST(!table.erase(first));
+}
+
+void test_range_after_single()
+{
+    gid_type const single(0x0000000100000001ull, 100);
+    gid_type const first = single + 1;
+    std::uint64_t const count = 8;
+    gid_type const last = first + (count - 1);
+    gid_type const past_end = first + count;
+
+    gva_table table;
+    HPX_TEST(table.insert(single, make_data(1)));
+    HPX_TEST(table.insert(first, make_data(count)));
+    HPX_TEST_EQ(table.size(), std::size_t(2));
+
+    // the single binding is not covered by the range following it
+    HPX_TEST(table.find(single) != nullptr);
+    HPX_TEST(table.find_range(single) == nullptr);
+
+    HPX_TEST(table.find(first) != nullptr);
+    HPX_TEST(table.find_range(first + 1) != nullptr);
+    HPX_TEST(table.find_range(last) != nullptr);
+    HPX_TEST(table.find_range(past_end) == nullptr);
+
+    // a single binding at the GID just past the end of the range
+    HPX_TEST(table.insert(past_end, make_data(1)));
+    HPX_TEST(table.find(past_end) != nullptr);
+    HPX_TEST(table.find_range(past_end) == nullptr);
+
+    // erasing the single binding leaves the range intact
+    HPX_TEST(table.erase(single));
+    HPX_TEST(table.find(single) == nullptr);
+    HPX_TEST(table.find(first) != nullptr);
+    HPX_TEST(table.find_range(last) != nullptr);
+
+    HPX_TEST(table.erase(first));
+    HPX_TEST(table.find_range(last) == nullptr);
+    HPX_TEST(table.find(past_end) != nullptr);
+
+    HPX_TEST(table.erase(past_end));
+    HPX_TEST(table.empty());
+}
+
+void test_adjacent_ranges()
+{
+    gid_type const first(0x0000000100000001ull, 100);
+    std::uint64_t const count = 4;
+    gid_type const second = first + count;
+
+    gva_table table;
+
+    // insert out of order to exercise the sorted insertion
+    HPX_TEST(table.insert(second, make_data(count)));
+    HPX_TEST(table.insert(first, make_data(count)));
+
+    gva_table::range_type const* range = table.find_range(first + (count - 1));
+    HPX_TEST(range != nullptr);
+    if (range != nullptr)
+    {
+        HPX_TEST_EQ(range->first, first);
+    }
+
+    // the first GID of the second range belongs to the second range only
+    HPX_TEST(table.find(second) != nullptr);
+    HPX_TEST(table.find_range(second) == nullptr);
+
+    range = table.find_range(second + (count - 1));
+    HPX_TEST(range != nullptr);
+    if (range != nullptr)
+    {
+        HPX_TEST_EQ(range->first, second);
+    }
+    HPX_TEST(table.find_range(second + count) == nullptr);
+
+    HPX_TEST(table.erase(first));
+    HPX_TEST(table.find_range(first + 1) == nullptr);
+    HPX_TEST(table.find_range(second + 1) != nullptr);
+    HPX_TEST(table.erase(second));
+    HPX_TEST(table.empty());
+}
+
+int main()
+{
+    test_range_edges();
+    test_range_after_single();
+    test_adjacent_ranges();
+
+    return hpx::util::report_errors();
+}
@@ -14,6 +14,7 @@
 
 #include <hpx/actions/apply_helper.hpp>
 #include <hpx/actions/base_action.hpp>
+#include <hpx/actions/detail/small_action_allocator.hpp>
 #include <hpx/actions/register_action.hpp>
 #include <hpx/actions/transfer_base_action.hpp>
 #include <hpx/actions_base/actions_base_support.hpp>
@@ -71,6 +72,11 @@ namespace hpx { namespace actions {
         transfer_continuation_action(threads::thread_priority priority,
             continuation_type&& cont, Ts&&... vs);
 
+        // instances of small actions are recycled through a thread-local
+        // cache, see detail::small_action_allocator
+        static void* operator new(std::size_t size);
+        static void operator delete(void* p) noexcept;
+
         bool has_continuation() const override;
 
         /// The \a get_thread_function constructs a proper thread function for
@@ -143,6 +149,35 @@ namespace hpx { namespace actions {
     {
     }
 
+    template <typename Action>
+    void* transfer_continuation_action<Action>::operator new(std::size_t size)
+    {
+        if constexpr (detail::is_small_action_v<Action>)
+        {
+            return detail::small_action_allocator<
+                transfer_continuation_action>::allocate(size);
+        }
+        else
+        {
+            return ::operator new(size);
+        }
+    }
+
+    template <typename Action>
+    void transfer_continuation_action<Action>::operator delete(
+        void* p) noexcept
+    {
+        if constexpr (detail::is_small_action_v<Action>)
+        {
+            detail::small_action_allocator<
+                transfer_continuation_action>::deallocate(p);
+        }
+        else
+        {
+            ::operator delete(p);
+        }
+    }
+
     template <typename Action>
     bool transfer_continuation_action<Action>::has_continuation() const
     {
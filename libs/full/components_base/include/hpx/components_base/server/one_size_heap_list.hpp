@@ -1,4 +1,4 @@
-//  Copyright (c) 1998-2017 Hartmut Kaiser
+//  Copyright (c) 1998-2022 Hartmut Kaiser
 //  Copyright (c)      2011 Bryce Lelbach
 //
 //  SPDX-License-Identifier: BSL-1.0
@@ -10,8 +10,10 @@
 #include <hpx/config.hpp>
 #include <hpx/assert.hpp>
 #include <hpx/components_base/server/wrapper_heap_base.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
 #include <hpx/synchronization/spinlock.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <list>
 #include <memory>
@@ -58,6 +60,7 @@ namespace hpx { namespace util {
 #endif
           , create_heap_(nullptr)
           , parameters_({0, 0, 0})
+          , num_magazines_(0)
         {
             HPX_ASSERT(false);    // shouldn't ever be called
         }
@@ -74,6 +77,7 @@ namespace hpx { namespace util {
 #endif
           , create_heap_(&one_size_heap_list::create_heap<Heap>)
           , parameters_(parameters)
+          , num_magazines_(0)
         {
         }
 
@@ -89,6 +93,7 @@ namespace hpx { namespace util {
 #endif
           , create_heap_(&one_size_heap_list::create_heap<Heap>)
           , parameters_(parameters)
+          , num_magazines_(0)
         {
         }
 
@@ -111,6 +116,29 @@ namespace hpx { namespace util {
         list_type heap_list_;
 
     private:
+        // Allocate up to count consecutive elements, count is updated to
+        // reflect the number of actually allocated elements.
+        void* alloc_batch(std::size_t& count);
+
+        // Give back elements allocated by alloc_batch which were never handed
+        // out.
+        void return_batch(void* p, std::size_t count) noexcept;
+
+        // Single elements requested by a worker thread are carved out of a
+        // per-worker magazine of consecutive elements that is refilled from
+        // the heaps in batches of HPX_COMPONENTS_HEAP_MAGAZINE_SIZE elements.
+        // The global ids of the elements are still assigned based on the heap
+        // they belong to.
+        struct magazine
+        {
+            mutex_type mtx_;
+            char* next_ = nullptr;
+            char* end_ = nullptr;
+        };
+
+        void* alloc_from_magazine(std::size_t num_thread);
+        std::size_t init_magazines();
+
         std::string const class_name_;
 
     public:
@@ -124,6 +152,10 @@ namespace hpx { namespace util {
             char const*, std::size_t, heap_parameters);
 
         heap_parameters const parameters_;
+
+    private:
+        std::unique_ptr<util::cache_aligned_data<magazine>[]> magazines_;
+        std::atomic<std::size_t> num_magazines_;
     };
 }}    // namespace hpx::util
 
@@ -26,6 +26,15 @@ namespace hpx { namespace util {
         virtual ~wrapper_heap_base() = default;
 
         virtual bool alloc(void** result, std::size_t count = 1) = 0;
+
+        // allocate up to 'count' consecutive elements, 'count' is updated to
+        // reflect the number of actually allocated elements
+        virtual bool alloc_batch(void** result, std::size_t& count) = 0;
+
+        // give back elements allocated by alloc_batch which were never handed
+        // out
+        virtual void return_batch(void* p, std::size_t count) = 0;
+
         virtual bool did_alloc(void* p) const = 0;
         virtual void free(void* p, std::size_t count = 1) = 0;
 
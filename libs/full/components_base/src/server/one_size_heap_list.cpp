@@ -1,4 +1,4 @@
-//  Copyright (c) 1998-2021 Hartmut Kaiser
+//  Copyright (c) 1998-2022 Hartmut Kaiser
 //  Copyright (c)      2011 Bryce Lelbach
 //
 //  SPDX-License-Identifier: BSL-1.0
@@ -12,6 +12,8 @@
 #include <hpx/functional/bind_front.hpp>
 #include <hpx/modules/errors.hpp>
 #include <hpx/modules/format.hpp>
+#include <hpx/runtime_local/get_os_thread_count.hpp>
+#include <hpx/runtime_local/get_worker_thread_num.hpp>
 #include <hpx/runtime_local/state.hpp>
 #include <hpx/thread_support/unlock_guard.hpp>
 #include <hpx/threading_base/register_thread.hpp>
@@ -20,6 +22,8 @@
 #include <hpx/modules/logging.hpp>
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <list>
 #include <memory>
@@ -30,6 +34,26 @@ namespace hpx { namespace util {
 
     one_size_heap_list::~one_size_heap_list() noexcept
     {
+        // give the elements still held by the magazines back to their heaps,
+        // otherwise the heaps would consider those to be leaked. This is
+        // skipped if the runtime is not running anymore (as in free()), as
+        // releasing a heap requires AGAS to unbind its GIDs.
+        if (threads::threadmanager_is(hpx::state::running))
+        {
+            std::size_t const num_magazines =
+                num_magazines_.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i != num_magazines; ++i)
+            {
+                magazine& m = magazines_[i].data_;
+                if (m.next_ != m.end_)
+                {
+                    return_batch(m.next_,
+                        (m.end_ - m.next_) / parameters_.element_size);
+                    m.next_ = m.end_ = nullptr;
+                }
+            }
+        }
+
 #if defined(HPX_DEBUG)
         LOSH_(info).format(
             "{1}::~{1}: size({2}), max_count({3}), alloc_count({4}), "
@@ -47,15 +71,25 @@ namespace hpx { namespace util {
 
     void* one_size_heap_list::alloc(std::size_t count)
     {
-        std::unique_lock guard(mtx_);
-
         if (HPX_UNLIKELY(0 == count))
         {
-            guard.unlock();
             HPX_THROW_EXCEPTION(
                 bad_parameter, name() + "::alloc", "cannot allocate 0 objects");
         }
 
+        // single elements requested from a worker thread are served from the
+        // magazine of that worker, without acquiring the lock on the list
+        if (count == 1)
+        {
+            std::size_t const num_thread = hpx::get_worker_thread_num();
+            if (num_thread != std::size_t(-1))
+            {
+                return alloc_from_magazine(num_thread);
+            }
+        }
+
+        std::unique_lock guard(mtx_);
+
         void* p = nullptr;
         {
             if (!heap_list_.empty())
@@ -142,6 +176,162 @@ namespace hpx { namespace util {
         return alloc(count);
     }
 
+    void* one_size_heap_list::alloc_batch(std::size_t& count)
+    {
+        std::unique_lock guard(mtx_);
+
+        std::size_t const requested = count;
+        void* p = nullptr;
+
+        for (auto& heap : heap_list_)
+        {
+            bool allocated = false;
+
+            {
+                util::unlock_guard ul(guard);
+                count = requested;
+                allocated = heap->alloc_batch(&p, count);
+            }
+
+            if (allocated)
+            {
+#if defined(HPX_DEBUG)
+                // Allocation succeeded, update statistics.
+                alloc_count_ += count;
+                if (alloc_count_ - free_count_ > max_alloc_count_)
+                    max_alloc_count_ = alloc_count_ - free_count_;
+#endif
+                return p;
+            }
+        }
+
+        // Create new heap.
+#if defined(HPX_DEBUG)
+        heap_list_.push_front(
+            create_heap_(class_name_.c_str(), heap_count_ + 1, parameters_));
+#else
+        heap_list_.push_front(
+            create_heap_(class_name_.c_str(), 0, parameters_));
+#endif
+
+        typename list_type::value_type heap = heap_list_.front();
+        bool result = false;
+
+        {
+            util::unlock_guard ul(guard);
+            count = requested;
+            result = heap->alloc_batch(&p, count);
+        }
+
+        if (HPX_UNLIKELY(!result || nullptr == p))
+        {
+            // out of memory
+            guard.unlock();
+            HPX_THROW_EXCEPTION(out_of_memory, name() + "::alloc_batch",
+                "new heap failed to allocate {1} objects", requested);
+        }
+
+#if defined(HPX_DEBUG)
+        alloc_count_ += count;
+        ++heap_count_;
+
+        LOSH_(info).format(
+            "{1}::alloc_batch: creating new heap[{2}], size is now {3}",
+            name(), heap_count_, heap_list_.size());
+#endif
+        return p;
+    }
+
+    std::size_t one_size_heap_list::init_magazines()
+    {
+        std::lock_guard guard(mtx_);
+
+        std::size_t num_magazines =
+            num_magazines_.load(std::memory_order_relaxed);
+        if (num_magazines == 0)
+        {
+            num_magazines = (std::max)(
+                hpx::get_os_thread_count(), static_cast<std::size_t>(1));
+            magazines_.reset(
+                new util::cache_aligned_data<magazine>[num_magazines]);
+            num_magazines_.store(num_magazines, std::memory_order_release);
+        }
+        return num_magazines;
+    }
+
+    void* one_size_heap_list::alloc_from_magazine(std::size_t num_thread)
+    {
+        std::size_t num_magazines =
+            num_magazines_.load(std::memory_order_acquire);
+        if (num_magazines == 0)
+        {
+            num_magazines = init_magazines();
+        }
+
+        std::size_t const element_size = parameters_.element_size;
+        if (num_thread >= num_magazines)
+        {
+            std::size_t count = 1;
+            return alloc_batch(count);
+        }
+
+        magazine& m = magazines_[num_thread].data_;
+        {
+            std::lock_guard l(m.mtx_);
+            if (m.next_ != m.end_)
+            {
+                void* p = m.next_;
+                m.next_ += element_size;
+                return p;
+            }
+        }
+
+        // refill the magazine, the lock on the magazine is not held as the
+        // current HPX thread might be suspended while allocating a new heap
+        std::size_t count = HPX_COMPONENTS_HEAP_MAGAZINE_SIZE;
+        char* p = static_cast<char*>(alloc_batch(count));
+
+        {
+            std::lock_guard l(m.mtx_);
+            if (m.next_ == m.end_)
+            {
+                m.next_ = p + element_size;
+                m.end_ = p + count * element_size;
+                return p;
+            }
+        }
+
+        // another HPX thread running on the same worker has refilled the
+        // magazine in the meantime, give back the superfluous elements
+        if (count > 1)
+        {
+            return_batch(p + element_size, count - 1);
+        }
+        return p;
+    }
+
+    void one_size_heap_list::return_batch(void* p, std::size_t count) noexcept
+    {
+        std::unique_lock ul(mtx_);
+
+        for (auto& heap : heap_list_)
+        {
+            if (heap->did_alloc(p))
+            {
+#if defined(HPX_DEBUG)
+                alloc_count_ -= count;
+#endif
+                typename list_type::value_type h = heap;
+                ul.unlock();
+
+                h->return_batch(p, count);
+                return;
+            }
+        }
+
+        HPX_ASSERT_MSG(false, "the returned elements belong to no heap");
+    }
+
     bool one_size_heap_list::reschedule(void* p, std::size_t count)
     {
         if (nullptr == threads::get_self_ptr())
@@ -170,25 +360,20 @@ namespace hpx { namespace util {
 
         std::unique_lock ul(mtx_);
 
-        // Find the heap which allocated this pointer.
+        // Find the heap which allocated this pointer. Checking whether a
+        // heap owns a pointer does not acquire any locks, so there is no need
+        // to release the lock on the list while searching.
         for (auto& heap : heap_list_)
         {
-            bool did_allocate = false;
-
-            {
-                util::unlock_guard ull(ul);
-                did_allocate = heap->did_alloc(p);
-                if (did_allocate)
-                {
-                    heap->free(p, count);
-                }
-            }
-
-            if (did_allocate)
+            if (heap->did_alloc(p))
             {
 #if defined(HPX_DEBUG)
                 free_count_ += count;
 #endif
+                typename list_type::value_type h = heap;
+                ul.unlock();
+
+                h->free(p, count);
                 return;
             }
         }
@@ -1,4 +1,4 @@
-//  Copyright (c) 1998-2021 Hartmut Kaiser
+//  Copyright (c) 1998-2022 Hartmut Kaiser
 //  Copyright (c)      2011 Bryce Lelbach
 //
 //  SPDX-License-Identifier: BSL-1.0
@@ -188,6 +188,84 @@ namespace hpx { namespace components { namespace detail {
         return true;
     }
 
+    bool wrapper_heap::alloc_batch(void** result, std::size_t& count)
+    {
+        util::itt::heap_allocate heap_allocate(heap_alloc_function_, result,
+            count * parameters_.element_size,
+            HPX_WRAPPER_HEAP_INITIALIZED_MEMORY);
+
+        std::unique_lock l(mtx_);
+
+        // a released pool is never initialized again, the heap list will
+        // create a new heap instead (see ensure_pool)
+        if (nullptr == pool_)
+            return false;
+
+        // limit the number of elements to what is left in this heap
+        std::size_t const total_num_bytes =
+            parameters_.capacity * parameters_.element_size;
+        std::size_t const available =
+            (pool_ + total_num_bytes - first_free_) / parameters_.element_size;
+        if (available == 0)
+            return false;
+
+        if (count > available)
+            count = available;
+
+#if defined(HPX_DEBUG)
+        alloc_count_ += count;
+#endif
+
+        void* p = first_free_;
+        HPX_ASSERT(p != nullptr);
+
+        first_free_ = first_free_ + count * parameters_.element_size;
+
+        HPX_ASSERT(free_size_ >= count);
+        free_size_ -= count;
+
+#if HPX_DEBUG_WRAPPER_HEAP != 0
+        // init memory blocks
+        debug::fill_bytes(p, initial_value, count * parameters_.element_size);
+#endif
+
+        *result = p;
+        return true;
+    }
+
+    void wrapper_heap::return_batch(void* p, std::size_t count)
+    {
+        util::itt::heap_free heap_free(heap_free_function_, p);
+
+        std::unique_lock l(mtx_);
+
+        HPX_ASSERT(did_alloc(p));
+        HPX_ASSERT(free_size_ + count <= parameters_.capacity);
+
+        // the elements can be allocated again if they are the last ones that
+        // were handed out by this heap
+        char* p1 = static_cast<char*>(p);
+        if (p1 + count * parameters_.element_size == first_free_)
+        {
+            first_free_ = p1;
+        }
+#if HPX_DEBUG_WRAPPER_HEAP != 0
+        else
+        {
+            debug::fill_bytes(
+                p1, freed_value, count * parameters_.element_size);
+        }
+#endif
+
+#if defined(HPX_DEBUG)
+        alloc_count_ -= count;
+#endif
+        free_size_ += count;
+
+        // release the pool if these were the last allocated items
+        test_release(l);
+    }
+
     void wrapper_heap::free(void* p, std::size_t count)
     {
         util::itt::heap_free heap_free(heap_free_function_, p);
@@ -228,7 +306,9 @@ namespace hpx { namespace components { namespace detail {
 
     bool wrapper_heap::did_alloc(void* p) const
     {
-        // no lock is necessary here as all involved variables are immutable
+        // no lock is necessary here as pool_ is set only once, when the heap
+        // is created, and is reset only when the heap is released after all
+        // of its elements have been freed (a released heap is never reused)
         util::itt::heap_internal_access hia;
         HPX_UNUSED(hia);
         if (nullptr == pool_)
@@ -1,4 +1,4 @@
-//  Copyright (c) 2007-2021 Hartmut Kaiser
+//  Copyright (c) 2007-2022 Hartmut Kaiser
 //  Copyright (c)      2017 Shoshana Jakobovits
 //  Copyright (c) 2010-2011 Phillip LeBlanc, Dylan Stark
 //  Copyright (c)      2011 Bryce Lelbach
@@ -1041,6 +1041,11 @@ namespace hpx {
     ///////////////////////////////////////////////////////////////////////////
     void terminate()
     {
+#if defined(HPX_HAVE_LOGGING)
+        // write out the log records collected so far
+        util::logging::try_flush_async_logging();
+#endif
+
         if (!threads::get_self_ptr())
         {
             // hpx::terminate shouldn't be called from a non-HPX thread
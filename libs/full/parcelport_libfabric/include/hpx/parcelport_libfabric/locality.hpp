@@ -13,8 +13,10 @@
 #include <hpx/parcelset_base/locality.hpp>
 //
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <rdma/fabric.h>
 #include <utility>
 
@@ -151,6 +153,11 @@ namespace hpx { namespace parcelset { namespace policies { namespace libfabric {
             return (ip_address() != 0);
         }
 
+        std::size_t hash() const
+        {
+            return std::hash<uint32_t>()(ip_address());
+        }
+
         void save(serialization::output_archive& ar) const
         {
             ar << data_;
@@ -1,4 +1,4 @@
-//  Copyright (c) 2007-2021 Hartmut Kaiser
+//  Copyright (c) 2007-2022 Hartmut Kaiser
 //  Copyright (c) 2013-2014 Thomas Heller
 //
 //  SPDX-License-Identifier: BSL-1.0
@@ -12,7 +12,9 @@
 #if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_MPI)
 #include <hpx/modules/serialization.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 
 namespace hpx::parcelset::policies::mpi {
 
@@ -44,6 +46,11 @@ namespace hpx::parcelset::policies::mpi {
             return rank_ != -1;
         }
 
+        std::size_t hash() const noexcept
+        {
+            return std::hash<std::int32_t>()(rank_);
+        }
+
         HPX_EXPORT void save(serialization::output_archive& ar) const;
         HPX_EXPORT void load(serialization::input_archive& ar);
 
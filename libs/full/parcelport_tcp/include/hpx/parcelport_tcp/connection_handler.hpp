@@ -15,13 +15,16 @@
 #if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_TCP)
 #include <hpx/parcelport_tcp/locality.hpp>
 #include <hpx/parcelport_tcp/sender.hpp>
+#include <hpx/parcelport_tcp/striped_transfers.hpp>
 #include <hpx/parcelset/parcelport_impl.hpp>
 #include <hpx/parcelset_base/locality.hpp>
 
 #include <asio/ip/host_name.hpp>
 #include <asio/ip/tcp.hpp>
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <string>
@@ -105,6 +108,19 @@ namespace hpx::parcelset {
 
             parcelset::locality create_locality() const;
 
+            // Return a new identifier for a striped message sent by this
+            // locality
+            std::uint64_t next_transfer_id() noexcept
+            {
+                return ++next_transfer_id_;
+            }
+
+            // Access the rendezvous of incoming striped messages
+            striped_transfers& get_striped_transfers() noexcept
+            {
+                return striped_transfers_;
+            }
+
         private:
             void handle_accept(std::error_code const& e,
                 std::shared_ptr<receiver> receiver_conn);
@@ -125,6 +141,16 @@ namespace hpx::parcelset {
             using write_connections_set = std::set<std::weak_ptr<sender>>;
             write_connections_set write_connections_;
 #endif
+
+            // Zero-copy chunks of at least stripe_threshold_ bytes are sent
+            // in up to stripe_count_ stripes over separate connections
+            std::size_t stripe_threshold_;
+            std::size_t stripe_count_;
+
+            // incoming striped messages waiting for their stripes
+            striped_transfers striped_transfers_;
+
+            std::atomic<std::uint64_t> next_transfer_id_;
         };
     }    // namespace policies::tcp
 }    // namespace hpx::parcelset
@@ -1,4 +1,4 @@
-//  Copyright (c) 2007-2021 Hartmut Kaiser
+//  Copyright (c) 2007-2022 Hartmut Kaiser
 //  Copyright (c) 2014 Thomas Heller
 //  Copyright (c) 2007 Richard D Guidry Jr
 //  Copyright (c) 2011 Bryce Lelbach
@@ -15,7 +15,9 @@
 #if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_TCP)
 #include <hpx/modules/serialization.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
 
 namespace hpx::parcelset::policies::tcp {
@@ -54,6 +56,13 @@ namespace hpx::parcelset::policies::tcp {
             return port_ != std::uint16_t(-1);
         }
 
+        std::size_t hash() const noexcept
+        {
+            std::size_t const h1(std::hash<std::string>()(address_));
+            std::size_t const h2(std::hash<std::uint16_t>()(port_));
+            return h1 ^ (h2 << 1);
+        }
+
         HPX_EXPORT void save(serialization::output_archive& ar) const;
         HPX_EXPORT void load(serialization::input_archive& ar);
 
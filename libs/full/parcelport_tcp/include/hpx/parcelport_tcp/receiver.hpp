@@ -20,6 +20,7 @@
 #include <hpx/modules/functional.hpp>
 #include <hpx/modules/timing.hpp>
 
+#include <hpx/parcelport_tcp/striped_transfers.hpp>
 #include <hpx/parcelset/decode_parcels.hpp>
 #include <hpx/parcelset/parcelport_connection.hpp>
 #include <hpx/parcelset_base/detail/data_point.hpp>
@@ -56,11 +57,14 @@ namespace hpx::parcelset::policies::tcp {
     {
     public:
         receiver(asio::io_context& io_service, std::uint64_t max_inbound_size,
-            connection_handler& parcelport)
+            connection_handler& parcelport, striped_transfers& transfers)
           : socket_(io_service)
           , max_inbound_size_(max_inbound_size)
           , ack_(0)
           , parcelport_(parcelport)
+          , transfers_(transfers)
+          , striped_(false)
+          , transfer_id_(0)
           , mtx_()
           , operation_in_flight_(0)
         {
@@ -165,6 +169,14 @@ namespace hpx::parcelset::policies::tcp {
             {
                 ++operation_in_flight_;
 
+                // this connection receives a stripe of a message received
+                // through another connection
+                if (buffer_.size_ == stripe_message_marker)
+                {
+                    handle_read_stripe_header(handler);
+                    return;
+                }
+
                 // Determine the length of the serialized data.
                 std::uint64_t inbound_size = buffer_.size_;
 
@@ -183,6 +195,12 @@ namespace hpx::parcelset::policies::tcp {
                 // receive buffers
                 std::vector<asio::mutable_buffer> buffers;
 
+                // a striped message carries an additional transmission chunk
+                // describing the transfer
+                striped_ =
+                    (buffer_.num_chunks_.first & striped_message_flag) != 0;
+                buffer_.num_chunks_.first &= ~striped_message_flag;
+
                 // determine the size of the chunk buffer
                 std::size_t num_zero_copy_chunks = static_cast<std::size_t>(
                     static_cast<std::uint32_t>(buffer_.num_chunks_.first));
@@ -200,7 +218,8 @@ namespace hpx::parcelset::policies::tcp {
                         buffer_.transmission_chunks_;
 
                     chunks.resize(static_cast<std::size_t>(
-                        num_zero_copy_chunks + num_non_zero_copy_chunks));
+                        num_zero_copy_chunks + num_non_zero_copy_chunks +
+                        (striped_ ? 1 : 0)));
 
                     buffers.push_back(asio::buffer(chunks.data(),
                         chunks.size() * sizeof(transmission_chunk_type)));
@@ -267,6 +286,27 @@ namespace hpx::parcelset::policies::tcp {
                 // receive buffers
                 std::vector<asio::mutable_buffer> buffers;
 
+                std::size_t num_stripes = 1;
+                if (striped_)
+                {
+                    auto const& t = buffer_.transmission_chunks_.back();
+                    transfer_id_ = t.first;
+                    if (t.second < 2 || t.second > max_stripes)
+                    {
+                        // report this problem back to the handler
+                        handler(asio::error::make_error_code(
+                            asio::error::invalid_argument));
+                        --operation_in_flight_;
+                        return;
+                    }
+                    num_stripes = static_cast<std::size_t>(t.second);
+                    buffer_.transmission_chunks_.pop_back();
+                }
+
+                // buffers for the stripes received through other connections
+                std::vector<striped_transfers::buffers_type> stripes(
+                    num_stripes);
+
                 // add appropriately sized chunk buffers for the zero-copy data
                 std::size_t num_zero_copy_chunks = static_cast<std::size_t>(
                     static_cast<std::uint32_t>(buffer_.num_chunks_.first));
@@ -274,17 +314,48 @@ namespace hpx::parcelset::policies::tcp {
                 buffer_.chunks_.resize(num_zero_copy_chunks);
                 for (std::size_t i = 0; i != num_zero_copy_chunks; ++i)
                 {
-                    std::size_t chunk_size = static_cast<std::size_t>(
-                        buffer_.transmission_chunks_[i].second);
+                    auto& c = buffer_.transmission_chunks_[i];
+                    std::size_t chunk_size = static_cast<std::size_t>(c.second);
                     buffer_.chunks_[i].resize(chunk_size);
-                    buffers.push_back(
-                        asio::buffer(buffer_.chunks_[i].data(), chunk_size));
+
+                    char* data = buffer_.chunks_[i].data();
+                    if (!(c.first & striped_chunk_flag))
+                    {
+                        buffers.push_back(asio::buffer(data, chunk_size));
+                        continue;
+                    }
+
+                    // the stripes of this chunk are placed directly into the
+                    // chunk buffer, the first stripe is sent with the message
+                    c.first &= ~striped_chunk_flag;
+                    for (std::size_t k = 0; k != num_stripes; ++k)
+                    {
+                        auto const r = stripe_range(chunk_size, k, num_stripes);
+                        if (r.second != 0)
+                        {
+                            (k == 0 ? buffers : stripes[k])
+                                .push_back(
+                                    asio::buffer(data + r.first, r.second));
+                        }
+                    }
                 }
 
                 // Start an asynchronous call to receive the data.
                 void (receiver::*f)(std::error_code const&, Handler) =
                     &receiver::handle_read_data<Handler>;
 
+                if (striped_)
+                {
+                    // the message is complete once all stripes have been
+                    // received as well
+                    f = &receiver::handle_read_striped_data<Handler>;
+                    transfers_.add(transfer_id_, HPX_MOVE(stripes),
+                        [this_ = shared_from_this(), handler](
+                            std::error_code const& e) {
+                            this_->handle_read_data(e, handler);
+                        });
+                }
+
                 {
                     std::unique_lock lk(mtx_);
                     if (!socket_.is_open())
@@ -311,6 +382,15 @@ namespace hpx::parcelset::policies::tcp {
             }
         }
 
+        // Handle a completed read of the part of a striped message sent
+        // through this connection.
+        template <typename Handler>
+        void handle_read_striped_data(std::error_code const& e, Handler)
+        {
+            // the last part received invokes handle_read_data
+            transfers_.part_done(transfer_id_, e);
+        }
+
         // Handle a completed read of message data.
         template <typename Handler>
         void handle_read_data(std::error_code const& e, Handler handler)
@@ -360,6 +440,114 @@ namespace hpx::parcelset::policies::tcp {
             }
         }
 
+        // Handle a completed read of the header of a stripe, wait for the
+        // message it belongs to before receiving the data.
+        template <typename Handler>
+        void handle_read_stripe_header(Handler handler)
+        {
+            transfer_id_ = buffer_.data_size_;
+            std::size_t const stripe = static_cast<std::size_t>(
+                static_cast<std::uint32_t>(buffer_.num_chunks_.first));
+            std::size_t const num_stripes = static_cast<std::size_t>(
+                static_cast<std::uint32_t>(buffer_.num_chunks_.second));
+
+            // the stripe index is received from the wire, the message itself
+            // carries stripe 0
+            if (stripe == 0 || stripe >= num_stripes ||
+                num_stripes > max_stripes)
+            {
+                // report this problem back to the handler
+                handler(asio::error::make_error_code(
+                    asio::error::invalid_argument));
+                --operation_in_flight_;
+                return;
+            }
+
+            transfers_.get_stripe(transfer_id_, stripe,
+                [this_ = shared_from_this(), handler](std::error_code const& e,
+                    striped_transfers::buffers_type&& buffers) {
+                    this_->read_stripe(e, HPX_MOVE(buffers), handler);
+                });
+        }
+
+        template <typename Handler>
+        void read_stripe(std::error_code const& e,
+            striped_transfers::buffers_type&& buffers, Handler handler)
+        {
+            if (e)
+            {
+                handler(e);
+                --operation_in_flight_;
+                return;
+            }
+
+            void (receiver::*f)(std::error_code const&, std::size_t,
+                Handler) = &receiver::handle_read_stripe<Handler>;
+
+            std::unique_lock lk(mtx_);
+            if (!socket_.is_open())
+            {
+                lk.unlock();
+
+                // report this problem back to the handler
+                std::error_code const ec =
+                    asio::error::make_error_code(asio::error::not_connected);
+                transfers_.part_done(transfer_id_, ec);
+                handler(ec);
+                --operation_in_flight_;
+                return;
+            }
+
+            asio::async_read(socket_, buffers,
+                hpx::bind(f, shared_from_this(),
+                    placeholders::_1,    // error,
+                    placeholders::_2,    // bytes_transferred
+                    util::protect(handler)));
+        }
+
+        // Handle a completed read of a stripe.
+        template <typename Handler>
+        void handle_read_stripe(std::error_code const& e,
+            std::size_t bytes_transferred, Handler handler)
+        {
+            if (!e)
+            {
+                transfers_.stripe_received(bytes_transferred);
+            }
+            transfers_.part_done(transfer_id_, e);
+            buffer_.clear();
+
+            if (e)
+            {
+                handler(e);
+                --operation_in_flight_;
+                return;
+            }
+
+            // now send acknowledgment byte
+            void (receiver::*f)(std::error_code const&, Handler) =
+                &receiver::handle_write_ack<Handler>;
+
+            ack_ = true;
+            {
+                std::unique_lock lk(mtx_);
+                if (!socket_.is_open())
+                {
+                    lk.unlock();
+
+                    // report this problem back to the handler
+                    handler(asio::error::make_error_code(
+                        asio::error::not_connected));
+                    return;
+                }
+
+                asio::async_write(socket_, asio::buffer(&ack_, sizeof(ack_)),
+                    hpx::bind(f, shared_from_this(),
+                        placeholders::_1,    // error,
+                        util::protect(handler)));
+            }
+        }
+
         template <typename Handler>
         void handle_write_ack(std::error_code const& e, Handler handler)
         {
@@ -386,6 +574,11 @@ namespace hpx::parcelset::policies::tcp {
         // The handler used to process the incoming request.
         connection_handler& parcelport_;
 
+        // Rendezvous of striped messages and their stripes
+        striped_transfers& transfers_;
+        bool striped_;
+        std::uint64_t transfer_id_;
+
         // Counters and timers for parcels received.
 #if defined(HPX_HAVE_PARCELPORT_COUNTERS)
         hpx::chrono::high_resolution_timer timer_;
@@ -16,10 +16,12 @@
 #include <hpx/modules/asio.hpp>
 #include <hpx/modules/functional.hpp>
 #include <hpx/modules/runtime_local.hpp>
+#include <hpx/modules/synchronization.hpp>
 #include <hpx/modules/threading_base.hpp>
 #include <hpx/modules/timing.hpp>
 
 #include <hpx/parcelport_tcp/locality.hpp>
+#include <hpx/parcelport_tcp/striped_transfers.hpp>
 #include <hpx/parcelset/parcelport_connection.hpp>
 #include <hpx/parcelset_base/detail/data_point.hpp>
 #include <hpx/parcelset_base/detail/gatherer.hpp>
@@ -40,7 +42,9 @@
 #undef VT1
 #undef VT2
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <system_error>
 #include <utility>
@@ -48,11 +52,15 @@
 
 namespace hpx::parcelset::policies::tcp {
 
+    class connection_handler;
+
     class sender
       : public parcelset::parcelport_connection<sender, std::vector<char>>
     {
         using postprocess_handler_type =
             hpx::move_only_function<void(std::error_code const&)>;
+        using stripe_handler_type =
+            hpx::move_only_function<void(std::error_code const&)>;
 
     public:
         // Construct a sending parcelport_connection with the given io_context.
@@ -94,6 +102,17 @@ namespace hpx::parcelset::policies::tcp {
             return there_;
         }
 
+        // Split zero-copy chunks of at least the given size into (up to)
+        // the given number of stripes sent in parallel over additional
+        // connections created by the given parcelport.
+        void enable_striping(connection_handler& parcelport,
+            std::size_t threshold, std::size_t count) noexcept
+        {
+            striping_parcelport_ = &parcelport;
+            stripe_threshold_ = threshold;
+            stripe_count_ = count;
+        }
+
         void verify_(parcelset::locality const& parcel_locality_id) const
         {
 #if defined(HPX_DEBUG)
@@ -142,6 +161,9 @@ namespace hpx::parcelset::policies::tcp {
 #if defined(HPX_HAVE_PARCELPORT_COUNTERS)
             buffer_.data_point_.time_ = timer_.elapsed_nanoseconds();
 #endif
+            // split large zero-copy chunks into stripes, if enabled
+            std::size_t const num_stripes = prepare_stripes();
+
             // Write the serialized data to the socket. We use "gather-write"
             // to send both the header and the data in a single write operation.
             std::vector<asio::const_buffer> buffers;
@@ -165,12 +187,21 @@ namespace hpx::parcelset::policies::tcp {
                 // add main buffer holding data which was serialized normally
                 buffers.push_back(asio::buffer(buffer_.data_));
 
-                // now add chunks themselves, those hold zero-copy serialized chunks
+                // now add chunks themselves, those hold zero-copy serialized
+                // chunks (only the first stripe of striped chunks)
+                std::size_t i = 0;
                 for (serialization::serialization_chunk& c : buffer_.chunks_)
                 {
                     if (c.type_ ==
                         serialization::chunk_type::chunk_type_pointer)
-                        buffers.push_back(asio::buffer(c.data_.cpos_, c.size_));
+                    {
+                        std::size_t size = c.size_;
+                        if (chunks[i++].first & striped_chunk_flag)
+                        {
+                            size = stripe_range(size, 0, num_stripes).second;
+                        }
+                        buffers.push_back(asio::buffer(c.data_.cpos_, size));
+                    }
                 }
             }
             else
@@ -188,23 +219,44 @@ namespace hpx::parcelset::policies::tcp {
             asio::async_write(socket_, buffers,
                 hpx::bind(
                     f, shared_from_this(), placeholders::_1, placeholders::_2));
+
+            // send the remaining stripes over the additional connections
+            if (num_stripes != 1)
+            {
+                write_stripes();
+            }
         }
 
+        // Send the given data as stripe 'stripe' of the message with the
+        // given transfer id (used for the additional connections of a
+        // striped message only).
+        void async_write_stripe(std::uint64_t transfer_id, std::uint32_t stripe,
+            std::uint32_t num_stripes, std::vector<asio::const_buffer>&& data,
+            stripe_handler_type&& f);
+
     private:
+        // Mark the zero-copy chunks of the current message which have to be
+        // striped, return the number of stripes to use (one if the message
+        // is not striped).
+        std::size_t prepare_stripes();
+
+        // Start sending all stripes but the first of the current message
+        void write_stripes();
+
+        // Handle completion of one part (the message itself or one of the
+        // stripes) of a striped message.
+        void part_done(std::error_code const& e);
+
+        void handle_write_stripe(std::error_code const& e, std::size_t);
+        void handle_read_stripe_ack(std::error_code const& e);
+
         static void reset_handler(postprocess_handler_type handler)
         {
             handler.reset();
         }
 
-        /// handle completed write operation
-        void handle_write(std::error_code const& e, std::size_t /* bytes */)
+        void reset_write_handler()
         {
-#if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
-            state_ = state_handle_write;
-#endif
-            // just call initial handler
-            handler_(e);
-
             postprocess_handler_type handler;
             std::swap(handler, handler_);
 
@@ -222,6 +274,30 @@ namespace hpx::parcelset::policies::tcp {
             {
                 reset_handler(HPX_MOVE(handler));
             }
+        }
+
+        /// handle completed write operation
+        void handle_write(std::error_code const& e, std::size_t /* bytes */)
+        {
+#if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
+            state_ = state_handle_write;
+#endif
+            // the parcels of a striped message have to be kept alive until
+            // all of its stripes have been sent
+            if (num_stripes_ != 1)
+            {
+                if (e)
+                {
+                    part_done(e);
+                    return;
+                }
+            }
+            else
+            {
+                // just call initial handler
+                handler_(e);
+                reset_write_handler();
+            }
 
             if (e)
             {
@@ -236,9 +312,12 @@ namespace hpx::parcelset::policies::tcp {
 
             // complete data point and push back onto gatherer
 #if defined(HPX_HAVE_PARCELPORT_COUNTERS)
-            buffer_.data_point_.time_ =
-                timer_.elapsed_nanoseconds() - buffer_.data_point_.time_;
-            pp_->add_sent_data(buffer_.data_point_);
+            if (num_stripes_ == 1)
+            {
+                buffer_.data_point_.time_ =
+                    timer_.elapsed_nanoseconds() - buffer_.data_point_.time_;
+                pp_->add_sent_data(buffer_.data_point_);
+            }
 #endif
 
             // now handle the acknowledgment byte which is sent by the receiver
@@ -260,6 +339,12 @@ namespace hpx::parcelset::policies::tcp {
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
             state_ = state_handle_read_ack;
 #endif
+            if (num_stripes_ != 1)
+            {
+                part_done(e);
+                return;
+            }
+
             buffer_.clear();
 
             // Call post-processing handler, which will send remaining pending
@@ -290,6 +375,25 @@ namespace hpx::parcelset::policies::tcp {
         hpx::move_only_function<void(std::error_code const&,
             parcelset::locality const&, std::shared_ptr<sender>)>
             postprocess_handler_;
+
+        // striping of large zero-copy chunks
+        connection_handler* striping_parcelport_ = nullptr;
+        std::size_t stripe_threshold_ = 0;
+        std::size_t stripe_count_ = 1;
+
+        // additional connections to the destination used for striping
+        std::vector<std::shared_ptr<sender>> stripes_;
+
+        // state of the striped message currently being sent
+        std::uint64_t transfer_id_ = 0;
+        std::size_t num_stripes_ = 1;
+        std::atomic<std::size_t> pending_parts_ = 0;
+        hpx::spinlock stripe_mtx_;
+        std::error_code stripe_error_;
+
+        // completion handler of the stripe currently being sent through this
+        // (additional) connection
+        stripe_handler_type stripe_handler_;
     };
 }    // namespace hpx::parcelset::policies::tcp
 
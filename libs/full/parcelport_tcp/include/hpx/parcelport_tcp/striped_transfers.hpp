@@ -0,0 +1,140 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_TCP)
+#include <hpx/modules/functional.hpp>
+#include <hpx/modules/synchronization.hpp>
+
+#include <asio/buffer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+// Large zero-copy chunks of a message may be split into stripes which are
+// sent in parallel over several connections to the same destination. The
+// message itself is sent as usual and carries the first stripe of each of
+// the striped chunks. Every additional connection carries the stripe with the
+// same index of all of the striped chunks of the message.
+//
+// A striped message is marked by the striped_message_flag in the number of
+// zero-copy chunks sent in its header. The transmission chunk information of
+// a striped message holds an additional entry (transfer id, number of
+// stripes), each striped chunk is marked by the striped_chunk_flag in its
+// chunk index.
+//
+// A stripe is sent using the same header layout as a message: the message
+// size is set to stripe_message_marker, the data size holds the transfer id,
+// and the chunk counts hold the stripe index and the number of stripes.
+namespace hpx::parcelset::policies::tcp {
+
+    inline constexpr std::uint32_t striped_message_flag = 0x80000000;
+    inline constexpr std::uint64_t striped_chunk_flag = 0x8000000000000000;
+    inline constexpr std::uint64_t stripe_message_marker = ~std::uint64_t(0);
+
+    // The maximal number of stripes a message may be split into, messages
+    // announcing more stripes are rejected by the receiver
+    inline constexpr std::size_t max_stripes = 64;
+
+    // Return the offset and the size of stripe 'stripe' out of 'num_stripes'
+    // of a zero-copy chunk holding 'size' bytes.
+    constexpr std::pair<std::size_t, std::size_t> stripe_range(
+        std::size_t size, std::size_t stripe, std::size_t num_stripes) noexcept
+    {
+        std::size_t const slice = (size + num_stripes - 1) / num_stripes;
+        std::size_t const begin = (std::min)(stripe * slice, size);
+        return {begin, (std::min)(begin + slice, size) - begin};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Rendezvous between the connection receiving a striped message and the
+    // connections receiving its stripes. The stripes may arrive before the
+    // buffers of the message have been allocated, in which case receiving
+    // them is delayed until the message has been registered. Received stripes
+    // are placed directly into the chunks of the message.
+    class HPX_EXPORT striped_transfers
+    {
+    public:
+        using buffers_type = std::vector<asio::mutable_buffer>;
+        using completion_handler_type =
+            hpx::move_only_function<void(std::error_code const&)>;
+        using stripe_handler_type = hpx::move_only_function<void(
+            std::error_code const&, buffers_type&&)>;
+
+        striped_transfers() = default;
+
+        striped_transfers(striped_transfers const&) = delete;
+        striped_transfers(striped_transfers&&) = delete;
+        striped_transfers& operator=(striped_transfers const&) = delete;
+        striped_transfers& operator=(striped_transfers&&) = delete;
+
+        // Register the message with the given transfer id. Stripe k of the
+        // message is received into stripes[k] (stripes[0] is received with
+        // the message itself). The given function is called once the
+        // message and all of its stripes have been received.
+        void add(std::uint64_t transfer_id, std::vector<buffers_type>&& stripes,
+            completion_handler_type&& f);
+
+        // Request the buffers stripe 'stripe' of the message with the given
+        // transfer id has to be received into. The given function is called
+        // as soon as the message has been registered. It receives an error
+        // if the message was not split into that many stripes.
+        void get_stripe(std::uint64_t transfer_id, std::size_t stripe,
+            stripe_handler_type&& f);
+
+        // Notify that one part (the message itself or one of its stripes)
+        // of the message with the given transfer id has been received.
+        void part_done(std::uint64_t transfer_id, std::error_code const& e);
+
+        // Abort all pending transfers
+        void cancel();
+
+        // Notify that a stripe holding the given number of bytes has been
+        // received through an additional connection
+        void stripe_received(std::size_t bytes) noexcept
+        {
+            ++stripes_received_;
+            stripe_bytes_received_ += static_cast<std::int64_t>(bytes);
+        }
+
+        // statistics of the stripes received through additional connections
+        std::int64_t get_stripes_received(bool reset);
+        std::int64_t get_stripe_bytes_received(bool reset);
+
+    private:
+        struct transfer
+        {
+            std::vector<buffers_type> stripes_;
+            completion_handler_type f_;
+            std::vector<std::pair<std::size_t, stripe_handler_type>> waiting_;
+            std::size_t pending_ = 0;
+            std::error_code error_;
+        };
+
+        using mutex_type = hpx::spinlock;
+
+        mutex_type mtx_;
+        std::map<std::uint64_t, transfer> transfers_;
+
+        std::atomic<std::int64_t> stripes_received_{0};
+        std::atomic<std::int64_t> stripe_bytes_received_{0};
+    };
+}    // namespace hpx::parcelset::policies::tcp
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
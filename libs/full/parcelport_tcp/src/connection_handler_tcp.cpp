@@ -27,12 +27,14 @@
 #include <asio/io_context.hpp>
 #include <asio/ip/tcp.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <memory>
 #include <mutex>
+#include <random>
 #include <string>
 #include <system_error>
 #include <thread>
@@ -64,6 +66,11 @@ namespace hpx::parcelset::policies::tcp {
         threads::policies::callback_notifier const& notifier)
       : base_type(ini, parcelport_address(ini), notifier)
       , acceptor_(nullptr)
+      , stripe_threshold_(hpx::util::get_entry_as<std::size_t>(
+            ini, "hpx.parcel.tcp.stripe_threshold", 4194304))
+      , stripe_count_((std::min)(hpx::util::get_entry_as<std::size_t>(
+                                     ini, "hpx.parcel.tcp.stripe_count", 1),
+            max_stripes))
     {
         if (here_.type() != std::string("tcp"))
         {
@@ -72,6 +79,11 @@ namespace hpx::parcelset::policies::tcp {
                 "locality type: {}",
                 here_.type());
         }
+
+        // transfer ids have to be unique across all localities sending
+        // striped messages to the same destination
+        std::random_device rd;
+        next_transfer_id_ = (static_cast<std::uint64_t>(rd()) << 32) | rd();
     }
 
     connection_handler::~connection_handler()
@@ -96,8 +108,9 @@ namespace hpx::parcelset::policies::tcp {
         {
             try
             {
-                std::shared_ptr<receiver> receiver_conn(new receiver(
-                    io_service, get_max_inbound_message_size(), *this));
+                std::shared_ptr<receiver> receiver_conn(
+                    new receiver(io_service, get_max_inbound_message_size(),
+                        *this, striped_transfers_));
 
                 tcp::endpoint ep = *it;
                 acceptor_->open(ep.protocol());
@@ -127,6 +140,9 @@ namespace hpx::parcelset::policies::tcp {
 
     void connection_handler::do_stop()
     {
+        // release the connections waiting for stripes which will not arrive
+        striped_transfers_.cancel();
+
         {
             // cancel all pending read operations, close those sockets
             std::lock_guard<hpx::spinlock> l(connections_mtx_);
@@ -158,6 +174,11 @@ namespace hpx::parcelset::policies::tcp {
         // need to keep the original parcel alive after this call returned.
         std::shared_ptr<sender> sender_connection(
             new sender(io_service, l, this));
+        if (stripe_count_ > 1)
+        {
+            sender_connection->enable_striping(
+                *this, stripe_threshold_, stripe_count_);
+        }
 
         // Connect to the target locality, retry if needed
         std::error_code error = asio::error::try_again;
@@ -286,8 +307,8 @@ namespace hpx::parcelset::policies::tcp {
             std::shared_ptr<receiver> c(receiver_conn);
 
             asio::io_context& io_service = io_service_pool_.get_io_service();
-            receiver_conn.reset(new receiver(
-                io_service, get_max_inbound_message_size(), *this));
+            receiver_conn.reset(new receiver(io_service,
+                get_max_inbound_message_size(), *this, striped_transfers_));
             acceptor_->async_accept(receiver_conn->socket(),
                 hpx::bind(&connection_handler::handle_accept, this,
                     placeholders::_1, receiver_conn));
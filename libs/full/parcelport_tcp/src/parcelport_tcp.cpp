@@ -21,6 +21,8 @@ namespace hpx::traits {
     //      [hpx.parcel.tcp]
     //      ...
     //      priority = 1
+    //      stripe_count = 1
+    //      stripe_threshold = 4194304
     //
     template <>
     struct plugin_config_data<hpx::parcelset::policies::tcp::connection_handler>
@@ -39,7 +41,14 @@ namespace hpx::traits {
 
         static constexpr char const* call() noexcept
         {
-            return "";
+            return
+                // number of connections used to send large zero-copy
+                // chunks, default: 1 (no striping)
+                "stripe_count = ${HPX_PARCEL_TCP_STRIPE_COUNT:1}\n"
+
+                // minimal size of zero-copy chunks to stripe, default: 4MB
+                "stripe_threshold = "
+                "${HPX_PARCEL_TCP_STRIPE_THRESHOLD:4194304}\n";
         }
     };
 }    // namespace hpx::traits
@@ -0,0 +1,245 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_TCP)
+#include <hpx/assert.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/functional.hpp>
+
+#include <hpx/parcelport_tcp/connection_handler.hpp>
+#include <hpx/parcelport_tcp/sender.hpp>
+#include <hpx/parcelport_tcp/striped_transfers.hpp>
+
+#include <asio/buffer.hpp>
+#include <asio/read.hpp>
+#include <asio/write.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace hpx::parcelset::policies::tcp {
+
+    std::size_t sender::prepare_stripes()
+    {
+        HPX_ASSERT(num_stripes_ == 1);
+
+        std::size_t const num_zero_copy_chunks =
+            static_cast<std::size_t>(buffer_.num_chunks_.first);
+        if (stripe_count_ < 2 || num_zero_copy_chunks == 0)
+        {
+            return 1;
+        }
+
+        auto& chunks = buffer_.transmission_chunks_;
+
+        bool has_large_chunks = false;
+        for (std::size_t i = 0; i != num_zero_copy_chunks; ++i)
+        {
+            if (chunks[i].second >= stripe_threshold_)
+            {
+                has_large_chunks = true;
+                break;
+            }
+        }
+
+        if (!has_large_chunks)
+        {
+            return 1;
+        }
+
+        // establish the additional connections on first use, sending the
+        // message unstriped if none could be created
+        while (stripes_.size() + 1 < stripe_count_)
+        {
+            error_code ec(throwmode::lightweight);
+            std::shared_ptr<sender> s =
+                striping_parcelport_->create_connection(there_, ec);
+            if (ec || !s)
+            {
+                break;
+            }
+            stripes_.push_back(HPX_MOVE(s));
+        }
+
+        if (stripes_.empty())
+        {
+            return 1;
+        }
+
+        num_stripes_ = stripes_.size() + 1;
+        transfer_id_ = striping_parcelport_->next_transfer_id();
+        pending_parts_ = num_stripes_;
+
+        for (std::size_t i = 0; i != num_zero_copy_chunks; ++i)
+        {
+            if (chunks[i].second >= stripe_threshold_)
+            {
+                chunks[i].first |= striped_chunk_flag;
+            }
+        }
+
+        buffer_.num_chunks_.first |= striped_message_flag;
+        chunks.emplace_back(transfer_id_, num_stripes_);
+
+        return num_stripes_;
+    }
+
+    void sender::write_stripes()
+    {
+        HPX_ASSERT(num_stripes_ == stripes_.size() + 1);
+
+        std::vector<std::vector<asio::const_buffer>> buffers(num_stripes_);
+
+        std::size_t i = 0;
+        for (serialization::serialization_chunk& c : buffer_.chunks_)
+        {
+            if (c.type_ != serialization::chunk_type::chunk_type_pointer)
+            {
+                continue;
+            }
+
+            if (buffer_.transmission_chunks_[i++].first & striped_chunk_flag)
+            {
+                char const* data = static_cast<char const*>(c.data_.cpos_);
+                for (std::size_t k = 1; k != num_stripes_; ++k)
+                {
+                    auto const r = stripe_range(c.size_, k, num_stripes_);
+                    if (r.second != 0)
+                    {
+                        buffers[k].push_back(
+                            asio::buffer(data + r.first, r.second));
+                    }
+                }
+            }
+        }
+
+        for (std::size_t k = 1; k != num_stripes_; ++k)
+        {
+            stripes_[k - 1]->async_write_stripe(transfer_id_,
+                static_cast<std::uint32_t>(k),
+                static_cast<std::uint32_t>(num_stripes_),
+                HPX_MOVE(buffers[k]),
+                hpx::bind_front(&sender::part_done, shared_from_this()));
+        }
+    }
+
+    void sender::part_done(std::error_code const& e)
+    {
+        if (e)
+        {
+            std::lock_guard<hpx::spinlock> l(stripe_mtx_);
+            if (!stripe_error_)
+            {
+                stripe_error_ = e;
+            }
+        }
+
+        if (--pending_parts_ != 0)
+        {
+            return;
+        }
+
+        // all stripes have been sent
+        std::error_code const ec = stripe_error_;
+        stripe_error_ = std::error_code();
+        num_stripes_ = 1;
+
+        handler_(ec);
+        reset_write_handler();
+
+        if (ec)
+        {
+            // the additional connections are re-established on next use
+            stripes_.clear();
+        }
+        else
+        {
+#if defined(HPX_HAVE_PARCELPORT_COUNTERS)
+            buffer_.data_point_.time_ =
+                timer_.elapsed_nanoseconds() - buffer_.data_point_.time_;
+            pp_->add_sent_data(buffer_.data_point_);
+#endif
+        }
+
+        buffer_.clear();
+
+        hpx::move_only_function<void(std::error_code const&,
+            parcelset::locality const&, std::shared_ptr<sender>)>
+            postprocess_handler;
+        std::swap(postprocess_handler, postprocess_handler_);
+        postprocess_handler(ec, there_, shared_from_this());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void sender::async_write_stripe(std::uint64_t transfer_id,
+        std::uint32_t stripe, std::uint32_t num_stripes,
+        std::vector<asio::const_buffer>&& data, stripe_handler_type&& f)
+    {
+        HPX_ASSERT(!stripe_handler_);
+        stripe_handler_ = HPX_MOVE(f);
+
+        buffer_.size_ = stripe_message_marker;
+        buffer_.data_size_ = transfer_id;
+        buffer_.num_chunks_ =
+            parcel_buffer_type::count_chunks_type(stripe, num_stripes);
+
+        std::vector<asio::const_buffer> buffers;
+        buffers.reserve(data.size() + 3);
+        buffers.push_back(asio::buffer(&buffer_.size_, sizeof(buffer_.size_)));
+        buffers.push_back(
+            asio::buffer(&buffer_.data_size_, sizeof(buffer_.data_size_)));
+        buffers.push_back(
+            asio::buffer(&buffer_.num_chunks_, sizeof(buffer_.num_chunks_)));
+        buffers.insert(buffers.end(), data.begin(), data.end());
+
+        void (sender::*f_write)(std::error_code const&, std::size_t) =
+            &sender::handle_write_stripe;
+
+        asio::async_write(socket_, buffers,
+            hpx::bind(f_write, shared_from_this(), placeholders::_1,
+                placeholders::_2));
+    }
+
+    void sender::handle_write_stripe(std::error_code const& e, std::size_t)
+    {
+        if (e)
+        {
+            handle_read_stripe_ack(e);
+            return;
+        }
+
+        // now handle the acknowledgment byte which is sent by the receiver
+#if defined(__linux) || defined(linux) || defined(__linux__)
+        asio::detail::socket_option::boolean<IPPROTO_TCP, TCP_QUICKACK>
+            quickack(true);
+        socket_.set_option(quickack);
+#endif
+
+        void (sender::*f)(std::error_code const&) =
+            &sender::handle_read_stripe_ack;
+
+        asio::async_read(socket_, asio::buffer(&ack_, sizeof(ack_)),
+            hpx::bind(f, shared_from_this(), placeholders::_1));
+    }
+
+    void sender::handle_read_stripe_ack(std::error_code const& e)
+    {
+        buffer_.clear();
+
+        stripe_handler_type f;
+        std::swap(f, stripe_handler_);
+        f(e);
+    }
+}    // namespace hpx::parcelset::policies::tcp
+
+#endif
@@ -0,0 +1,174 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_TCP)
+#include <hpx/assert.hpp>
+#include <hpx/modules/synchronization.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+
+#include <hpx/parcelport_tcp/striped_transfers.hpp>
+
+#include <asio/error.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace hpx::parcelset::policies::tcp {
+
+    void striped_transfers::add(std::uint64_t transfer_id,
+        std::vector<buffers_type>&& stripes, completion_handler_type&& f)
+    {
+        HPX_ASSERT(stripes.size() > 1);
+
+        std::vector<std::pair<std::size_t, stripe_handler_type>> waiting;
+        std::vector<buffers_type> buffers(stripes.size());
+
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            transfer& t = transfers_[transfer_id];
+            HPX_ASSERT(!t.f_);
+
+            t.stripes_ = HPX_MOVE(stripes);
+            t.f_ = HPX_MOVE(f);
+            t.pending_ = t.stripes_.size();
+
+            // hand out the buffers to the stripes which arrived early
+            std::swap(waiting, t.waiting_);
+            for (auto& w : waiting)
+            {
+                if (w.first < t.stripes_.size())
+                {
+                    buffers[w.first] = HPX_MOVE(t.stripes_[w.first]);
+                }
+            }
+        }
+
+        for (auto& w : waiting)
+        {
+            if (w.first < buffers.size())
+            {
+                w.second(std::error_code(), HPX_MOVE(buffers[w.first]));
+            }
+            else
+            {
+                w.second(asio::error::make_error_code(
+                             asio::error::invalid_argument),
+                    buffers_type());
+            }
+        }
+    }
+
+    void striped_transfers::get_stripe(std::uint64_t transfer_id,
+        std::size_t stripe, stripe_handler_type&& f)
+    {
+        buffers_type buffers;
+
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            transfer& t = transfers_[transfer_id];
+            if (!t.f_)
+            {
+                // the message has not been registered yet
+                t.waiting_.emplace_back(stripe, HPX_MOVE(f));
+                return;
+            }
+
+            if (stripe == 0 || stripe >= t.stripes_.size())
+            {
+                // the message was not split into this many stripes
+                l.unlock();
+                f(asio::error::make_error_code(asio::error::invalid_argument),
+                    buffers_type());
+                return;
+            }
+            buffers = HPX_MOVE(t.stripes_[stripe]);
+        }
+
+        f(std::error_code(), HPX_MOVE(buffers));
+    }
+
+    void striped_transfers::part_done(
+        std::uint64_t transfer_id, std::error_code const& e)
+    {
+        completion_handler_type f;
+        std::error_code error;
+
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            auto it = transfers_.find(transfer_id);
+            if (it == transfers_.end())
+            {
+                return;    // the transfer was canceled
+            }
+
+            transfer& t = it->second;
+            HPX_ASSERT(t.pending_ != 0);
+
+            if (e && !t.error_)
+            {
+                t.error_ = e;
+            }
+
+            if (--t.pending_ != 0)
+            {
+                return;
+            }
+
+            f = HPX_MOVE(t.f_);
+            error = t.error_;
+            transfers_.erase(it);
+        }
+
+        f(error);
+    }
+
+    void striped_transfers::cancel()
+    {
+        std::map<std::uint64_t, transfer> transfers;
+
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            std::swap(transfers, transfers_);
+        }
+
+        std::error_code const e =
+            asio::error::make_error_code(asio::error::operation_aborted);
+
+        for (auto& t : transfers)
+        {
+            for (auto& w : t.second.waiting_)
+            {
+                w.second(e, buffers_type());
+            }
+            if (t.second.f_)
+            {
+                t.second.f_(e);
+            }
+        }
+    }
+
+    std::int64_t striped_transfers::get_stripes_received(bool reset)
+    {
+        return util::get_and_reset_value(stripes_received_, reset);
+    }
+
+    std::int64_t striped_transfers::get_stripe_bytes_received(bool reset)
+    {
+        return util::get_and_reset_value(stripe_bytes_received_, reset);
+    }
+}    // namespace hpx::parcelset::policies::tcp
+
+#endif
@@ -0,0 +1,122 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measure the bandwidth of sending large zero-copy chunks between two
+// localities for a given number of stripes. Run this with --stripes=1,2,4,...
+// to see how the bandwidth scales with the number of connections used.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/local/chrono.hpp>
+#include <hpx/serialization/serialize_buffer.hpp>
+
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using buffer_type = hpx::serialization::serialize_buffer<char>;
+
+// only the size is sent back to measure the bandwidth in one direction
+std::size_t receive(buffer_type const& b)
+{
+    return b.size();
+}
+HPX_PLAIN_ACTION(receive)
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    std::size_t const stripes = vm["stripes"].as<std::size_t>();
+    std::size_t const size = vm["size"].as<std::size_t>();
+    std::size_t const iterations = vm["iterations"].as<std::size_t>();
+    std::size_t const window = vm["window"].as<std::size_t>();
+
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+    if (localities.empty())
+    {
+        std::cerr << "this benchmark requires at least two localities\n";
+        return hpx::finalize();
+    }
+
+    std::unique_ptr<char[]> send_buffer(new char[size]);
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        send_buffer[i] = static_cast<char>(i);
+    }
+    buffer_type b(send_buffer.get(), size, buffer_type::reference);
+
+    // warm up, this establishes the additional connections
+    receive_action act;
+    act(localities[0], b);
+
+    hpx::chrono::high_resolution_timer t;
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        std::vector<hpx::future<std::size_t>> fs;
+        fs.reserve(window);
+        for (std::size_t j = 0; j != window; ++j)
+        {
+            fs.push_back(hpx::async(act, localities[0], b));
+        }
+        hpx::wait_all(fs);
+    }
+    double const elapsed = t.elapsed();
+
+    double const bytes = double(size) * double(iterations * window);
+    std::cout << "stripes: " << stripes << ", size: " << size
+              << ", bandwidth: " << std::fixed << std::setprecision(2)
+              << bytes / elapsed / (1024 * 1024) << " MB/s\n";
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace hpx::program_options;
+
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("stripes", value<std::size_t>()->default_value(4),
+         "number of connections a chunk is striped over")
+        ("size", value<std::size_t>()->default_value(std::size_t(1) << 24),
+         "size of the chunks sent (in bytes)")
+        ("iterations", value<std::size_t>()->default_value(10),
+         "number of iterations")
+        ("window", value<std::size_t>()->default_value(4),
+         "number of chunks in flight in each iteration")
+        ;
+    // clang-format on
+
+    // the command line has not been parsed yet, look for the number of
+    // stripes to configure the parcelport accordingly
+    std::string stripes = "4";
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string const arg(argv[i]);
+        if (arg.compare(0, 10, "--stripes=") == 0)
+        {
+            stripes = arg.substr(10);
+        }
+    }
+
+    hpx::init_params init_args;
+    init_args.desc_cmdline = cmdline;
+    init_args.cfg = {"hpx.parcel.tcp.stripe_count!=" + stripes,
+        "hpx.parcel.tcp.stripe_threshold!=1048576"};
+
+    return hpx::init(argc, argv, init_args);
+}
+#endif
@@ -0,0 +1,164 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that large zero-copy chunks are correctly reassembled if those are
+// striped over several connections.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/parcelport_tcp/connection_handler.hpp>
+#include <hpx/serialization/serialize_buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const stripe_threshold = 65536;
+
+using buffer_type = hpx::serialization::serialize_buffer<char>;
+
+buffer_type bounce(buffer_type const& receive_buffer)
+{
+    return receive_buffer;
+}
+HPX_PLAIN_ACTION(bounce)
+
+std::uint64_t accumulate(std::uint64_t result, buffer_type const& b)
+{
+    for (std::size_t i = 0; i != b.size(); ++i)
+    {
+        result = result * 31 + static_cast<unsigned char>(b.data()[i]);
+    }
+    return result;
+}
+
+// the buffers are sent as separate zero-copy chunks of the same message
+std::uint64_t checksum(buffer_type const& b1, buffer_type const& b2)
+{
+    return accumulate(accumulate(0, b1), b2);
+}
+HPX_PLAIN_ACTION(checksum)
+
+// the number of bytes received as stripes over additional connections
+std::int64_t stripe_bytes_received()
+{
+    std::shared_ptr<hpx::parcelset::parcelport> pp =
+        hpx::get_runtime_distributed()
+            .get_parcel_handler()
+            .get_bootstrap_parcelport();
+
+    auto* handler =
+        dynamic_cast<hpx::parcelset::policies::tcp::connection_handler*>(
+            pp.get());
+    HPX_TEST(handler != nullptr);
+    if (handler == nullptr)
+    {
+        return 0;
+    }
+    return handler->get_striped_transfers().get_stripe_bytes_received(false);
+}
+HPX_PLAIN_ACTION(stripe_bytes_received)
+
+HPX_REGISTER_BASE_LCO_WITH_VALUE_DECLARATION(
+    buffer_type, serialization_buffer_char)
+HPX_REGISTER_BASE_LCO_WITH_VALUE(buffer_type, serialization_buffer_char)
+
+///////////////////////////////////////////////////////////////////////////////
+void test_bounce(hpx::id_type const& dest, char* send_buffer, std::size_t size)
+{
+    std::vector<hpx::future<buffer_type>> recv_buffers;
+    recv_buffers.reserve(10);
+
+    bounce_action act;
+    for (std::size_t j = 0; j != 10; ++j)
+    {
+        recv_buffers.push_back(hpx::async(
+            act, dest, buffer_type(send_buffer, size, buffer_type::reference)));
+    }
+    hpx::wait_all(recv_buffers);
+
+    for (hpx::future<buffer_type>& f : recv_buffers)
+    {
+        buffer_type b = f.get();
+        HPX_TEST_EQ(b.size(), size);
+        HPX_TEST_EQ(0, std::memcmp(b.data(), send_buffer, size));
+    }
+}
+
+void test_checksum(hpx::id_type const& dest, char* send_buffer,
+    std::size_t size1, std::size_t size2)
+{
+    buffer_type b1(send_buffer, size1, buffer_type::reference);
+    buffer_type b2(send_buffer + size1, size2, buffer_type::reference);
+
+    checksum_action act;
+    HPX_TEST_EQ(checksum(b1, b2), act(dest, b1, b2));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    std::size_t const max_size = 1 << 22;
+    std::unique_ptr<char[]> send_buffer(new char[2 * max_size + 7]);
+    for (std::size_t i = 0; i != 2 * max_size + 7; ++i)
+    {
+        send_buffer[i] = static_cast<char>(i * 7 + i / 251);
+    }
+
+    // chunk sizes around the striping threshold, including sizes not
+    // evenly divisible by the number of stripes
+    std::size_t const sizes[] = {stripe_threshold - 1, stripe_threshold,
+        stripe_threshold + 1, 4 * stripe_threshold + 3, max_size - 1,
+        max_size + 7};
+
+    for (hpx::id_type const& loc : hpx::find_remote_localities())
+    {
+        for (std::size_t size : sizes)
+        {
+            test_bounce(loc, send_buffer.get(), size);
+        }
+
+        test_checksum(loc, send_buffer.get(), max_size, max_size + 7);
+        test_checksum(loc, send_buffer.get(), stripe_threshold / 2, max_size);
+        test_checksum(loc, send_buffer.get(), max_size, stripe_threshold / 2);
+
+        // the large chunks were striped in both directions
+        HPX_TEST_LT(std::int64_t(0), stripe_bytes_received_action()(loc));
+    }
+
+    if (!hpx::find_remote_localities().empty())
+    {
+        HPX_TEST_LT(std::int64_t(0), stripe_bytes_received());
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // stripe zero-copy chunks of at least 64kB over four connections
+    std::vector<std::string> const cfg = {
+        "hpx.parcel.tcp.stripe_count!=4",
+        "hpx.parcel.tcp.stripe_threshold!=" + std::to_string(stripe_threshold),
+        "hpx.parcel.zero_copy_serialization_threshold!=4096"};
+
+    hpx::init_params init_args;
+    init_args.cfg = cfg;
+
+    HPX_TEST_EQ(hpx::init(argc, argv, init_args), 0);
+    return hpx::util::report_errors();
+}
+#endif
@@ -1,4 +1,4 @@
-//  Copyright (c) 2007-2021 Hartmut Kaiser
+//  Copyright (c) 2007-2022 Hartmut Kaiser
 //  Copyright (c)      2012 Thomas Heller
 //  Copyright (c)      2012 Bryce Adelstein-Lelbach
 //
@@ -19,15 +19,18 @@
 
 #if defined(HPX_HAVE_NETWORKING)
 #include <hpx/assert.hpp>
+#include <hpx/modules/concurrency.hpp>
 #include <hpx/modules/datastructures.hpp>
 #include <hpx/modules/errors.hpp>
 #include <hpx/modules/logging.hpp>
 #include <hpx/modules/synchronization.hpp>
 #include <hpx/modules/util.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -42,8 +45,14 @@ namespace hpx { namespace util {
     ///////////////////////////////////////////////////////////////////////////
     /// This class implements an LRU cache to hold connections. It includes
     /// entries checked out from the cache in its cache size.
-    // TODO: investigate usage of boost.cache.
-    template <typename Connection, typename Key>
+    ///
+    /// The cache is split into shards, the shard used for a key is selected
+    /// based on the hash of the key. Each shard is protected by its own lock
+    /// and maintains its own LRU list, which allows for connections to
+    /// different localities to be handed out and returned concurrently. The
+    /// overall number of connections is limited across all shards.
+    template <typename Connection, typename Key,
+        typename Hash = std::hash<Key>>
     class connection_cache
     {
     public:
@@ -62,19 +71,48 @@ namespace hpx { namespace util {
         using cache_type = std::map<key_type, cache_value_type>;
         using size_type = typename cache_type::size_type;
 
-        connection_cache(
-            size_type max_connections, size_type max_connections_per_locality)
+        static constexpr size_type default_num_shards = 16;
+
+        // The number of connections to a locality which may be created on
+        // top of the per-locality limit if forced (see get_or_reserve)
+        static constexpr size_type max_forced_connections_per_locality = 1;
+
+    private:
+        // Statistics are collected per shard (protected by the shard's lock)
+        // to avoid contention on shared counters, the accessors sum them up.
+        struct statistics
+        {
+            std::int64_t insertions_ = 0;
+            std::int64_t evictions_ = 0;
+            std::int64_t hits_ = 0;
+            std::int64_t misses_ = 0;
+            std::int64_t reclaims_ = 0;
+        };
+
+        // The connections to all localities mapped onto the same shard
+        struct shard
+        {
+            mutable mutex_type mtx_;
+            key_tracker_type key_tracker_;
+            cache_type cache_;
+            size_type connections_ = 0;
+            statistics stats_;
+        };
+
+        using shard_type = cache_aligned_data_derived<shard>;
+
+    public:
+        connection_cache(size_type max_connections,
+            size_type max_connections_per_locality,
+            size_type num_shards = default_num_shards)
           : max_connections_(max_connections < 2 ? 2 : max_connections)
           , max_connections_per_locality_(max_connections_per_locality < 2 ?
                     2 :
                     max_connections_per_locality)
+          , num_shards_(num_shards == 0 ? 1 : num_shards)
+          , shards_(new shard_type[num_shards_])
           , connections_(0)
           , shutting_down_(false)
-          , insertions_(0)
-          , evictions_(0)
-          , hits_(0)
-          , misses_(0)
-          , reclaims_(0)
         {
             if (max_connections_per_locality_ > max_connections_)
             {
@@ -132,12 +170,18 @@ namespace hpx { namespace util {
             return hpx::get<3>(entry);
         }
 
+        shard& get_shard(key_type const& l) const
+        {
+            return shards_[hash_(l) % num_shards_];
+        }
+
         ///////////////////////////////////////////////////////////////////////
         // Increase the per-locality and overall connection counts.
-        void increment_connection_count(cache_value_type& e)
+        void increment_connection_count(shard& s, cache_value_type& e)
         {
             std::size_t& num_connections = num_existing_connections(e);
             ++num_connections;
+            ++s.connections_;
             ++connections_;
 
             // If appropriate, update the maximum number of allowed cached
@@ -151,10 +195,11 @@ namespace hpx { namespace util {
         }
 
         // Decrease the per-locality and overall connection counts.
-        void decrement_connection_count(cache_value_type& e)
+        void decrement_connection_count(shard& s, cache_value_type& e)
         {
             std::size_t& num_connections = num_existing_connections(e);
             --num_connections;
+            --s.connections_;
             --connections_;
 
             // If appropriate, update the maximum number of allowed
@@ -177,18 +222,19 @@ namespace hpx { namespace util {
         ///          \a reclaim().
         connection_type get(key_type const& l)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
+            shard& s = get_shard(l);
+            std::lock_guard<mutex_type> lock(s.mtx_);
 
             // Check if this key already exists in the cache.
-            typename cache_type::iterator const it = cache_.find(l);
+            typename cache_type::iterator const it = s.cache_.find(l);
 
             // Check if this key already exists in the cache.
-            if (it != cache_.end())
+            if (it != s.cache_.end())
             {
                 // Key exists in cache.
 
                 // Update LRU meta data.
-                key_tracker_.splice(key_tracker_.end(), key_tracker_,
+                s.key_tracker_.splice(s.key_tracker_.end(), s.key_tracker_,
                     lru_reference(it->second));
 
                 // If connections to the locality are available in the cache,
@@ -199,15 +245,15 @@ namespace hpx { namespace util {
                     connection_type result = connections.front();
                     connections.pop_front();
 
-                    ++hits_;
-                    check_invariants();
+                    ++s.stats_.hits_;
+                    check_invariants(s);
                     return result;
                 }
             }
 
             // If we get here then the item is not in the cache.
-            ++misses_;
-            check_invariants();
+            ++s.stats_.misses_;
+            check_invariants(s);
             return connection_type();
         }
 
@@ -224,24 +270,27 @@ namespace hpx { namespace util {
         ///          returns false.
         ///          If force_insert is true, a new connection entry will be
         ///          created even if that means the cache limits will be
-        ///          exceeded.
+        ///          exceeded. The number of connections to \a l will however
+        ///          never exceed the per-locality limit by more than
+        ///          \a max_forced_connections_per_locality.
         ///
         /// \note    The connection must be returned to the cache by calling
         ///          \a reclaim().
         bool get_or_reserve(
             key_type const& l, connection_type& conn, bool force_insert = false)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
+            shard& s = get_shard(l);
+            std::lock_guard<mutex_type> lock(s.mtx_);
 
-            typename cache_type::iterator const it = cache_.find(l);
+            typename cache_type::iterator const it = s.cache_.find(l);
 
             // Check if this key already exists in the cache.
-            if (it != cache_.end())
+            if (it != s.cache_.end())
             {
                 // Key exists in cache.
 
                 // Update LRU meta data.
-                key_tracker_.splice(key_tracker_.end(), key_tracker_,
+                s.key_tracker_.splice(s.key_tracker_.end(), s.key_tracker_,
                     lru_reference(it->second));
 
                 // If connections to the locality are available in the cache,
@@ -255,8 +304,8 @@ namespace hpx { namespace util {
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
                     conn->set_state(Connection::state_reinitialized);
 #endif
-                    ++hits_;
-                    check_invariants();
+                    ++s.stats_.hits_;
+                    check_invariants(s);
                     return true;
                 }
 
@@ -265,7 +314,10 @@ namespace hpx { namespace util {
                 // connection.
                 if (num_existing_connections(it->second) <
                         max_num_connections(it->second) ||
-                    force_insert)
+                    (force_insert &&
+                        num_existing_connections(it->second) <
+                            max_num_connections(it->second) +
+                                max_forced_connections_per_locality))
                 {
                     // See if we have enough space or can make space available.
 
@@ -275,13 +327,13 @@ namespace hpx { namespace util {
                     // reduced in size next time some connection is handed back
                     // to the cache).
 
-                    if (!free_space() &&
+                    if (!free_space(s) &&
                         num_existing_connections(it->second) != 0 &&
                         !force_insert)
                     {
                         // If we can't find or make space, give up.
-                        ++misses_;
-                        check_invariants();
+                        ++s.stats_.misses_;
+                        check_invariants(s);
                         return false;
                     }
 
@@ -290,19 +342,19 @@ namespace hpx { namespace util {
                     conn.reset();
 
                     // Increase the per-locality and overall connection counts.
-                    increment_connection_count(it->second);
+                    increment_connection_count(s, it->second);
 
                     // Statistics
-                    ++insertions_;
-                    check_invariants();
+                    ++s.stats_.insertions_;
+                    check_invariants(s);
                     return true;
                 }
 
                 // We've reached the maximum number of connections for this
                 // locality, and none of them are checked into the cache, so
                 // we have to give up.
-                ++misses_;
-                check_invariants();
+                ++s.stats_.misses_;
+                check_invariants(s);
                 return false;
             }
 
@@ -316,13 +368,13 @@ namespace hpx { namespace util {
             // fails we grow the cache size beyond its limit (hoping that it
             // will be reduced in size next time some connection is handed back
             // to the cache).
-            free_space();
+            free_space(s);
 
             // Update LRU meta data.
             typename key_tracker_type::iterator kt =
-                key_tracker_.insert(key_tracker_.end(), l);
+                s.key_tracker_.insert(s.key_tracker_.end(), l);
 
-            cache_.insert(std::make_pair(l,
+            s.cache_.insert(std::make_pair(l,
                 hpx::make_tuple(
                     value_type(), 1, max_connections_per_locality_, kt)));
 
@@ -330,10 +382,11 @@ namespace hpx { namespace util {
             conn.reset();
 
             // Increase the overall connection counts.
+            ++s.connections_;
             ++connections_;
 
-            ++insertions_;
-            check_invariants();
+            ++s.stats_.insertions_;
+            check_invariants(s);
             return true;
         }
 
@@ -343,26 +396,31 @@ namespace hpx { namespace util {
         ///       a prior call to \a get() or \a get_or_reserve().
         void reclaim(key_type const& l, connection_type const& conn)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
+            shard& s = get_shard(l);
+            std::lock_guard<mutex_type> lock(s.mtx_);
 
             // Search for an entry for this key.
-            typename cache_type::iterator const ct = cache_.find(l);
+            typename cache_type::iterator const ct = s.cache_.find(l);
 
-            if (ct != cache_.end())
+            if (ct != s.cache_.end())
             {
                 // Update LRU meta data.
-                key_tracker_.splice(key_tracker_.end(), key_tracker_,
+                s.key_tracker_.splice(s.key_tracker_.end(), s.key_tracker_,
                     lru_reference(ct->second));
 
                 // Return the connection back to the cache only if the number
-                // of connections does not need to be shrunk.
+                // of connections does not need to be shrunk. Connections
+                // created on top of the limit by forced insertions are kept
+                // as well, otherwise every forced insertion would open a new
+                // connection.
                 if (num_existing_connections(ct->second) <=
-                    max_num_connections(ct->second))
+                    max_num_connections(ct->second) +
+                        max_forced_connections_per_locality)
                 {
                     // Add the connection to the entry.
                     cached_connections(ct->second).push_back(conn);
 
-                    ++reclaims_;
+                    ++s.stats_.reclaims_;
 
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
                     conn->set_state(Connection::state_reclaimed);
@@ -371,10 +429,10 @@ namespace hpx { namespace util {
                 else
                 {
                     // Adjust the number of existing connections for this key.
-                    decrement_connection_count(ct->second);
+                    decrement_connection_count(s, ct->second);
 
                     // do the accounting
-                    ++evictions_;
+                    ++s.stats_.evictions_;
 
                     // the connection itself will go out of scope on return
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
@@ -382,9 +440,10 @@ namespace hpx { namespace util {
 #endif
                 }
 
-                // FIXME: Again, this should probably throw instead of asserting,
-                // as invariants could be invalidated here due to caller error.
-                check_invariants();
+                // FIXME: Again, this should probably throw instead of
+                // asserting, as invariants could be invalidated here due to
+                // caller error.
+                check_invariants(s);
             }
         }
 
@@ -392,21 +451,20 @@ namespace hpx { namespace util {
         /// than the maximum number of overall connections, and false otherwise.
         bool full() const
         {
-            std::lock_guard<mutex_type> lock(mtx_);
-            return (connections_ >= max_connections_);
+            return connections_ >= max_connections_;
         }
 
         /// Returns true if the connection count for \a l is equal to or larger
         /// than the maximum connection count per locality, and false otherwise.
         bool full(key_type const& l) const
         {
-            std::lock_guard<mutex_type> lock(mtx_);
+            shard const& s = get_shard(l);
+            std::lock_guard<mutex_type> lock(s.mtx_);
 
-            if (!cache_.count(l))
-                return false || (connections_ >= max_connections_);
+            typename cache_type::const_iterator ct = s.cache_.find(l);
+            if (ct == s.cache_.end())
+                return connections_ >= max_connections_;
 
-            typename cache_type::const_iterator ct = cache_.find(l);
-            HPX_ASSERT(ct != cache_.end());
             return (num_existing_connections(ct->second) >=
                        max_num_connections(ct->second)) ||
                 (connections_ >= max_connections_);
@@ -419,20 +477,22 @@ namespace hpx { namespace util {
         ///       invariants.
         void clear()
         {
-            std::lock_guard<mutex_type> lock(mtx_);
-            key_tracker_.clear();
-            cache_.clear();
-            connections_ = 0;
+            for (size_type i = 0; i != num_shards_; ++i)
+            {
+                shard& s = shards_[i];
+                std::lock_guard<mutex_type> lock(s.mtx_);
 
-            insertions_ = 0;
-            evictions_ = 0;
-            hits_ = 0;
-            misses_ = 0;
-            reclaims_ = 0;
+                connections_ -= s.connections_;
 
-            // FIXME: This should probably throw instead of asserting, as it
-            // can be triggered by caller error.
-            check_invariants();
+                s.key_tracker_.clear();
+                s.cache_.clear();
+                s.connections_ = 0;
+                s.stats_ = statistics();
+
+                // FIXME: This should probably throw instead of asserting, as
+                // it can be triggered by caller error.
+                check_invariants(s);
+            }
         }
 
         /// Destroys all connections for the given locality in the cache, reset
@@ -443,97 +503,118 @@ namespace hpx { namespace util {
         ///       invariants.
         void clear(key_type const& l)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
+            shard& s = get_shard(l);
+            std::lock_guard<mutex_type> lock(s.mtx_);
 
             // Check if this key already exists in the cache.
-            typename cache_type::iterator it = cache_.find(l);
-            if (it != cache_.end())
+            typename cache_type::iterator it = s.cache_.find(l);
+            if (it != s.cache_.end())
             {
                 // Remove from LRU meta data.
-                key_tracker_.erase(lru_reference(it->second));
+                s.key_tracker_.erase(lru_reference(it->second));
 
                 // correct counter to avoid assertions later on
                 std::size_t num_existing = num_existing_connections(it->second);
+                s.connections_ -= num_existing;
                 connections_ -= num_existing;
-                evictions_ += num_existing;
+                s.stats_.evictions_ += static_cast<std::int64_t>(num_existing);
 
                 // Erase entry if key exists in the cache.
-                cache_.erase(it);
+                s.cache_.erase(it);
             }
 
             // FIXME: This should probably throw instead of asserting, as it
             // can be triggered by caller error.
-            check_invariants();
+            check_invariants(s);
         }
 
         /// Destroys all connections for the given locality in the cache, reset
-        /// all associated counts.
+        /// all associated counts. The given connection may be empty if the
+        /// space reserved for a new connection is given back.
         void clear(key_type const& l, connection_type const& conn)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
+            shard& s = get_shard(l);
+            std::lock_guard<mutex_type> lock(s.mtx_);
 
             // Check if this key already exists in the cache.
-            typename cache_type::iterator const it = cache_.find(l);
-            if (it != cache_.end())
+            typename cache_type::iterator const it = s.cache_.find(l);
+            if (it != s.cache_.end())
             {
                 // Adjust the number of existing connections for this key.
-                decrement_connection_count(it->second);
+                decrement_connection_count(s, it->second);
 
                 // do the accounting
-                ++evictions_;
+                ++s.stats_.evictions_;
 
                 // the connection itself will go out of scope on return
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
-                conn->set_state(Connection::state_deleting);
+                if (conn)
+                {
+                    conn->set_state(Connection::state_deleting);
+                }
 #else
                 HPX_UNUSED(conn);
 #endif
             }
 
-            check_invariants();
+            check_invariants(s);
         }
 
         // access statistics
         std::int64_t get_cache_insertions(bool reset)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
-            return util::get_and_reset_value(insertions_, reset);
+            return get_statistics(&statistics::insertions_, reset);
         }
 
         std::int64_t get_cache_evictions(bool reset)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
-            return util::get_and_reset_value(evictions_, reset);
+            return get_statistics(&statistics::evictions_, reset);
         }
 
         std::int64_t get_cache_hits(bool reset)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
-            return util::get_and_reset_value(hits_, reset);
+            return get_statistics(&statistics::hits_, reset);
         }
 
         std::int64_t get_cache_misses(bool reset)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
-            return util::get_and_reset_value(misses_, reset);
+            return get_statistics(&statistics::misses_, reset);
         }
 
         std::int64_t get_cache_reclaims(bool reset)
         {
-            std::lock_guard<mutex_type> lock(mtx_);
-            return util::get_and_reset_value(reclaims_, reset);
+            return get_statistics(&statistics::reclaims_, reset);
         }
 
     private:
-        /// Verify class invariants
-        void check_invariants() const
+        /// Sum up the given statistics counter over all shards
+        std::int64_t get_statistics(
+            std::int64_t statistics::*counter, bool reset)
+        {
+            std::int64_t result = 0;
+            for (size_type i = 0; i != num_shards_; ++i)
+            {
+                shard& s = shards_[i];
+                std::lock_guard<mutex_type> lock(s.mtx_);
+
+                result += s.stats_.*counter;
+                if (reset)
+                {
+                    s.stats_.*counter = 0;
+                }
+            }
+            return result;
+        }
+
+        /// Verify class invariants for the given (locked) shard
+        void check_invariants(shard const& s) const
         {
 #if defined(HPX_DEBUG)
             using const_iterator = typename cache_type::const_iterator;
 
             size_type in_cache_count = 0, total_count = 0;
-            const_iterator end = cache_.end();
-            for (const_iterator ct = cache_.begin(); ct != end; ++ct)
+            const_iterator end = s.cache_.end();
+            for (const_iterator ct = s.cache_.begin(); ct != end; ++ct)
             {
                 cache_value_type const& val = ct->second;
 
@@ -552,36 +633,74 @@ namespace hpx { namespace util {
 
             // Overall connection count should be larger than or equal to the
             // number of entries in the cache.
-            HPX_ASSERT(in_cache_count <= connections_);
+            HPX_ASSERT(in_cache_count <= s.connections_);
 
             // Overall connection count should be equal to the sum of connection
             // counts for all localities.
-            HPX_ASSERT(total_count == connections_);
+            HPX_ASSERT(total_count == s.connections_);
 
             // The list of key trackers should have the same size as the cache.
-            HPX_ASSERT(key_tracker_.size() == cache_.size());
+            HPX_ASSERT(s.key_tracker_.size() == s.cache_.size());
+#else
+            HPX_UNUSED(s);
 #endif
         }
 
         /// Evict the least recently used removable entry from the cache if the
-        /// cache is full.
+        /// cache is full. Entries are evicted from the given (locked) shard
+        /// first, other shards are considered only if those are not locked
+        /// concurrently.
         ///
         /// \returns Returns true if an entry was evicted or if the cache is not
         ///          full, and false if nothing could be evicted.
-        bool free_space()
+        bool free_space(shard& s)
         {
             // If the cache isn't full, just return true.
             if (connections_ < max_connections_)
                 return true;
 
+            if (evict_connections(s))
+                return true;
+
+            for (size_type i = 0; i != num_shards_; ++i)
+            {
+                shard& other = shards_[i];
+                if (&other == &s)
+                    continue;
+
+                std::unique_lock<mutex_type> lock(
+                    other.mtx_, std::try_to_lock);
+                if (lock.owns_lock() && evict_connections(other))
+                {
+                    check_invariants(other);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /// Evict the least recently used removable entries from the given
+        /// (locked) shard while the cache is full.
+        ///
+        /// \returns Returns true if the cache is not full anymore, and false
+        ///          if nothing more could be evicted from this shard.
+        bool evict_connections(shard& s)
+        {
             // Find the least recently used key.
-            typename key_tracker_type::iterator kt = key_tracker_.begin();
+            typename key_tracker_type::iterator kt = s.key_tracker_.begin();
 
             while (connections_ >= max_connections_)
             {
+                // If we've gone through key_tracker_ and haven't found
+                // anything evict-able, then all the entries must be
+                // currently checked out.
+                if (s.key_tracker_.end() == kt)
+                    return false;
+
                 // Find the least recently used keys data.
-                typename cache_type::iterator ct = cache_.find(*kt);
-                HPX_ASSERT(ct != cache_.end());
+                typename cache_type::iterator ct = s.cache_.find(*kt);
+                HPX_ASSERT(ct != s.cache_.end());
 
                 // If the entry is empty, ignore it and try the next least
                 // recently used entry.
@@ -590,9 +709,8 @@ namespace hpx { namespace util {
                     // Remove the key if its connection count is zero.
                     if (0 == num_existing_connections(ct->second))
                     {
-                        cache_.erase(ct);
-                        key_tracker_.erase(kt);
-                        kt = key_tracker_.begin();
+                        s.cache_.erase(ct);
+                        kt = s.key_tracker_.erase(kt);
                     }
                     else
                     {
@@ -600,13 +718,6 @@ namespace hpx { namespace util {
                         // the eviction?
                         ++kt;
                     }
-
-                    // If we've gone through key_tracker_ and haven't found
-                    // anything evict-able, then all the entries must be
-                    // currently checked out.
-                    if (key_tracker_.end() == kt)
-                        return false;
-
                     continue;
                 }
 
@@ -614,29 +725,23 @@ namespace hpx { namespace util {
                 cached_connections(ct->second).pop_front();
 
                 // Adjust the overall and per-locality connection count.
-                decrement_connection_count(ct->second);
+                decrement_connection_count(s, ct->second);
 
                 // Statistics
-                ++evictions_;
+                ++s.stats_.evictions_;
             }
 
             return true;
         }
 
-        mutable mutex_type mtx_;
         size_type const max_connections_;
         size_type const max_connections_per_locality_;
-        key_tracker_type key_tracker_;
-        cache_type cache_;
-        size_type connections_;
-        bool shutting_down_;
-
-        // statistics support
-        std::int64_t insertions_;
-        std::int64_t evictions_;
-        std::int64_t hits_;
-        std::int64_t misses_;
-        std::int64_t reclaims_;
+        size_type const num_shards_;
+        std::unique_ptr<shard_type[]> shards_;
+        Hash hash_;
+
+        std::atomic<size_type> connections_;
+        std::atomic<bool> shutting_down_;
     };
 }}    // namespace hpx::util
 
@@ -0,0 +1,387 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING)
+#include <hpx/assert.hpp>
+#include <hpx/modules/concurrency.hpp>
+#include <hpx/modules/coroutines.hpp>
+#include <hpx/modules/synchronization.hpp>
+#include <hpx/modules/timing.hpp>
+
+#include <hpx/components_base/component_type.hpp>
+#include <hpx/parcelset/parcel.hpp>
+#include <hpx/parcelset_base/locality.hpp>
+#include <hpx/parcelset_base/parcelport.hpp>
+#include <hpx/parcelset_base/parcelset_base_fwd.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hpx::parcelset::detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Return the outbound lane a parcel is sent through. Parcels for actions
+    // with a high priority and requests to the AGAS services use the
+    // priority lane to avoid being delayed by (possibly large) other parcels
+    // queued for the same destination.
+    inline parcelport::outbound_lane_type get_outbound_lane(
+        parcelset::parcel const& p)
+    {
+        if (p.get_thread_priority() >= threads::thread_priority::high_recursive)
+        {
+            return parcelport::outbound_lane_priority;
+        }
+
+        int const type = p.get_component_type();
+        if (type >= components::component_agas_locality_namespace &&
+            type <= components::component_agas_symbol_namespace)
+        {
+            return parcelport::outbound_lane_priority;
+        }
+        return parcelport::outbound_lane_normal;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Parcels waiting to be sent to one destination, separated into lanes
+    // (see parcelport::outbound_lane_type). Any number of threads may append
+    // parcels concurrently without taking a lock. A flush removes all
+    // parcels queued so far in one lane at once (in the order they were
+    // enqueued).
+    //
+    // The parcels of each lane are kept in a lock-free singly linked list
+    // (newest first), which is detached as a whole by a flush and reversed
+    // afterwards. Parcels which were flushed but could not be sent are given
+    // back through a second list per lane, those are returned first by the
+    // next flush.
+    class outbound_parcel_queue
+    {
+        using write_handler_type = parcel_write_handler_type;
+
+        struct node
+        {
+            node(parcelset::parcel&& p, write_handler_type&& f,
+                std::uint64_t time)
+              : p_(HPX_MOVE(p))
+              , f_(HPX_MOVE(f))
+              , time_(time)
+            {
+            }
+
+            parcelset::parcel p_;
+            write_handler_type f_;
+            std::uint64_t time_;    // time the parcel was enqueued
+            node* next_ = nullptr;
+        };
+
+        static constexpr std::size_t num_lanes = parcelport::num_outbound_lanes;
+
+    public:
+        explicit outbound_parcel_queue(locality const& destination)
+          : destination_(destination)
+        {
+        }
+
+        outbound_parcel_queue(outbound_parcel_queue const&) = delete;
+        outbound_parcel_queue(outbound_parcel_queue&&) = delete;
+        outbound_parcel_queue& operator=(outbound_parcel_queue const&) = delete;
+        outbound_parcel_queue& operator=(outbound_parcel_queue&&) = delete;
+
+        ~outbound_parcel_queue()
+        {
+            for (std::size_t lane = 0; lane != num_lanes; ++lane)
+            {
+                delete_list(fronts_[lane].load(std::memory_order_acquire));
+                delete_list(heads_[lane].load(std::memory_order_acquire));
+            }
+        }
+
+        locality const& destination() const noexcept
+        {
+            return destination_;
+        }
+
+        bool empty() const noexcept
+        {
+            for (std::size_t lane = 0; lane != num_lanes; ++lane)
+            {
+                if (!empty(static_cast<parcelport::outbound_lane_type>(lane)))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool empty(parcelport::outbound_lane_type lane) const noexcept
+        {
+            return fronts_[lane].load(std::memory_order_acquire) == nullptr &&
+                heads_[lane].load(std::memory_order_acquire) == nullptr;
+        }
+
+        // Append the given parcel, return the lane it was added to
+        parcelport::outbound_lane_type push(
+            parcelset::parcel&& p, write_handler_type&& f)
+        {
+            parcelport::outbound_lane_type const lane = get_outbound_lane(p);
+
+            node* n = new node(HPX_MOVE(p), HPX_MOVE(f),
+                hpx::chrono::high_resolution_clock::now());
+            push_list(heads_[lane], n, n);
+
+            return lane;
+        }
+
+        // Append the given parcels, return the number of parcels added to
+        // the priority lane
+        std::size_t push(std::vector<parcelset::parcel>&& parcels,
+            std::vector<write_handler_type>&& handlers)
+        {
+            return push(heads_, HPX_MOVE(parcels), HPX_MOVE(handlers));
+        }
+
+        // Give back parcels which were flushed but not sent, those will be
+        // returned by the next flush of their lane before any other parcels.
+        // Return the number of parcels added to the priority lane.
+        std::size_t push_front(std::vector<parcelset::parcel>&& parcels,
+            std::vector<write_handler_type>&& handlers)
+        {
+            return push(fronts_, HPX_MOVE(parcels), HPX_MOVE(handlers));
+        }
+
+        // Move all parcels queued in the given lane to the given (empty)
+        // vectors, return the number of parcels removed from the queue. The
+        // accumulated time the parcels waited in the queue (in nanoseconds)
+        // is added to wait_time.
+        std::size_t flush(parcelport::outbound_lane_type lane,
+            std::vector<parcelset::parcel>& parcels,
+            std::vector<write_handler_type>& handlers,
+            std::uint64_t& wait_time)
+        {
+            HPX_ASSERT(parcels.empty() && handlers.empty());
+
+            // restore the order in which the parcels were enqueued, parcels
+            // given back come first
+            std::size_t count = 0;
+            node* front = reverse_list(
+                fronts_[lane].exchange(nullptr, std::memory_order_acquire),
+                count);
+            node* rest = reverse_list(
+                heads_[lane].exchange(nullptr, std::memory_order_acquire),
+                count);
+            if (count == 0)
+            {
+                return 0;
+            }
+
+            std::uint64_t const now = hpx::chrono::high_resolution_clock::now();
+
+            parcels.reserve(count);
+            handlers.reserve(count);
+            for (node* list : {front, rest})
+            {
+                for (node* n = list; n != nullptr; n = n->next_)
+                {
+                    parcels.push_back(HPX_MOVE(n->p_));
+                    handlers.push_back(HPX_MOVE(n->f_));
+                    wait_time += now - n->time_;
+                }
+                delete_list(list);
+            }
+            return count;
+        }
+
+    private:
+        using lane_heads_type = std::atomic<node*>[num_lanes];
+
+        std::size_t push(lane_heads_type& heads,
+            std::vector<parcelset::parcel>&& parcels,
+            std::vector<write_handler_type>&& handlers)
+        {
+            HPX_ASSERT(parcels.size() == handlers.size());
+
+            // link all nodes of each lane (newest first) before publishing
+            // them with a single atomic operation per lane
+            node* first[num_lanes] = {};
+            node* last[num_lanes] = {};
+            std::size_t count[num_lanes] = {};
+
+            std::uint64_t const now = hpx::chrono::high_resolution_clock::now();
+            for (std::size_t i = 0; i != parcels.size(); ++i)
+            {
+                parcelport::outbound_lane_type const lane =
+                    get_outbound_lane(parcels[i]);
+
+                node* n =
+                    new node(HPX_MOVE(parcels[i]), HPX_MOVE(handlers[i]), now);
+                n->next_ = first[lane];
+                first[lane] = n;
+                if (last[lane] == nullptr)
+                {
+                    last[lane] = n;
+                }
+                ++count[lane];
+            }
+
+            parcels.clear();
+            handlers.clear();
+
+            for (std::size_t lane = 0; lane != num_lanes; ++lane)
+            {
+                if (first[lane] != nullptr)
+                {
+                    push_list(heads[lane], first[lane], last[lane]);
+                }
+            }
+
+            return count[parcelport::outbound_lane_priority];
+        }
+
+        static void push_list(
+            std::atomic<node*>& lane_head, node* first, node* last) noexcept
+        {
+            node* head = lane_head.load(std::memory_order_relaxed);
+            do
+            {
+                last->next_ = head;
+            } while (!lane_head.compare_exchange_weak(head, first,
+                std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // Reverse the given list, add the number of its nodes to count
+        static node* reverse_list(node* n, std::size_t& count) noexcept
+        {
+            node* reversed = nullptr;
+            while (n != nullptr)
+            {
+                node* next = n->next_;
+                n->next_ = reversed;
+                reversed = n;
+                n = next;
+                ++count;
+            }
+            return reversed;
+        }
+
+        static void delete_list(node* n) noexcept
+        {
+            while (n != nullptr)
+            {
+                node* next = n->next_;
+                delete n;
+                n = next;
+            }
+        }
+
+        locality const destination_;
+        lane_heads_type heads_ = {};
+        lane_heads_type fronts_ = {};    // parcels given back
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The per-destination outbound queues of a parcelport. Queues are
+    // created on first use and live as long as the parcelport.
+    //
+    // The queues are held in hash tables which are striped by destination,
+    // each protected by its own lock. Looking up a queue locks only the
+    // stripe of its destination for the duration of the lookup, the queue
+    // itself is accessed without a lock.
+    class outbound_parcel_queues
+    {
+        using mutex_type = hpx::spinlock;
+
+        static constexpr std::size_t num_shards = 16;
+
+        struct shard
+        {
+            mutable mutex_type mtx_;
+            std::unordered_map<locality, std::unique_ptr<outbound_parcel_queue>>
+                queues_;
+        };
+
+        using shard_type = util::cache_aligned_data_derived<shard>;
+
+    public:
+        outbound_parcel_queues() = default;
+
+        outbound_parcel_queues(outbound_parcel_queues const&) = delete;
+        outbound_parcel_queues(outbound_parcel_queues&&) = delete;
+        outbound_parcel_queues& operator=(
+            outbound_parcel_queues const&) = delete;
+        outbound_parcel_queues& operator=(outbound_parcel_queues&&) = delete;
+
+        // Return the queue for the given destination, nullptr if none exists
+        outbound_parcel_queue* find(locality const& dest) const
+        {
+            shard const& s = get_shard(dest);
+            std::lock_guard<mutex_type> l(s.mtx_);
+
+            auto it = s.queues_.find(dest);
+            return it != s.queues_.end() ? it->second.get() : nullptr;
+        }
+
+        // Return the queue for the given destination, create it if needed
+        outbound_parcel_queue& get(locality const& dest)
+        {
+            shard& s = get_shard(dest);
+            std::lock_guard<mutex_type> l(s.mtx_);
+
+            auto& q = s.queues_[dest];
+            if (!q)
+            {
+                q = std::make_unique<outbound_parcel_queue>(dest);
+            }
+            return *q;
+        }
+
+        // Call the given function for each queue holding parcels. The
+        // function is invoked without holding any lock.
+        template <typename F>
+        void for_each_pending(F&& f) const
+        {
+            std::vector<outbound_parcel_queue*> pending;
+            for (shard const& s : shards_)
+            {
+                std::lock_guard<mutex_type> l(s.mtx_);
+                for (auto const& q : s.queues_)
+                {
+                    if (!q.second->empty())
+                    {
+                        pending.push_back(q.second.get());
+                    }
+                }
+            }
+
+            for (outbound_parcel_queue* q : pending)
+            {
+                f(*q);
+            }
+        }
+
+    private:
+        shard& get_shard(locality const& dest)
+        {
+            return shards_[std::hash<locality>()(dest) % num_shards];
+        }
+        shard const& get_shard(locality const& dest) const
+        {
+            return shards_[std::hash<locality>()(dest) % num_shards];
+        }
+
+        shard_type shards_[num_shards];
+    };
+}    // namespace hpx::parcelset::detail
+
+#endif
@@ -252,6 +252,13 @@ namespace hpx::parcelset {
             use_alternative_parcelports_.store(false);
         }
 
+        /// \brief Establish the configured number of connections
+        /// (hpx.parcel.warmup_connections) to all other localities
+        ///
+        /// The connections are created asynchronously on separate HPX
+        /// threads, one for each of the remote localities.
+        void warm_up_connections();
+
         /// Return the reference to an existing io_service
         util::io_service_pool* get_thread_pool(char const* name);
 
@@ -361,6 +368,16 @@ namespace hpx::parcelset {
         std::int64_t get_connection_cache_statistics(std::string const& pp_type,
             parcelport::connection_cache_statistics_type stat_type, bool) const;
 
+        // the number of parcels currently queued in the given outbound lane
+        // of the given parcelport
+        std::int64_t get_pending_parcels_count(std::string const& pp_type,
+            parcelport::outbound_lane_type lane, bool reset) const;
+
+        // the average time the parcels sent from the given outbound lane of
+        // the given parcelport were queued (nanoseconds)
+        std::int64_t get_pending_parcels_wait_time(std::string const& pp_type,
+            parcelport::outbound_lane_type lane, bool reset) const;
+
         void list_parcelports(std::ostringstream& strm) const;
         void list_parcelport(std::ostringstream& strm,
             std::string const& ppname, int priority, bool bootstrap) const;
@@ -394,6 +411,8 @@ namespace hpx::parcelset {
     private:
         int get_priority(std::string const& name) const;
 
+        void warm_up_connections_to(naming::gid_type const& gid);
+
         parcelport* find_parcelport(
             std::string const& type, error_code& = throws) const;
 
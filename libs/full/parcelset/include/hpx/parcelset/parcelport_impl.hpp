@@ -28,6 +28,7 @@
 
 #include <hpx/parcelset/connection_cache.hpp>
 #include <hpx/parcelset/detail/call_for_each.hpp>
+#include <hpx/parcelset/detail/outbound_parcel_queues.hpp>
 #include <hpx/parcelset/detail/parcel_await.hpp>
 #include <hpx/parcelset/encode_parcels.hpp>
 #include <hpx/parcelset_base/parcelport.hpp>
@@ -107,6 +108,16 @@ namespace hpx::parcelset {
                 HPX_PARCEL_MAX_CONNECTIONS_PER_LOCALITY);
         }
 
+        static std::size_t warmup_connections(
+            util::runtime_configuration const& ini)
+        {
+            std::string key("hpx.parcel.");
+            key += connection_handler_type();
+
+            return hpx::util::get_entry_as<std::size_t>(
+                ini, key + ".warmup_connections", 0);
+        }
+
         static std::size_t zero_copy_serialization_threshold(
             util::runtime_configuration const& ini)
         {
@@ -129,6 +140,28 @@ namespace hpx::parcelset {
                 (std::numeric_limits<std::size_t>::max)());
         }
 
+        static util::io_service_pool::reactor_options io_pool_options(
+            util::runtime_configuration const& ini)
+        {
+            std::string key("hpx.parcel.");
+            key += connection_handler_type();
+
+            util::io_service_pool::reactor_options options;
+            options.affinity = hpx::util::get_entry_as<std::string>(
+                ini, key + ".io_pool_bind", "");
+            options.busy_poll = hpx::util::get_entry_as<int>(
+                                    ini, key + ".io_pool_busy_poll", 0) != 0;
+            options.busy_poll_spin_count =
+                hpx::util::get_entry_as<std::size_t>(ini,
+                    key + ".io_pool_busy_poll_spin_count",
+                    options.busy_poll_spin_count);
+            options.busy_poll_max_backoff = std::chrono::microseconds(
+                hpx::util::get_entry_as<std::int64_t>(ini,
+                    key + ".io_pool_busy_poll_max_backoff",
+                    options.busy_poll_max_backoff.count()));
+            return options;
+        }
+
     public:
         /// Construct the parcelport on the given locality.
         parcelport_impl(util::runtime_configuration const& ini,
@@ -144,7 +177,10 @@ namespace hpx::parcelset {
           , operations_in_flight_(0)
           , num_thread_(0)
           , max_background_thread_(max_background_threads(ini))
+          , warmup_connections_(warmup_connections(ini))
         {
+            io_service_pool_.set_reactor_options(io_pool_options(ini));
+
             std::string endian_out = get_config_entry("hpx.parcel.endian_out",
                 endian::native == endian::big ? "big" : "little");
             if (endian_out == "little")
@@ -312,6 +348,78 @@ namespace hpx::parcelset {
             send_early_parcel_impl(dest, HPX_MOVE(p));
         }
 
+        std::size_t get_warmup_connections() const override
+        {
+            if constexpr (connection_handler_traits<
+                              ConnectionHandler>::send_immediate_parcels::value)
+            {
+                return 0;
+            }
+            else
+            {
+                return warmup_connections_;
+            }
+        }
+
+        std::size_t warm_up_connections(locality const& dest) override
+        {
+            if constexpr (connection_handler_traits<
+                              ConnectionHandler>::send_immediate_parcels::value)
+            {
+                HPX_UNUSED(dest);
+                return 0;
+            }
+            else
+            {
+                // All connections are checked out of the cache while they are
+                // being established to prevent the cache from handing back an
+                // already existing connection more than once.
+                std::vector<std::shared_ptr<connection>> connections;
+                connections.reserve(warmup_connections_);
+
+                for (std::size_t i = 0; i != warmup_connections_; ++i)
+                {
+                    std::shared_ptr<connection> sender_connection;
+                    if (!connection_cache_.get_or_reserve(
+                            dest, sender_connection))
+                    {
+                        break;    // the connection limit has been reached
+                    }
+
+                    if (!sender_connection)
+                    {
+                        error_code ec(throwmode::lightweight);
+                        sender_connection =
+                            connection_handler().create_connection(dest, ec);
+                        if (ec || !sender_connection)
+                        {
+                            // give back the reserved space
+                            connection_cache_.clear(dest, sender_connection);
+                            break;
+                        }
+                    }
+
+                    connections.push_back(HPX_MOVE(sender_connection));
+                }
+
+                for (std::shared_ptr<connection> const& c : connections)
+                {
+                    connection_cache_.reclaim(dest, c);
+                }
+
+                // parcels which were queued while the connections were
+                // checked out need to be sent now
+                detail::outbound_parcel_queue const* q =
+                    pending_parcels_.find(dest);
+                if (q != nullptr && !q->empty())
+                {
+                    get_connection_and_send_parcels(dest);
+                }
+
+                return connections.size();
+            }
+        }
+
         util::io_service_pool* get_thread_pool(char const* name) override
         {
             if (0 == std::strcmp(name, io_service_pool_.get_name()))
@@ -552,7 +660,7 @@ namespace hpx::parcelset {
                     std::vector<write_handler_type> overflow_handlers(
                         std::make_move_iterator(fs + encoded_parcels),
                         std::make_move_iterator(fs + num_parcels));
-                    enqueue_parcels(dest_, HPX_MOVE(overflow_parcels),
+                    requeue_parcels(dest_, HPX_MOVE(overflow_parcels),
                         HPX_MOVE(overflow_handlers));
                 }
             }
@@ -569,7 +677,7 @@ namespace hpx::parcelset {
     private:
         ///////////////////////////////////////////////////////////////////////
         std::shared_ptr<connection> get_connection(
-            locality const& l, bool /* force */, error_code& ec)
+            locality const& l, bool force, error_code& ec)
         {
             // Request new connection from connection cache.
             std::shared_ptr<connection> sender_connection;
@@ -581,8 +689,11 @@ namespace hpx::parcelset {
             }
             else
             {
-                // Get a connection or reserve space for a new connection.
-                if (!connection_cache_.get_or_reserve(l, sender_connection))
+                // Get a connection or reserve space for a new connection
+                // (exceeding the connection limit for the destination by at
+                // most one connection if forced).
+                if (!connection_cache_.get_or_reserve(
+                        l, sender_connection, force))
                 {
                     // If no slot is available it's not a problem as the parcel
                     // will be sent out whenever the next connection is returned
@@ -609,158 +720,153 @@ namespace hpx::parcelset {
         void enqueue_parcel(
             locality const& locality_id, parcel&& p, write_handler_type&& f)
         {
-            using mapped_type = pending_parcels_map::mapped_type;
-
-            std::unique_lock l(mtx_);
-
-            // We ignore the lock here. It might happen that while enqueuing,
-            // we need to acquire a lock. This should not cause any problems
-            // (famous last words)
-            util::ignore_while_checking il(&l);
-            HPX_UNUSED(il);
-
-            mapped_type& e = pending_parcels_[locality_id];
-            hpx::get<0>(e).push_back(HPX_MOVE(p));
-            hpx::get<1>(e).push_back(HPX_MOVE(f));
-
-            parcel_destinations_.insert(locality_id);
-            ++num_parcel_destinations_;
+            num_pending_parcels_.fetch_add(1, std::memory_order_relaxed);
+            if (pending_parcels_.get(locality_id)
+                    .push(HPX_MOVE(p), HPX_MOVE(f)) == outbound_lane_priority)
+            {
+                num_pending_priority_parcels_.fetch_add(
+                    1, std::memory_order_relaxed);
+            }
         }
 
         void enqueue_parcels(locality const& locality_id,
             std::vector<parcel>&& parcels,
             std::vector<write_handler_type>&& handlers)
         {
-            using mapped_type = pending_parcels_map::mapped_type;
-
-            std::unique_lock l(mtx_);
-
-            // We ignore the lock here. It might happen that while enqueuing,
-            // we need to acquire a lock. This should not cause any problems
-            // (famous last words)
-            util::ignore_while_checking il(&l);
-            HPX_UNUSED(il);
-
             HPX_ASSERT(parcels.size() == handlers.size());
 
-            mapped_type& e = pending_parcels_[locality_id];
-            if (hpx::get<0>(e).empty())
+            num_pending_parcels_.fetch_add(
+                static_cast<std::int64_t>(parcels.size()),
+                std::memory_order_relaxed);
+            std::size_t const num_priority =
+                pending_parcels_.get(locality_id)
+                    .push(HPX_MOVE(parcels), HPX_MOVE(handlers));
+            if (num_priority != 0)
             {
-                HPX_ASSERT(hpx::get<1>(e).empty());
-                std::swap(hpx::get<0>(e), parcels);
-                std::swap(hpx::get<1>(e), handlers);
+                num_pending_priority_parcels_.fetch_add(
+                    static_cast<std::int64_t>(num_priority),
+                    std::memory_order_relaxed);
             }
-            else
-            {
-                HPX_ASSERT(hpx::get<0>(e).size() == hpx::get<1>(e).size());
-                std::size_t new_size = hpx::get<0>(e).size() + parcels.size();
-                hpx::get<0>(e).reserve(new_size);
+        }
 
-                std::move(parcels.begin(), parcels.end(),
-                    std::back_inserter(hpx::get<0>(e)));
-                hpx::get<1>(e).reserve(new_size);
-                std::move(handlers.begin(), handlers.end(),
-                    std::back_inserter(hpx::get<1>(e)));
-            }
+        // Give back parcels which were dequeued but not sent, those will be
+        // sent before any other parcels queued for the same destination.
+        void requeue_parcels(locality const& locality_id,
+            std::vector<parcel>&& parcels,
+            std::vector<write_handler_type>&& handlers)
+        {
+            HPX_ASSERT(parcels.size() == handlers.size());
 
-            parcel_destinations_.insert(locality_id);
-            ++num_parcel_destinations_;
+            num_pending_parcels_.fetch_add(
+                static_cast<std::int64_t>(parcels.size()),
+                std::memory_order_relaxed);
+            std::size_t const num_priority =
+                pending_parcels_.get(locality_id)
+                    .push_front(HPX_MOVE(parcels), HPX_MOVE(handlers));
+            if (num_priority != 0)
+            {
+                num_pending_priority_parcels_.fetch_add(
+                    static_cast<std::int64_t>(num_priority),
+                    std::memory_order_relaxed);
+            }
         }
 
         bool dequeue_parcels(locality const& locality_id,
             std::vector<parcel>& parcels,
             std::vector<write_handler_type>& handlers)
         {
-            using iterator = pending_parcels_map::iterator;
-
+            // do nothing if parcels have already been picked up by another
+            // thread
+            detail::outbound_parcel_queue* q =
+                pending_parcels_.find(locality_id);
+            if (q == nullptr)
             {
-                std::unique_lock l(mtx_, std::try_to_lock);
-                if (!l.owns_lock())
-                    return false;
-
-                iterator it = pending_parcels_.find(locality_id);
+                return false;
+            }
 
-                // do nothing if parcels have already been picked up by
-                // another thread
-                if (it != pending_parcels_.end() &&
-                    !hpx::get<0>(it->second).empty())
+            // parcels from the priority lane are sent first, parcels from
+            // different lanes are never sent together
+            for (outbound_lane_type lane :
+                {outbound_lane_priority, outbound_lane_normal})
+            {
+                std::uint64_t wait_time = 0;
+                std::size_t const count =
+                    q->flush(lane, parcels, handlers, wait_time);
+                if (count == 0)
                 {
-                    HPX_ASSERT(it->first == locality_id);
-                    HPX_ASSERT(handlers.size() == 0);
-                    HPX_ASSERT(handlers.size() == parcels.size());
-                    std::swap(parcels, hpx::get<0>(it->second));
-                    HPX_ASSERT(hpx::get<0>(it->second).size() == 0);
-                    std::swap(handlers, hpx::get<1>(it->second));
-                    HPX_ASSERT(handlers.size() == parcels.size());
-
-                    HPX_ASSERT(!handlers.empty());
+                    continue;
                 }
-                else
+
+                HPX_ASSERT(handlers.size() == parcels.size());
+                HPX_ASSERT(num_pending_parcels_.load() >=
+                    static_cast<std::int64_t>(count));
+                num_pending_parcels_.fetch_sub(static_cast<std::int64_t>(count),
+                    std::memory_order_relaxed);
+                if (lane == outbound_lane_priority)
                 {
-                    HPX_ASSERT(hpx::get<1>(it->second).empty());
-                    return false;
+                    num_pending_priority_parcels_.fetch_sub(
+                        static_cast<std::int64_t>(count),
+                        std::memory_order_relaxed);
                 }
 
-                parcel_destinations_.erase(locality_id);
-
-                HPX_ASSERT(0 != num_parcel_destinations_.load());
-                --num_parcel_destinations_;
+                lane_wait_time_[lane].fetch_add(
+                    static_cast<std::int64_t>(wait_time),
+                    std::memory_order_relaxed);
+                lane_num_sent_[lane].fetch_add(
+                    static_cast<std::int64_t>(count),
+                    std::memory_order_relaxed);
 
                 return true;
             }
+            return false;
         }
 
     protected:
         bool dequeue_parcel(
             locality& dest, parcel& p, write_handler_type& handler)
         {
-            std::unique_lock l(mtx_, std::try_to_lock);
-            if (!l.owns_lock())
-                return false;
+            bool result = false;
+            pending_parcels_.for_each_pending(
+                [&](detail::outbound_parcel_queue& q) {
+                    if (result)
+                    {
+                        return;
+                    }
 
-            for (auto& pending : pending_parcels_)
-            {
-                auto& parcels = hpx::get<0>(pending.second);
-                if (!parcels.empty())
-                {
-                    auto& handlers = hpx::get<1>(pending.second);
-                    dest = pending.first;
-                    p = HPX_MOVE(parcels.back());
-                    parcels.pop_back();
-                    handler = HPX_MOVE(handlers.back());
-                    handlers.pop_back();
-
-                    if (parcels.empty())
+                    std::vector<parcel> parcels;
+                    std::vector<write_handler_type> handlers;
+                    if (!dequeue_parcels(q.destination(), parcels, handlers))
                     {
-                        pending_parcels_.erase(dest);
+                        return;
                     }
-                    return true;
-                }
-            }
-            return false;
+
+                    dest = q.destination();
+                    p = HPX_MOVE(parcels.front());
+                    parcels.erase(parcels.begin());
+                    handler = HPX_MOVE(handlers.front());
+                    handlers.erase(handlers.begin());
+
+                    // give back the remaining parcels
+                    if (!parcels.empty())
+                    {
+                        requeue_parcels(
+                            dest, HPX_MOVE(parcels), HPX_MOVE(handlers));
+                    }
+                    result = true;
+                });
+            return result;
         }
 
         bool trigger_pending_work()
         {
-            if (0 == num_parcel_destinations_.load(std::memory_order_relaxed))
+            if (0 == num_pending_parcels_.load(std::memory_order_relaxed))
                 return true;
 
             std::vector<locality> destinations;
-
-            {
-                std::unique_lock l(mtx_, std::try_to_lock);
-                if (l.owns_lock())
-                {
-                    if (parcel_destinations_.empty())
-                        return true;
-
-                    destinations.reserve(parcel_destinations_.size());
-                    for (locality const& loc : parcel_destinations_)
-                    {
-                        destinations.push_back(loc);
-                    }
-                }
-            }
+            pending_parcels_.for_each_pending(
+                [&](detail::outbound_parcel_queue const& q) {
+                    destinations.push_back(q.destination());
+                });
 
             // Create new HPX threads which send the parcels that are still
             // pending.
@@ -784,9 +890,20 @@ namespace hpx::parcelset {
                 return;
             }
 
-            // If one of the sending threads are in suspended state, we
-            // need to force a new connection to avoid deadlocks.
-            bool force_connection = true;
+            // If one of the sending threads is suspended (e.g. while waiting
+            // for AGAS to resolve an id during serialization) while all
+            // connections to the destination are busy, parcels needed for it
+            // to resume could be stuck behind it. Parcels in the priority
+            // lane (which includes all AGAS traffic) are therefore allowed to
+            // force a new connection. The connection cache limits this to a
+            // single connection on top of the per-locality limit and keeps
+            // that connection for later reuse. If it is busy as well, the
+            // priority parcels are sent first by the next connection handed
+            // back to the cache (see dequeue_parcels).
+            detail::outbound_parcel_queue const* q =
+                pending_parcels_.find(locality_id);
+            bool const force_connection =
+                q != nullptr && !q->empty(outbound_lane_priority);
 
             error_code ec;
             std::shared_ptr<connection> sender_connection =
@@ -846,17 +963,12 @@ namespace hpx::parcelset {
                 connection_cache_.clear(locality_id, sender_connection);
             }
 
+            // HPX_ASSERT(locality_id == sender_connection->destination());
+            detail::outbound_parcel_queue const* q =
+                pending_parcels_.find(locality_id);
+            if (q == nullptr || q->empty())
             {
-                std::lock_guard l(mtx_);
-
-                // HPX_ASSERT(locality_id == sender_connection->destination());
-                pending_parcels_map::iterator it =
-                    pending_parcels_.find(locality_id);
-                if (it == pending_parcels_.end() ||
-                    hpx::get<0>(it->second).empty())
-                {
-                    return;
-                }
+                return;
             }
 
             // Create a new HPX thread which sends parcels that are still
@@ -927,7 +1039,7 @@ namespace hpx::parcelset {
                 handlers.erase(
                     handlers.begin(), handlers.begin() + num_parcels);
 
-                enqueue_parcels(
+                requeue_parcels(
                     parcel_locality_id, HPX_MOVE(parcels), HPX_MOVE(handlers));
             }
 
@@ -947,6 +1059,9 @@ namespace hpx::parcelset {
         /// The connection cache for sending connections
         util::connection_cache<connection, locality> connection_cache_;
 
+        /// The parcels waiting to be sent, one queue per destination
+        detail::outbound_parcel_queues pending_parcels_;
+
         using mutex_type = hpx::spinlock;
 
         int archive_flags_;
@@ -954,6 +1069,9 @@ namespace hpx::parcelset {
 
         std::atomic<std::size_t> num_thread_;
         std::size_t const max_background_thread_;
+
+        /// The number of connections to establish to each locality on startup
+        std::size_t const warmup_connections_;
     };
 }    // namespace hpx::parcelset
 
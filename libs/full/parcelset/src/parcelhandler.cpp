@@ -335,6 +335,61 @@ namespace hpx::parcelset {
         agas::remove_resolved_locality(gid);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    void parcelhandler::warm_up_connections()
+    {
+        bool needs_warmup = false;
+        for (pports_type::value_type const& pp : pports_)
+        {
+            if (pp.first > 0 && pp.second->get_warmup_connections() != 0)
+            {
+                needs_warmup = true;
+                break;
+            }
+        }
+
+        std::vector<naming::gid_type> locality_ids;
+        if (!needs_warmup || !get_raw_remote_localities(locality_ids))
+        {
+            return;
+        }
+
+        for (naming::gid_type const& gid : locality_ids)
+        {
+            threads::thread_init_data data(
+                threads::make_thread_function_nullary(util::deferred_call(
+                    &parcelhandler::warm_up_connections_to, this, gid)),
+                "parcelhandler::warm_up_connections",
+                threads::thread_priority::normal,
+                threads::thread_schedule_hint(),
+                threads::thread_stacksize::default_,
+                threads::thread_schedule_state::pending, true);
+            threads::register_thread(data);
+        }
+    }
+
+    void parcelhandler::warm_up_connections_to(naming::gid_type const& gid)
+    {
+        try
+        {
+            std::pair<std::shared_ptr<parcelport>, locality> dest =
+                find_appropriate_destination(gid);
+
+            std::size_t const count =
+                dest.first->warm_up_connections(dest.second);
+
+            LPT_(info).format("parcelhandler::warm_up_connections: "
+                              "established {} connection(s) to {}",
+                count, dest.second);
+        }
+        catch (hpx::exception const& e)
+        {
+            LPT_(warning).format("parcelhandler::warm_up_connections: "
+                                 "failed to connect to {}: {}",
+                gid, e.what());
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     bool parcelhandler::do_background_work(std::size_t num_thread,
         bool stop_buffering, parcelport_background_mode mode)
@@ -1184,6 +1239,24 @@ namespace hpx::parcelset {
         return pp ? pp->get_connection_cache_statistics(stat_type, reset) : 0;
     }
 
+    std::int64_t parcelhandler::get_pending_parcels_count(
+        std::string const& pp_type, parcelport::outbound_lane_type lane,
+        bool reset) const
+    {
+        error_code ec(throwmode::lightweight);
+        parcelport* pp = find_parcelport(pp_type, ec);
+        return pp ? pp->get_pending_parcels_count(lane, reset) : 0;
+    }
+
+    std::int64_t parcelhandler::get_pending_parcels_wait_time(
+        std::string const& pp_type, parcelport::outbound_lane_type lane,
+        bool reset) const
+    {
+        error_code ec(throwmode::lightweight);
+        parcelport* pp = find_parcelport(pp_type, ec);
+        return pp ? pp->get_pending_parcels_wait_time(lane, reset) : 0;
+    }
+
     std::vector<plugins::parcelport_factory_base*>&
     parcelhandler::get_parcelport_factories()
     {
@@ -1257,6 +1330,8 @@ namespace hpx::parcelset {
                 HPX_ZERO_COPY_SERIALIZATION_THRESHOLD) "}");
         ini_defs.emplace_back("max_background_threads = "
                               "${HPX_PARCEL_MAX_BACKGROUND_THREADS:-1}");
+        ini_defs.emplace_back(
+            "warmup_connections = ${HPX_PARCEL_WARMUP_CONNECTIONS:0}");
 
         for (plugins::parcelport_factory_base* f :
             parcelhandler::get_parcelport_factories())
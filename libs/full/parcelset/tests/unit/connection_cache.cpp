@@ -0,0 +1,185 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/modules/testing.hpp>
+#include <hpx/parcelset/connection_cache.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct connection
+{
+};
+
+using connection_type = std::shared_ptr<connection>;
+using cache_type = hpx::util::connection_cache<connection, int>;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_reuse()
+{
+    cache_type cache(16, 2, 4);
+
+    // reserve space for a new connection
+    connection_type c1;
+    HPX_TEST(cache.get_or_reserve(1, c1));
+    HPX_TEST(!c1);
+    c1 = std::make_shared<connection>();
+
+    connection_type c2;
+    HPX_TEST(cache.get_or_reserve(1, c2));
+    HPX_TEST(!c2);
+    c2 = std::make_shared<connection>();
+
+    // the per-locality limit has been reached
+    connection_type c3;
+    HPX_TEST(!cache.get_or_reserve(1, c3));
+    HPX_TEST(cache.full(1));
+    HPX_TEST(!cache.full(2));
+
+    // unless forced
+    HPX_TEST(cache.get_or_reserve(1, c3, true));
+    HPX_TEST(!c3);
+    cache.clear(1, c3);
+
+    // connections handed back are reused in FIFO order
+    cache.reclaim(1, c1);
+    cache.reclaim(1, c2);
+
+    connection_type c;
+    HPX_TEST(cache.get_or_reserve(1, c));
+    HPX_TEST(c == c1);
+    HPX_TEST(cache.get(1) == c2);
+    HPX_TEST(!cache.get(1));
+
+    cache.reclaim(1, c1);
+    cache.reclaim(1, c2);
+
+    HPX_TEST_EQ(cache.get_cache_insertions(true), 3);
+    HPX_TEST_EQ(cache.get_cache_hits(true), 2);
+    HPX_TEST_EQ(cache.get_cache_reclaims(true), 4);
+    HPX_TEST_EQ(cache.get_cache_evictions(true), 1);
+
+    cache.clear();
+    HPX_TEST(!cache.get(1));
+}
+
+// forced insertions may exceed the per-locality limit by a single connection,
+// which is kept when handed back
+void test_forced()
+{
+    cache_type cache(16, 2, 4);
+
+    std::vector<connection_type> connections;
+    for (int i = 0; i != 3; ++i)
+    {
+        connection_type c;
+        HPX_TEST(cache.get_or_reserve(1, c, true));
+        HPX_TEST(!c);
+        connections.push_back(std::make_shared<connection>());
+    }
+
+    connection_type c;
+    HPX_TEST(!cache.get_or_reserve(1, c, true));
+
+    for (connection_type const& conn : connections)
+    {
+        cache.reclaim(1, conn);
+    }
+    HPX_TEST_EQ(cache.get_cache_evictions(false), 0);
+    HPX_TEST_EQ(cache.get_cache_reclaims(false), 3);
+
+    // all connections are reused, no new connection can be created
+    for (connection_type const& conn : connections)
+    {
+        HPX_TEST(cache.get_or_reserve(1, c, true));
+        HPX_TEST(c == conn);
+    }
+    HPX_TEST(!cache.get_or_reserve(1, c, true));
+}
+
+// idle connections are evicted from other shards if the overall number of
+// connections has reached its limit
+void test_global_limit()
+{
+    constexpr std::size_t max_connections = 8;
+    cache_type cache(max_connections, 2, 4);
+
+    for (int l = 0; l != int(max_connections); ++l)
+    {
+        connection_type c;
+        HPX_TEST(cache.get_or_reserve(l, c));
+        HPX_TEST(!c);
+        cache.reclaim(l, std::make_shared<connection>());
+    }
+    HPX_TEST(cache.full());
+
+    connection_type c;
+    HPX_TEST(cache.get_or_reserve(int(max_connections), c));
+    HPX_TEST(!c);
+    HPX_TEST_EQ(cache.get_cache_evictions(false), 1);
+    HPX_TEST(cache.full());
+
+    cache.clear();
+    HPX_TEST(!cache.full());
+}
+
+// connections to different localities are handed out concurrently
+void test_concurrent()
+{
+    constexpr int num_threads = 8;
+    constexpr int iterations = 10000;
+
+    cache_type cache(4 * num_threads, 4);
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t != num_threads; ++t)
+    {
+        threads.emplace_back([&cache, t]() {
+            for (int i = 0; i != iterations; ++i)
+            {
+                int const l = (t + i) % (2 * num_threads);
+
+                connection_type c;
+                if (cache.get_or_reserve(l, c))
+                {
+                    if (!c)
+                    {
+                        c = std::make_shared<connection>();
+                    }
+                    cache.reclaim(l, c);
+                }
+            }
+        });
+    }
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    // the number of connections per locality is never exceeded
+    HPX_TEST_LTE(cache.get_cache_insertions(false) -
+            cache.get_cache_evictions(false),
+        std::int64_t(4 * 2 * num_threads));
+}
+
+int main()
+{
+    test_reuse();
+    test_forced();
+    test_global_limit();
+    test_concurrent();
+
+    return hpx::util::report_errors();
+}
+#endif
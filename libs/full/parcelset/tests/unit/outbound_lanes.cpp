@@ -0,0 +1,180 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that parcels are queued in the outbound lane matching their priority
+// and that the per-lane performance counters are available.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/parcelset/detail/outbound_parcel_queues.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const numparcels_default = 10;
+
+using hpx::parcelset::parcelport;
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::id_type test_lane(std::size_t)
+{
+    return hpx::find_here();
+}
+HPX_PLAIN_ACTION(test_lane)
+
+hpx::parcelset::parcel generate_parcel(hpx::id_type const& dest_id,
+    hpx::id_type const& cont, hpx::threads::thread_priority priority,
+    std::size_t data)
+{
+    hpx::naming::address addr;
+    hpx::naming::gid_type dest = dest_id.get_gid();
+    hpx::parcelset::parcel p(hpx::parcelset::detail::create_parcel::call(
+        std::move(dest), std::move(addr),
+        hpx::actions::typed_continuation<hpx::id_type>(cont),
+        test_lane_action(), priority, data));
+
+    p.set_source_id(hpx::find_here());
+    p.size() = 4096;
+    return p;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_lane_separation(hpx::id_type const& id)
+{
+    hpx::parcelset::detail::outbound_parcel_queue q(
+        hpx::parcelset::locality{});
+
+    std::vector<hpx::distributed::promise<hpx::id_type>> promises(
+        2 * numparcels_default);
+
+    // enqueue parcels alternating between normal and high priority
+    for (std::size_t i = 0; i != 2 * numparcels_default; ++i)
+    {
+        hpx::threads::thread_priority const priority = (i % 2) ?
+            hpx::threads::thread_priority::high_recursive :
+            hpx::threads::thread_priority::normal;
+
+        parcelport::outbound_lane_type const lane =
+            q.push(generate_parcel(id, promises[i].get_id(), priority, i),
+                [](std::error_code const&, hpx::parcelset::parcel const&) {});
+
+        HPX_TEST_EQ(lane,
+            (i % 2) ? parcelport::outbound_lane_priority :
+                      parcelport::outbound_lane_normal);
+    }
+
+    HPX_TEST(!q.empty(parcelport::outbound_lane_priority));
+    HPX_TEST(!q.empty(parcelport::outbound_lane_normal));
+
+    // each lane holds its parcels only, in the order they were enqueued
+    for (parcelport::outbound_lane_type lane :
+        {parcelport::outbound_lane_priority, parcelport::outbound_lane_normal})
+    {
+        std::vector<hpx::parcelset::parcel> parcels;
+        std::vector<hpx::parcelset::parcel_write_handler_type> handlers;
+        std::uint64_t wait_time = 0;
+
+        HPX_TEST_EQ(q.flush(lane, parcels, handlers, wait_time),
+            numparcels_default);
+        HPX_TEST_EQ(handlers.size(), numparcels_default);
+        HPX_TEST(q.empty(lane));
+
+        hpx::threads::thread_priority const expected =
+            lane == parcelport::outbound_lane_priority ?
+            hpx::threads::thread_priority::high_recursive :
+            hpx::threads::thread_priority::normal;
+
+        for (std::size_t i = 0; i != parcels.size(); ++i)
+        {
+            HPX_TEST(parcels[i].get_thread_priority() == expected);
+            HPX_TEST(hpx::parcelset::detail::get_outbound_lane(parcels[i]) ==
+                lane);
+        }
+    }
+    HPX_TEST(q.empty());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t get_counter_value(std::string const& name)
+{
+    hpx::performance_counters::performance_counter c(name);
+    return c.get_value<std::int64_t>(hpx::launch::sync);
+}
+
+void test_lane_counters(hpx::id_type const& id)
+{
+    // send parcels through both lanes
+    std::vector<hpx::future<hpx::id_type>> results;
+    std::vector<hpx::parcelset::parcel> parcels;
+    for (std::size_t i = 0; i != 2 * numparcels_default; ++i)
+    {
+        hpx::threads::thread_priority const priority = (i % 2) ?
+            hpx::threads::thread_priority::high_recursive :
+            hpx::threads::thread_priority::normal;
+
+        hpx::distributed::promise<hpx::id_type> p;
+        results.push_back(p.get_future());
+        parcels.push_back(generate_parcel(id, p.get_id(), priority, i));
+    }
+
+    hpx::get_runtime_distributed().get_parcel_handler().put_parcels(
+        std::move(parcels));
+
+    hpx::wait_all(results);
+    for (hpx::future<hpx::id_type>& f : results)
+    {
+        HPX_TEST_EQ(f.get(), id);
+    }
+
+    std::vector<std::string> types;
+    hpx::get_runtime_distributed().get_parcel_handler().enum_parcelports(
+        [&](std::string const& type) -> bool {
+            types.push_back(type);
+            return true;
+        });
+    HPX_TEST(!types.empty());
+
+    for (std::string const& type : types)
+    {
+        for (char const* lane : {"send-priority", "send-normal"})
+        {
+            std::string const length = hpx::util::format(
+                "/parcelqueue{{locality#0/total}}/length/{}/{}", type, lane);
+            std::string const time = hpx::util::format(
+                "/parcelqueue{{locality#0/total}}/time/{}/{}", type, lane);
+
+            HPX_TEST_LTE(std::int64_t(0), get_counter_value(length));
+            HPX_TEST_LTE(std::int64_t(0), get_counter_value(time));
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    for (hpx::id_type const& id : hpx::find_remote_localities())
+    {
+        test_lane_separation(id);
+        test_lane_counters(id);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
+#endif
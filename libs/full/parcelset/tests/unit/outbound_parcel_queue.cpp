@@ -0,0 +1,208 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that parcels pushed concurrently to an outbound_parcel_queue are
+// flushed exactly once and in the order they were pushed by each thread, and
+// that parcels given back are flushed first.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/parcelset/detail/outbound_parcel_queues.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_parcel() {}
+HPX_PLAIN_ACTION(test_parcel)
+
+using hpx::parcelset::parcelport;
+
+using queue_type = hpx::parcelset::detail::outbound_parcel_queue;
+using write_handler_type = hpx::parcelset::parcel_write_handler_type;
+
+// the parcels are identified by their (otherwise unused) size
+hpx::parcelset::parcel generate_parcel(std::size_t id)
+{
+    hpx::naming::address addr;
+    hpx::naming::gid_type dest = hpx::find_here().get_gid();
+    hpx::parcelset::parcel p(hpx::parcelset::detail::create_parcel::call(
+        std::move(dest), std::move(addr), test_parcel_action(),
+        hpx::threads::thread_priority::normal));
+
+    p.size() = id;
+    return p;
+}
+
+write_handler_type generate_handler()
+{
+    return [](std::error_code const&, hpx::parcelset::parcel const&) {};
+}
+
+std::vector<std::size_t> flush(queue_type& q)
+{
+    std::vector<hpx::parcelset::parcel> parcels;
+    std::vector<write_handler_type> handlers;
+    std::uint64_t wait_time = 0;
+
+    q.flush(parcelport::outbound_lane_normal, parcels, handlers, wait_time);
+    HPX_TEST_EQ(parcels.size(), handlers.size());
+
+    std::vector<std::size_t> result;
+    for (hpx::parcelset::parcel const& p : parcels)
+    {
+        result.push_back(p.size());
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_concurrent_push_flush()
+{
+    constexpr std::size_t num_producers = 4;
+    constexpr std::size_t num_parcels = 10000;
+    constexpr std::size_t batch_size = 10;
+
+    queue_type q{hpx::parcelset::locality{}};
+    std::atomic<std::size_t> done(0);
+
+    std::vector<hpx::future<void>> producers;
+    for (std::size_t producer = 0; producer != num_producers; ++producer)
+    {
+        producers.push_back(hpx::async([&, producer]() {
+            std::size_t i = 0;
+            while (i != num_parcels)
+            {
+                std::size_t const id = producer * num_parcels + i;
+
+                // alternate between pushing single parcels and batches
+                if ((i / batch_size) % 2 == 0)
+                {
+                    q.push(generate_parcel(id), generate_handler());
+                    ++i;
+                    continue;
+                }
+
+                std::vector<hpx::parcelset::parcel> parcels;
+                std::vector<write_handler_type> handlers;
+                for (std::size_t j = 0; j != batch_size; ++j)
+                {
+                    parcels.push_back(generate_parcel(id + j));
+                    handlers.push_back(generate_handler());
+                }
+                HPX_TEST_EQ(
+                    q.push(HPX_MOVE(parcels), HPX_MOVE(handlers)), 0u);
+                i += batch_size;
+            }
+            ++done;
+        }));
+    }
+
+    // flush concurrently until all parcels have been received
+    std::vector<std::size_t> next(num_producers, 0);
+    std::size_t received = 0;
+    while (received != num_producers * num_parcels)
+    {
+        bool const finished = done.load() == num_producers;
+
+        for (std::size_t id : flush(q))
+        {
+            std::size_t const producer = id / num_parcels;
+            HPX_TEST_EQ(id % num_parcels, next[producer]);
+            next[producer] = id % num_parcels + 1;
+            ++received;
+        }
+
+        if (finished)
+        {
+            break;
+        }
+        hpx::this_thread::yield();
+    }
+
+    hpx::wait_all(producers);
+
+    HPX_TEST_EQ(received, num_producers * num_parcels);
+    HPX_TEST(q.empty());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_push_front()
+{
+    queue_type q{hpx::parcelset::locality{}};
+
+    for (std::size_t i = 0; i != 3; ++i)
+    {
+        q.push(generate_parcel(i), generate_handler());
+    }
+    HPX_TEST((flush(q) == std::vector<std::size_t>{0, 1, 2}));
+
+    q.push(generate_parcel(3), generate_handler());
+
+    // parcels 1 and 2 could not be sent
+    std::vector<hpx::parcelset::parcel> parcels;
+    std::vector<write_handler_type> handlers;
+    for (std::size_t i = 1; i != 3; ++i)
+    {
+        parcels.push_back(generate_parcel(i));
+        handlers.push_back(generate_handler());
+    }
+    q.push_front(HPX_MOVE(parcels), HPX_MOVE(handlers));
+    HPX_TEST(!q.empty());
+
+    HPX_TEST((flush(q) == std::vector<std::size_t>{1, 2, 3}));
+    HPX_TEST(q.empty());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_queues()
+{
+    hpx::parcelset::detail::outbound_parcel_queues queues;
+    hpx::parcelset::locality const dest{};
+
+    HPX_TEST(queues.find(dest) == nullptr);
+
+    queue_type& q = queues.get(dest);
+    HPX_TEST(queues.find(dest) == &q);
+    HPX_TEST(&queues.get(dest) == &q);
+
+    std::size_t pending = 0;
+    queues.for_each_pending([&](queue_type&) { ++pending; });
+    HPX_TEST_EQ(pending, 0u);
+
+    q.push(generate_parcel(0), generate_handler());
+    queues.for_each_pending([&](queue_type& pq) {
+        HPX_TEST(&pq == &q);
+        ++pending;
+    });
+    HPX_TEST_EQ(pending, 1u);
+
+    HPX_TEST((flush(q) == std::vector<std::size_t>{0}));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_push_front();
+    test_queues();
+    test_concurrent_push_flush();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
+#endif
@@ -0,0 +1,105 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that the configured number of connections (hpx.parcel.
+// warmup_connections) is established to the other locality during startup,
+// before the application sends its first parcel, and that sending a parcel
+// reuses one of those connections.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+constexpr std::int64_t num_warmup_connections = 2;
+
+hpx::id_type test_warmup()
+{
+    return hpx::find_here();
+}
+HPX_PLAIN_ACTION(test_warmup)
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t get_counter_value(std::string const& type, char const* name)
+{
+    hpx::performance_counters::performance_counter c(hpx::util::format(
+        "/parcelport{{locality#0/total}}/count/{}/{}", type, name));
+    return c.get_value<std::int64_t>(hpx::launch::sync);
+}
+
+void test_warmup_connections(std::string const& type, hpx::id_type const& id)
+{
+    // the connections are established asynchronously during startup
+    auto const deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+    std::int64_t insertions = get_counter_value(type, "cache-insertions");
+    while (insertions < num_warmup_connections &&
+        std::chrono::steady_clock::now() < deadline)
+    {
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(10));
+        insertions = get_counter_value(type, "cache-insertions");
+    }
+    HPX_TEST_LTE(num_warmup_connections, insertions);
+
+    // sending a parcel reuses one of the cached connections
+    std::int64_t const hits = get_counter_value(type, "cache-hits");
+
+    HPX_TEST_EQ(test_warmup_action()(id), id);
+
+    HPX_TEST_LT(hits, get_counter_value(type, "cache-hits"));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    std::vector<std::string> types;
+    hpx::get_runtime_distributed().get_parcel_handler().enum_parcelports(
+        [&](std::string const& type) -> bool {
+            types.push_back(type);
+            return true;
+        });
+    HPX_TEST(!types.empty());
+
+    for (hpx::id_type const& id : hpx::find_remote_localities())
+    {
+        for (std::string const& type : types)
+        {
+            // this parcelport sends parcels immediately, without caching
+            // connections
+            if (type == "libfabric")
+            {
+                continue;
+            }
+            test_warmup_connections(type, id);
+        }
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.parcel.warmup_connections=" +
+        std::to_string(num_warmup_connections)};
+
+    hpx::init_params init_args;
+    init_args.cfg = cfg;
+
+    HPX_TEST_EQ(hpx::init(argc, argv, init_args), 0);
+    return hpx::util::report_errors();
+}
+#endif
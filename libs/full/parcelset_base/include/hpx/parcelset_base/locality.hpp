@@ -1,5 +1,5 @@
 //  Copyright (c)      2014 Thomas Heller
-//  Copyright (c) 2007-2021 Hartmut Kaiser
+//  Copyright (c) 2007-2022 Hartmut Kaiser
 //  Copyright (c) 2007 Richard D. Guidry Jr.
 //
 //  SPDX-License-Identifier: BSL-1.0
@@ -14,7 +14,10 @@
 #include <hpx/modules/errors.hpp>
 #include <hpx/modules/iterator_support.hpp>
 #include <hpx/modules/serialization.hpp>
+#include <hpx/modules/type_support.hpp>
 
+#include <cstddef>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -26,6 +29,12 @@
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace parcelset {
 
+    namespace detail {
+
+        template <typename Impl>
+        using locality_hash_t = decltype(std::declval<Impl const&>().hash());
+    }    // namespace detail
+
     //////////////////////////////////////////////////////////////////////////
     class HPX_EXPORT locality
     {
@@ -40,6 +49,7 @@ namespace hpx { namespace parcelset {
             virtual bool equal(impl_base const& rhs) const = 0;
             virtual bool less_than(impl_base const& rhs) const = 0;
             virtual bool valid() const = 0;
+            virtual std::size_t hash() const = 0;
             virtual const char* type() const = 0;
             virtual std::ostream& print(std::ostream& os) const = 0;
             virtual void save(serialization::output_archive& ar) const = 0;
@@ -91,6 +101,13 @@ namespace hpx { namespace parcelset {
             return impl_ ? impl_->type() : "";
         }
 
+        // Return a hash value for this locality, all localities of a
+        // parcelport type which does not provide a hash share the same value.
+        std::size_t hash() const
+        {
+            return impl_ ? impl_->hash() : 0;
+        }
+
         template <typename Impl>
         Impl& get()
         {
@@ -161,6 +178,19 @@ namespace hpx { namespace parcelset {
                 return !!impl_;
             }
 
+            std::size_t hash() const override
+            {
+                if constexpr (util::is_detected_v<detail::locality_hash_t,
+                                  Impl>)
+                {
+                    return impl_.hash();
+                }
+                else
+                {
+                    return 0;
+                }
+            }
+
             const char* type() const override
             {
                 return Impl::type();
@@ -202,4 +232,18 @@ namespace hpx { namespace parcelset {
         std::ostream& os, endpoints_type const& endpoints);
 }}    // namespace hpx::parcelset
 
+///////////////////////////////////////////////////////////////////////////////
+namespace std {
+
+    // specialize std::hash for hpx::parcelset::locality
+    template <>
+    struct hash<hpx::parcelset::locality>
+    {
+        std::size_t operator()(hpx::parcelset::locality const& l) const
+        {
+            return l.hash();
+        }
+    };
+}    // namespace std
+
 #include <hpx/config/warnings_suffix.hpp>
@@ -1,5 +1,5 @@
 //  Copyright (c) 2014-2015 Thomas Heller
-//  Copyright (c) 2007-2021 Hartmut Kaiser
+//  Copyright (c) 2007-2022 Hartmut Kaiser
 //  Copyright (c) 2007 Richard D Guidry Jr
 //  Copyright (c) 2011 Bryce Lelbach
 //  Copyright (c) 2011 Katelyn Kufahl
@@ -155,6 +155,19 @@ namespace hpx::parcelset {
         /// Cache specific functionality
         virtual void remove_from_connection_cache(locality const& loc) = 0;
 
+        /// Return the number of connections this parcelport establishes to
+        /// each of the other localities during startup (see
+        /// \a warm_up_connections). The default is to not establish any
+        /// connections ahead of time.
+        virtual std::size_t get_warmup_connections() const;
+
+        /// Establish connections to the given locality and place them into
+        /// the connection cache, so that they don't have to be created while
+        /// sending the first parcels.
+        ///
+        /// \returns The number of connections which were established.
+        virtual std::size_t warm_up_connections(locality const& dest);
+
         /// Return the thread pool if the name matches
         virtual util::io_service_pool* get_thread_pool(char const* name) = 0;
 
@@ -168,6 +181,16 @@ namespace hpx::parcelset {
             connection_cache_reclaims = 4
         };
 
+        /// The lanes outgoing parcels are queued in. Parcels in the priority
+        /// lane are never sent together with parcels from the normal lane
+        /// and may use additional connections to their destination.
+        enum outbound_lane_type
+        {
+            outbound_lane_normal = 0,
+            outbound_lane_priority = 1,
+            num_outbound_lanes = 2
+        };
+
         // invoke pending background work
         virtual bool do_background_work(
             std::size_t num_thread, parcelport_background_mode mode) = 0;
@@ -258,6 +281,15 @@ namespace hpx::parcelset {
 #endif
         std::int64_t get_pending_parcels_count(bool /*reset*/);
 
+        // the number of parcels currently queued in the given outbound lane
+        std::int64_t get_pending_parcels_count(
+            outbound_lane_type lane, bool reset);
+
+        // the average time the parcels sent from the given outbound lane
+        // were queued (nanoseconds)
+        std::int64_t get_pending_parcels_wait_time(
+            outbound_lane_type lane, bool reset);
+
         ///////////////////////////////////////////////////////////////////////
         /// Update performance counter data
 #if defined(HPX_HAVE_PARCELPORT_COUNTERS)
@@ -298,15 +330,15 @@ namespace hpx::parcelset {
         // mutex for all of the member data
         mutable hpx::spinlock mtx_;
 
-        // The cache for pending parcels
-        using map_second_type =
-            hpx::tuple<std::vector<parcel>, std::vector<write_handler_type>>;
-        using pending_parcels_map = std::map<locality, map_second_type>;
-        pending_parcels_map pending_parcels_;
+        // The number of parcels waiting to be sent (in all lanes and in the
+        // priority lane)
+        std::atomic<std::int64_t> num_pending_parcels_;
+        std::atomic<std::int64_t> num_pending_priority_parcels_;
 
-        using pending_parcels_destinations = std::set<locality>;
-        pending_parcels_destinations parcel_destinations_;
-        std::atomic<std::uint32_t> num_parcel_destinations_;
+        // The accumulated time parcels were queued and the number of parcels
+        // sent, per outbound lane
+        std::atomic<std::int64_t> lane_wait_time_[num_outbound_lanes] = {};
+        std::atomic<std::int64_t> lane_num_sent_[num_outbound_lanes] = {};
 
         // The local locality
         locality here_;
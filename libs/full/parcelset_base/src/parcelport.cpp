@@ -22,6 +22,7 @@
 
 #include <hpx/parcelset_base/parcelport.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
@@ -35,7 +36,8 @@ namespace hpx::parcelset {
     parcelport::parcelport(util::runtime_configuration const& ini,
         locality const& here, std::string const& type,
         std::size_t zero_copy_serialization_threshold)
-      : num_parcel_destinations_(0)
+      : num_pending_parcels_(0)
+      , num_pending_priority_parcels_(0)
       , here_(here)
       , max_inbound_message_size_(ini.get_max_inbound_message_size())
       , max_outbound_message_size_(ini.get_max_outbound_message_size())
@@ -99,6 +101,16 @@ namespace hpx::parcelset {
         return use_alternative_parcelport || can_bootstrap();
     }
 
+    std::size_t parcelport::get_warmup_connections() const
+    {
+        return 0;
+    }
+
+    std::size_t parcelport::warm_up_connections(locality const&)
+    {
+        return 0;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Update performance counter data
 #if defined(HPX_HAVE_PARCELPORT_COUNTERS)
@@ -277,15 +289,29 @@ namespace hpx::parcelset {
 #endif
     std::int64_t parcelport::get_pending_parcels_count(bool /*reset*/)
     {
-        std::lock_guard<hpx::spinlock> l(mtx_);
-        std::int64_t count = 0;
-        for (auto&& p : pending_parcels_)
+        return num_pending_parcels_.load(std::memory_order_relaxed);
+    }
+
+    std::int64_t parcelport::get_pending_parcels_count(
+        outbound_lane_type lane, bool /*reset*/)
+    {
+        std::int64_t const priority =
+            num_pending_priority_parcels_.load(std::memory_order_relaxed);
+        if (lane == outbound_lane_priority)
         {
-            count += hpx::get<0>(p.second).size();
-            HPX_ASSERT(
-                hpx::get<0>(p.second).size() == hpx::get<1>(p.second).size());
+            return priority;
         }
-        return count;
+        return num_pending_parcels_.load(std::memory_order_relaxed) - priority;
+    }
+
+    std::int64_t parcelport::get_pending_parcels_wait_time(
+        outbound_lane_type lane, bool reset)
+    {
+        std::int64_t const wait_time =
+            util::get_and_reset_value(lane_wait_time_[lane], reset);
+        std::int64_t const num_sent =
+            util::get_and_reset_value(lane_num_sent_[lane], reset);
+        return num_sent == 0 ? 0 : wait_time / num_sent;
     }
 
     ///////////////////////////////////////////////////////////////////////////
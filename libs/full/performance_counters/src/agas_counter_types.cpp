@@ -1,4 +1,4 @@
-//  Copyright (c) 2011-2021 Hartmut Kaiser
+//  Copyright (c) 2011-2022 Hartmut Kaiser
 //  Copyright (c) 2016 Parsa Amini
 //
 //  SPDX-License-Identifier: BSL-1.0
@@ -7,6 +7,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/agas/addressing_service.hpp>
+#include <hpx/agas_base/server/symbol_namespace.hpp>
 #include <hpx/functional/bind.hpp>
 #include <hpx/functional/bind_front.hpp>
 #include <hpx/functional/function.hpp>
@@ -65,6 +66,27 @@ namespace hpx { namespace performance_counters {
                 &agas::addressing_service::get_cache_erase_entry_time,
                 &client));
 
+        hpx::function<std::int64_t(bool)> refcnt_decref_requests(
+            hpx::bind_front(
+                &agas::addressing_service::get_refcnt_decref_requests,
+                &client));
+        hpx::function<std::int64_t(bool)> refcnt_decref_parcels(
+            hpx::bind_front(
+                &agas::addressing_service::get_refcnt_decref_parcels,
+                &client));
+        hpx::function<std::int64_t(bool)> refcnt_parcels_saved(
+            hpx::bind_front(
+                &agas::addressing_service::get_refcnt_parcels_saved, &client));
+
+        using symbol_counter_data =
+            agas::server::symbol_namespace::counter_data;
+        symbol_counter_data& symbol_data =
+            client.get_local_symbol_namespace_service().counter_data_;
+        hpx::function<std::int64_t(bool)> symbol_cache_hits(hpx::bind_front(
+            &symbol_counter_data::get_cache_hits, &symbol_data));
+        hpx::function<std::int64_t(bool)> symbol_cache_misses(hpx::bind_front(
+            &symbol_counter_data::get_cache_misses, &symbol_data));
+
         using placeholders::_1;
         using placeholders::_2;
         performance_counters::generic_counter_type_data const counter_types[] =
@@ -196,6 +218,57 @@ namespace hpx { namespace performance_counters {
                         &performance_counters::locality_raw_counter_creator, _1,
                         cache_erase_entry_time, _2),
                     &performance_counters::locality_counter_discoverer, ""},
+                {"/agas/count/refcnt/decref-requests",
+                    performance_counters::counter_type::
+                        monotonically_increasing,
+                    "returns the number of credit decrement requests buffered "
+                    "by this locality",
+                    HPX_PERFORMANCE_COUNTER_V1,
+                    hpx::bind(
+                        &performance_counters::locality_raw_counter_creator, _1,
+                        refcnt_decref_requests, _2),
+                    &performance_counters::locality_counter_discoverer, ""},
+                {"/agas/count/refcnt/decref-parcels",
+                    performance_counters::counter_type::
+                        monotonically_increasing,
+                    "returns the number of parcels sent by this locality to "
+                    "flush buffered credit decrement requests",
+                    HPX_PERFORMANCE_COUNTER_V1,
+                    hpx::bind(
+                        &performance_counters::locality_raw_counter_creator, _1,
+                        refcnt_decref_parcels, _2),
+                    &performance_counters::locality_counter_discoverer, ""},
+                {"/agas/count/refcnt/parcels-saved",
+                    performance_counters::counter_type::
+                        monotonically_increasing,
+                    "returns the number of reference count parcels avoided by "
+                    "this locality by combining or locally compensating "
+                    "credit requests",
+                    HPX_PERFORMANCE_COUNTER_V1,
+                    hpx::bind(
+                        &performance_counters::locality_raw_counter_creator, _1,
+                        refcnt_parcels_saved, _2),
+                    &performance_counters::locality_counter_discoverer, ""},
+                {"/agas/count/symbol-cache/hits",
+                    performance_counters::counter_type::
+                        monotonically_increasing,
+                    "returns the number of names owned by other localities "
+                    "which were resolved from the local cache",
+                    HPX_PERFORMANCE_COUNTER_V1,
+                    hpx::bind(
+                        &performance_counters::locality_raw_counter_creator, _1,
+                        symbol_cache_hits, _2),
+                    &performance_counters::locality_counter_discoverer, ""},
+                {"/agas/count/symbol-cache/misses",
+                    performance_counters::counter_type::
+                        monotonically_increasing,
+                    "returns the number of names owned by other localities "
+                    "which were not found in the local cache",
+                    HPX_PERFORMANCE_COUNTER_V1,
+                    hpx::bind(
+                        &performance_counters::locality_raw_counter_creator, _1,
+                        symbol_cache_misses, _2),
+                    &performance_counters::locality_counter_discoverer, ""},
             };
 
         performance_counters::install_counter_types(
@@ -9,14 +9,17 @@
 #if defined(HPX_HAVE_NETWORKING)
 #include <hpx/modules/format.hpp>
 #include <hpx/modules/functional.hpp>
+#include <hpx/modules/io_service.hpp>
 #include <hpx/parcelset/parcelhandler.hpp>
 #include <hpx/performance_counters/counter_creators.hpp>
 #include <hpx/performance_counters/counters.hpp>
 #include <hpx/performance_counters/manage_counter_type.hpp>
 #include <hpx/performance_counters/parcelhandler_counter_types.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace hpx::performance_counters {
 
@@ -453,6 +456,151 @@ namespace hpx::performance_counters {
             sizeof(connection_cache_types) / sizeof(connection_cache_types[0]));
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // register performance counters related to the outbound lanes
+    void register_outbound_lane_counter_types(
+        parcelset::parcelhandler& ph, std::string const& pp_type)
+    {
+        if (!ph.is_networking_enabled())
+        {
+            return;
+        }
+
+        using hpx::placeholders::_1;
+        using hpx::placeholders::_2;
+
+        using parcelset::parcelhandler;
+        using parcelset::parcelport;
+
+        hpx::function<std::int64_t(bool)> priority_lane_count(
+            hpx::bind_front(&parcelhandler::get_pending_parcels_count, &ph,
+                pp_type, parcelport::outbound_lane_priority));
+        hpx::function<std::int64_t(bool)> normal_lane_count(
+            hpx::bind_front(&parcelhandler::get_pending_parcels_count, &ph,
+                pp_type, parcelport::outbound_lane_normal));
+        hpx::function<std::int64_t(bool)> priority_lane_time(
+            hpx::bind_front(&parcelhandler::get_pending_parcels_wait_time, &ph,
+                pp_type, parcelport::outbound_lane_priority));
+        hpx::function<std::int64_t(bool)> normal_lane_time(
+            hpx::bind_front(&parcelhandler::get_pending_parcels_wait_time, &ph,
+                pp_type, parcelport::outbound_lane_normal));
+
+        performance_counters::generic_counter_type_data const
+            outbound_lane_types[] = {
+                {hpx::util::format(
+                     "/parcelqueue/length/{}/send-priority", pp_type),
+                    performance_counters::counter_type::raw,
+                    hpx::util::format(
+                        "returns the number of parcels currently queued in "
+                        "the priority lane of the {} connection type on the "
+                        "referenced locality",
+                        pp_type),
+                    HPX_PERFORMANCE_COUNTER_V1,
+                    hpx::bind(
+                        &performance_counters::locality_raw_counter_creator, _1,
+                        HPX_MOVE(priority_lane_count), _2),
+                    &performance_counters::locality_counter_discoverer, ""},
+                {hpx::util::format(
+                     "/parcelqueue/length/{}/send-normal", pp_type),
+                    performance_counters::counter_type::raw,
+                    hpx::util::format(
+                        "returns the number of parcels currently queued in "
+                        "the normal lane of the {} connection type on the "
+                        "referenced locality",
+                        pp_type),
+                    HPX_PERFORMANCE_COUNTER_V1,
+                    hpx::bind(
+                        &performance_counters::locality_raw_counter_creator, _1,
+                        HPX_MOVE(normal_lane_count), _2),
+                    &performance_counters::locality_counter_discoverer, ""},
+                {hpx::util::format(
+                     "/parcelqueue/time/{}/send-priority", pp_type),
+                    performance_counters::counter_type::average_timer,
+                    hpx::util::format(
+                        "returns the average time parcels sent through the "
+                        "priority lane of the {} connection type were queued "
+                        "on the referenced locality",
+                        pp_type),
+                    HPX_PERFORMANCE_COUNTER_V1,
+                    hpx::bind(
+                        &performance_counters::locality_raw_counter_creator, _1,
+                        HPX_MOVE(priority_lane_time), _2),
+                    &performance_counters::locality_counter_discoverer, "ns"},
+                {hpx::util::format("/parcelqueue/time/{}/send-normal", pp_type),
+                    performance_counters::counter_type::average_timer,
+                    hpx::util::format(
+                        "returns the average time parcels sent through the "
+                        "normal lane of the {} connection type were queued on "
+                        "the referenced locality",
+                        pp_type),
+                    HPX_PERFORMANCE_COUNTER_V1,
+                    hpx::bind(
+                        &performance_counters::locality_raw_counter_creator, _1,
+                        HPX_MOVE(normal_lane_time), _2),
+                    &performance_counters::locality_counter_discoverer, "ns"}};
+
+        performance_counters::install_counter_types(outbound_lane_types,
+            sizeof(outbound_lane_types) / sizeof(outbound_lane_types[0]));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // register performance counters reporting the per-thread statistics of
+    // the io_service_pool (the reactor threads) of the given parcelport
+    void register_io_pool_counter_types(
+        parcelset::parcelhandler& ph, std::string const& pp_type)
+    {
+        if (!ph.is_networking_enabled())
+        {
+            return;
+        }
+
+        std::string const pool_name =
+            hpx::util::format("parcel-pool-{}", pp_type);
+        util::io_service_pool* pool = ph.get_thread_pool(pool_name.c_str());
+        if (pool == nullptr)
+        {
+            return;
+        }
+
+        using value_getter_type =
+            std::int64_t (util::io_service_pool::*)(std::size_t, bool);
+
+        auto get_values = [pool](value_getter_type f, bool reset) {
+            std::vector<std::int64_t> result(pool->size());
+            for (std::size_t i = 0; i != result.size(); ++i)
+            {
+                result[i] = (pool->*f)(i, reset);
+            }
+            return result;
+        };
+
+        performance_counters::install_counter_type(
+            hpx::util::format("/parcels/io-pool/{}/count/events", pp_type),
+            hpx::function<std::vector<std::int64_t>(bool)>(
+                [get_values](bool reset) {
+                    return get_values(
+                        &util::io_service_pool::get_events_handled, reset);
+                }),
+            hpx::util::format(
+                "returns the number of events handled by each of the I/O "
+                "threads of the {} parcelport on the referenced locality",
+                pp_type));
+
+        performance_counters::install_counter_type(
+            hpx::util::format("/parcels/io-pool/{}/time/polling", pp_type),
+            hpx::function<std::vector<std::int64_t>(bool)>(
+                [get_values](bool reset) {
+                    return get_values(
+                        &util::io_service_pool::get_polling_time, reset);
+                }),
+            hpx::util::format(
+                "returns the time spent by each of the I/O threads of the {} "
+                "parcelport polling for events without handling any "
+                "(busy-poll mode only) on the referenced locality",
+                pp_type),
+            "ns");
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     void register_parcelhandler_counter_types(parcelset::parcelhandler& ph)
     {
@@ -460,6 +608,8 @@ namespace hpx::performance_counters {
         ph.enum_parcelports([&](std::string const& type) -> bool {
             register_parcelhandler_counter_types(ph, type);
             register_connection_cache_counter_types(ph, type);
+            register_outbound_lane_counter_types(ph, type);
+            register_io_pool_counter_types(ph, type);
             return true;
         });
 
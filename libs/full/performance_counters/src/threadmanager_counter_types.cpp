@@ -245,6 +245,87 @@ namespace hpx { namespace performance_counters { namespace detail {
         return naming::invalid_gid;
     }
 
+    ///////////////////////////////////////////////////////////////////////
+    using elasticity_counter_func =
+        std::int64_t (threads::elastic_pool_controller::*)(bool reset);
+
+    // accumulate the counter values of the elasticity controllers of all
+    // pools (pool_index == -1) or of the given pool, pools without a
+    // controller contribute zero
+    std::int64_t get_elasticity_counter_value(threads::threadmanager* tm,
+        elasticity_counter_func func, std::size_t pool_index, bool reset)
+    {
+        std::int64_t result = 0;
+        std::size_t const num_pools = hpx::resource::get_num_thread_pools();
+        for (std::size_t i = 0; i != num_pools; ++i)
+        {
+            if (pool_index != std::size_t(-1) && i != pool_index)
+            {
+                continue;
+            }
+
+            threads::elastic_pool_controller* controller =
+                tm->get_elastic_controller(i);
+            if (controller != nullptr)
+            {
+                result += (controller->*func)(reset);
+            }
+        }
+        return result;
+    }
+
+    // elasticity controller counter creation function
+    // /threads{locality#%d/total}/elasticity/...
+    // /threads{locality#%d/pool#%s/total}/elasticity/...
+    naming::gid_type elasticity_counter_creator(threads::threadmanager* tm,
+        elasticity_counter_func func, counter_info const& info,
+        error_code& ec)
+    {
+        // verify the validity of the counter instance name
+        counter_path_elements paths;
+        get_counter_path_elements(info.fullname_, paths, ec);
+        if (ec)
+        {
+            return naming::invalid_gid;
+        }
+        if (paths.parentinstance_is_basename_)
+        {
+            HPX_THROWS_IF(ec, bad_parameter, "elasticity_counter_creator",
+                "invalid counter instance parent name: {}",
+                paths.parentinstancename_);
+            return naming::invalid_gid;
+        }
+
+        using detail::create_raw_counter;
+
+        if (paths.instancename_ == "total" && paths.instanceindex_ == -1)
+        {
+            // counter for all pools
+            hpx::function<std::int64_t(bool)> f =
+                hpx::bind_front(&get_elasticity_counter_value, tm, func,
+                    std::size_t(-1));
+            return create_raw_counter(info, HPX_MOVE(f), ec);
+        }
+        else if (paths.instancename_ == "pool")
+        {
+            std::size_t const pool_index = paths.instanceindex_ < 0 ?
+                std::size_t(0) :
+                std::size_t(paths.instanceindex_);
+
+            if (pool_index < hpx::resource::get_num_thread_pools())
+            {
+                // counter specific for given pool
+                hpx::function<std::int64_t(bool)> f = hpx::bind_front(
+                    &get_elasticity_counter_value, tm, func, pool_index);
+                return create_raw_counter(info, HPX_MOVE(f), ec);
+            }
+        }
+
+        HPX_THROWS_IF(ec, bad_parameter, "elasticity_counter_creator",
+            "invalid counter instance name: {}", paths.instancename_);
+        return naming::invalid_gid;
+    }
+
     ///////////////////////////////////////////////////////////////////////
     bool locality_allocator_counter_discoverer(counter_info const& info,
         discover_counter_func const& f, discover_counters_mode mode,
@@ -773,6 +854,32 @@ namespace hpx { namespace performance_counters {
                 hpx::bind_front(
                     &detail::scheduler_utilization_counter_creator, &tm),
                 &locality_pool_counter_discoverer, "%"},
+            // elasticity controller
+            {"/threads/elasticity/suspended-processing-units",
+                counter_type::raw,
+                "returns the number of processing units currently suspended "
+                "by the elasticity controller",
+                HPX_PERFORMANCE_COUNTER_V1,
+                hpx::bind_front(&detail::elasticity_counter_creator, &tm,
+                    &threads::elastic_pool_controller::
+                        get_suspended_processing_units),
+                &locality_pool_counter_discoverer, ""},
+            {"/threads/elasticity/count/suspensions",
+                counter_type::monotonically_increasing,
+                "returns the number of times the elasticity controller "
+                "suspended a processing unit",
+                HPX_PERFORMANCE_COUNTER_V1,
+                hpx::bind_front(&detail::elasticity_counter_creator, &tm,
+                    &threads::elastic_pool_controller::get_suspension_count),
+                &locality_pool_counter_discoverer, ""},
+            {"/threads/elasticity/count/resumptions",
+                counter_type::monotonically_increasing,
+                "returns the number of times the elasticity controller "
+                "resumed a processing unit",
+                HPX_PERFORMANCE_COUNTER_V1,
+                hpx::bind_front(&detail::elasticity_counter_creator, &tm,
+                    &threads::elastic_pool_controller::get_resumption_count),
+                &locality_pool_counter_discoverer, ""},
             // idle-loop count
             {"/threads/idle-loop-count/instantaneous", counter_type::raw,
                 "returns the current value of the scheduler idle-loop count",
@@ -98,6 +98,10 @@ namespace hpx::plugins {
                 "max_connections_per_locality = ${HPX_PARCEL_" + name_uc +
                 "_MAX_CONNECTIONS_PER_LOCALITY:"
                 "$[hpx.parcel.max_connections_per_locality]}");
+            fillini.emplace_back("warmup_connections = ${HPX_PARCEL_" +
+                name_uc +
+                "_WARMUP_CONNECTIONS:"
+                "$[hpx.parcel.warmup_connections]}");
             fillini.emplace_back("max_message_size =  ${HPX_PARCEL_" + name_uc +
                 "_MAX_MESSAGE_SIZE:$[hpx.parcel.max_message_size]}");
             fillini.emplace_back("max_outbound_message_size =  ${HPX_PARCEL_" +
@@ -122,6 +126,16 @@ namespace hpx::plugins {
                 name_uc +
                 "_ASYNC_SERIALIZATION:"
                 "$[hpx.parcel.async_serialization]}");
+            fillini.emplace_back("io_pool_bind = ${HPX_PARCEL_" + name_uc +
+                "_IO_POOL_BIND:}");
+            fillini.emplace_back("io_pool_busy_poll = ${HPX_PARCEL_" +
+                name_uc + "_IO_POOL_BUSY_POLL:0}");
+            fillini.emplace_back(
+                "io_pool_busy_poll_spin_count = ${HPX_PARCEL_" + name_uc +
+                "_IO_POOL_BUSY_POLL_SPIN_COUNT:1000}");
+            fillini.emplace_back(
+                "io_pool_busy_poll_max_backoff = ${HPX_PARCEL_" + name_uc +
+                "_IO_POOL_BUSY_POLL_MAX_BACKOFF:100}");
             fillini.emplace_back("priority = ${HPX_PARCEL_" + name_uc +
                 "_PRIORITY:" +
                 traits::plugin_config_data<Parcelport>::priority() + "}");
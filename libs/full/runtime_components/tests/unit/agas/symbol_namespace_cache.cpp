@@ -0,0 +1,147 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that names resolved from other localities are not used anymore
+// after having been unregistered.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/agas/addressing_service.hpp>
+#include <hpx/agas_base/server/symbol_namespace.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct test_server : hpx::components::component_base<test_server>
+{
+};
+
+typedef hpx::components::component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server)
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const test_basename = "/symbol_namespace_cache_test/";
+constexpr std::size_t num_names = 64;
+
+// replace the component registered with the given sequence number
+void rebind(std::size_t sequence_nr, hpx::id_type const& id)
+{
+    hpx::id_type const old_id =
+        hpx::unregister_with_basename(test_basename, sequence_nr).get();
+    HPX_TEST_NEQ(old_id, hpx::invalid_id);
+    HPX_TEST(hpx::register_with_basename(test_basename, id, sequence_nr).get());
+}
+HPX_PLAIN_ACTION(rebind, rebind_action)
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<hpx::id_type> find_all()
+{
+    std::vector<hpx::future<hpx::id_type>> lazy_ids =
+        hpx::find_all_from_basename(test_basename, num_names);
+
+    std::vector<hpx::id_type> ids;
+    ids.reserve(num_names);
+    for (hpx::future<hpx::id_type>& f : lazy_ids)
+    {
+        ids.push_back(f.get());
+    }
+    return ids;
+}
+
+std::int64_t get_cache_hits()
+{
+    return hpx::naming::get_agas_client()
+        .get_local_symbol_namespace_service()
+        .counter_data_.get_cache_hits(false);
+}
+
+void test_symbol_namespace_cache(hpx::id_type const& there)
+{
+    std::vector<hpx::id_type> components;
+    for (std::size_t i = 0; i != num_names; ++i)
+    {
+        components.push_back(hpx::new_<test_server>(there).get());
+        HPX_TEST(hpx::register_with_basename(test_basename, components[i], i)
+                     .get());
+    }
+
+    // the names are distributed over all localities, resolving them again
+    // is served from the cache for the names owned by other localities
+    std::int64_t hits = get_cache_hits();
+    for (int round = 0; round != 2; ++round)
+    {
+        std::vector<hpx::id_type> ids = find_all();
+        for (std::size_t i = 0; i != num_names; ++i)
+        {
+            HPX_TEST_EQ(ids[i], components[i]);
+            HPX_TEST_EQ(hpx::agas::resolve_name(hpx::launch::sync,
+                            std::string(test_basename) + std::to_string(i)),
+                components[i]);
+        }
+
+        if (round != 0 && !hpx::find_remote_localities().empty())
+        {
+            HPX_TEST_LT(hits, get_cache_hits());
+        }
+        hits = get_cache_hits();
+    }
+
+    // replace the components locally
+    for (std::size_t i = 0; i != num_names; i += 2)
+    {
+        components[i] = hpx::new_<test_server>(there).get();
+        rebind(i, components[i]);
+    }
+
+    // replace the components from the other locality
+    std::vector<hpx::future<void>> rebound;
+    for (std::size_t i = 1; i < num_names; i += 2)
+    {
+        components[i] = hpx::new_<test_server>(there).get();
+        rebound.push_back(hpx::async(rebind_action(), there, i, components[i]));
+    }
+    hpx::wait_all(rebound);
+
+    // no stale entries are returned
+    std::vector<hpx::id_type> ids = find_all();
+    for (std::size_t i = 0; i != num_names; ++i)
+    {
+        HPX_TEST_EQ(ids[i], components[i]);
+    }
+
+    for (std::size_t i = 0; i != num_names; ++i)
+    {
+        HPX_TEST_EQ(hpx::unregister_with_basename(test_basename, i).get(),
+            components[i]);
+    }
+}
+
+int hpx_main()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+        test_symbol_namespace_cache(
+            localities.empty() ? hpx::find_here() : localities[0]);
+    }
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
+#endif
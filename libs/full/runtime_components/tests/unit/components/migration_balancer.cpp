@@ -0,0 +1,163 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/serialization.hpp>
+#include <hpx/modules/async_colocated.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/runtime_distributed/load_balancing_support.hpp>
+#include <hpx/runtime_distributed/migration_balancer.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct test_server
+  : hpx::components::load_balancing_support<
+        hpx::components::component_base<test_server>>
+{
+    typedef hpx::components::load_balancing_support<
+        hpx::components::component_base<test_server>>
+        base_type;
+
+    test_server() = default;
+
+    test_server(test_server const& rhs)
+      : base_type(rhs)
+    {
+    }
+
+    test_server(test_server&& rhs)
+      : base_type(std::move(rhs))
+    {
+    }
+
+    test_server& operator=(test_server const&)
+    {
+        return *this;
+    }
+    test_server& operator=(test_server&&)
+    {
+        return *this;
+    }
+
+    // the load is measured as the time the action is running, so this has
+    // to actually compute something (suspending would not count)
+    double busy_work() const
+    {
+        double result = 0.0;
+        for (std::size_t i = 1; i != 1000000; ++i)
+        {
+            result += std::sqrt(static_cast<double>(i));
+        }
+        return result;
+    }
+
+    HPX_DEFINE_COMPONENT_ACTION(test_server, busy_work, busy_work_action)
+
+    template <typename Archive>
+    void serialize(Archive&, unsigned)
+    {
+    }
+};
+
+typedef hpx::components::component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server)
+
+typedef test_server::busy_work_action busy_work_action;
+HPX_REGISTER_ACTION_DECLARATION(busy_work_action)
+HPX_REGISTER_ACTION(busy_work_action)
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_components = 8;
+
+void busy_work(std::vector<hpx::id_type> const& components)
+{
+    std::vector<hpx::future<double>> work;
+    for (hpx::id_type const& id : components)
+    {
+        work.push_back(hpx::async<busy_work_action>(id));
+    }
+    for (hpx::future<double>& f : work)
+    {
+        HPX_TEST_LT(0.0, f.get());
+    }
+}
+
+std::size_t count_remote(std::vector<hpx::id_type> const& components)
+{
+    std::size_t result = 0;
+    for (hpx::id_type const& id : components)
+    {
+        if (hpx::get_colocation_id(hpx::launch::sync, id) != hpx::find_here())
+        {
+            ++result;
+        }
+    }
+    return result;
+}
+
+int main()
+{
+    if (hpx::find_remote_localities().empty())
+    {
+        return hpx::util::report_errors();
+    }
+
+    std::vector<hpx::id_type> components;
+    for (std::size_t i = 0; i != num_components; ++i)
+    {
+        components.push_back(hpx::new_<test_server>(hpx::find_here()).get());
+    }
+
+    hpx::components::migration_balancer_parameters params;
+    params.rounds = 2;
+    params.max_migrations = num_components;
+
+    // the load is concentrated on this locality, nothing is migrated during
+    // the first round as the locality has to be overloaded twice
+    busy_work(components);
+    HPX_TEST_EQ(hpx::components::balance_load(params), std::size_t(0));
+    HPX_TEST_EQ(count_remote(components), std::size_t(0));
+
+    // migrations may be vetoed
+    std::size_t vetoed = 0;
+    hpx::components::set_migration_veto_hook(
+        [&](hpx::id_type const&, hpx::id_type const& target) -> bool {
+            HPX_TEST_NEQ(target, hpx::find_here());
+            ++vetoed;
+            return true;
+        });
+
+    busy_work(components);
+    HPX_TEST_EQ(hpx::components::balance_load(params), std::size_t(0));
+    HPX_TEST_NEQ(vetoed, std::size_t(0));
+    HPX_TEST_EQ(count_remote(components), std::size_t(0));
+
+    // components are moved such that the load is roughly equal afterwards
+    hpx::components::set_migration_veto_hook(
+        hpx::components::migration_veto_hook_type());
+
+    busy_work(components);
+    std::size_t const migrated = hpx::components::balance_load(params);
+    HPX_TEST_LT(std::size_t(0), migrated);
+    HPX_TEST_LT(migrated, num_components);
+    HPX_TEST_EQ(count_remote(components), migrated);
+
+    // migrated components are still functional
+    busy_work(components);
+
+    return hpx::util::report_errors();
+}
+#endif
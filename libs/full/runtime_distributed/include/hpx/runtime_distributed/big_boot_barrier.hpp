@@ -36,6 +36,7 @@
 namespace hpx { namespace agas {
 
     struct notification_header;
+    struct forwarded_notification;
 
     struct HPX_EXPORT big_boot_barrier
     {
@@ -60,10 +61,20 @@ namespace hpx { namespace agas {
 
         std::vector<parcelset::endpoints_type> localities;
 
+        // If more localities than this connect to the root, the root
+        // notifies only this many of them directly; every notified locality
+        // forwards the notifications to the same number of others (see
+        // hpx.agas.bootstrap_fanout).
+        std::size_t const bootstrap_fanout;
+        bool const use_notification_tree;
+        std::vector<forwarded_notification> pending_notifications;
+
         void spin();
 
         void notify();
 
+        void send_notification_tree();
+
     public:
         struct scoped_lock
         {
@@ -87,12 +98,7 @@ namespace hpx { namespace agas {
             parcelset::endpoints_type const& endpoints_,
             util::runtime_configuration const& ini_);
 
-        ~big_boot_barrier()
-        {
-            hpx::move_only_function<void()>* f;
-            while (thunks.pop(f))
-                delete f;
-        }
+        ~big_boot_barrier();
 
         parcelset::locality here()
         {
@@ -127,6 +133,12 @@ namespace hpx { namespace agas {
 
         void add_thunk(hpx::move_only_function<void()>* f);
 
+        // Delay the notification of the given locality until it can be sent
+        // through the notification tree, returns false (leaving hdr alone)
+        // if no notification tree is used. Assumes that mtx is locked.
+        bool add_pending_notification(std::uint32_t locality_id,
+            parcelset::locality const& dest, notification_header&& hdr);
+
         void add_locality_endpoints(std::uint32_t locality_id,
             parcelset::endpoints_type const& endpoints);
     };
@@ -0,0 +1,175 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file load_balancing_support.hpp
+
+#pragma once
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/components_base/get_lva.hpp>
+#include <hpx/components_base/pinned_ptr.hpp>
+#include <hpx/components_base/server/migration_support.hpp>
+#include <hpx/components_base/traits/action_decorate_function.hpp>
+#include <hpx/functional/bind_front.hpp>
+#include <hpx/functional/function.hpp>
+#include <hpx/functional/one_shot.hpp>
+#include <hpx/futures/future.hpp>
+#include <hpx/modules/threading_base.hpp>
+#include <hpx/naming_base/id_type.hpp>
+#include <hpx/runtime_distributed/migrate_component.hpp>
+#include <hpx/runtime_distributed/migration_balancer.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+#include <hpx/timing/high_resolution_clock.hpp>
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace components {
+
+    /// This hook can be inserted into the derivation chain of any component
+    /// (instead of \a migration_support) for it to be considered by the
+    /// migration balancer (see \a balance_load). It measures the number of
+    /// actions invoked on the component and the time spent executing them.
+    /// The time an action is suspended (for instance while waiting for a
+    /// future) is not accounted for.
+    template <typename BaseComponent, typename Mutex = hpx::spinlock>
+    struct load_balancing_support : migration_support<BaseComponent, Mutex>
+    {
+    private:
+        using base_type = migration_support<BaseComponent, Mutex>;
+        using this_component_type =
+            typename BaseComponent::this_component_type;
+
+    public:
+        load_balancing_support() noexcept
+          : load_(&load_balancing_support::migrate_component)
+        {
+        }
+
+        template <typename T, typename... Ts,
+            typename Enable = std::enable_if_t<
+                !std::is_same_v<std::decay_t<T>, load_balancing_support>>>
+        explicit load_balancing_support(T&& t, Ts&&... ts)
+          : base_type(HPX_FORWARD(T, t), HPX_FORWARD(Ts, ts)...)
+          , load_(&load_balancing_support::migrate_component)
+        {
+        }
+
+        // the statistics are not transferred to copies of a component
+        load_balancing_support(load_balancing_support const& rhs)
+          : base_type(rhs)
+          , load_(&load_balancing_support::migrate_component)
+        {
+        }
+
+        load_balancing_support(load_balancing_support&& rhs)
+          : base_type(HPX_MOVE(rhs))
+          , load_(&load_balancing_support::migrate_component)
+        {
+        }
+
+        using decorates_action = void;
+
+        // This is the hook implementation for decorate_action which makes
+        // sure that the object becomes pinned during the execution of an
+        // action and which measures the execution time of the action.
+        template <typename F>
+        static threads::thread_function_type decorate_action(
+            naming::address_type lva, F&& f)
+        {
+            return util::one_shot(
+                hpx::bind_front(&load_balancing_support::thread_function,
+                    get_lva<this_component_type>::call(lva),
+                    traits::component_decorate_function<BaseComponent>::call(
+                        lva, HPX_FORWARD(F, f)),
+                    components::pinned_ptr::create<this_component_type>(lva)));
+        }
+
+    protected:
+        using yield_decorator_type = hpx::function<threads::thread_arg_type(
+            threads::thread_result_type)>;
+
+        // Accumulate the time the current HPX thread is actually running.
+        // The measurement is paused whenever the thread is suspended, any
+        // yield decorator registered before is invoked for those.
+        struct exec_time_wrapper
+        {
+            exec_time_wrapper()
+              : start_(hpx::chrono::high_resolution_clock::now())
+              , exec_time_(0)
+            {
+                yield_decorator_ = threads::get_self().decorate_yield(
+                    hpx::bind_front(&exec_time_wrapper::yield_function, this));
+            }
+
+            exec_time_wrapper(exec_time_wrapper const&) = delete;
+            exec_time_wrapper(exec_time_wrapper&&) = delete;
+            exec_time_wrapper& operator=(exec_time_wrapper const&) = delete;
+            exec_time_wrapper& operator=(exec_time_wrapper&&) = delete;
+
+            ~exec_time_wrapper()
+            {
+                threads::get_self().decorate_yield(HPX_MOVE(yield_decorator_));
+            }
+
+            std::uint64_t get_exec_time() const
+            {
+                return exec_time_ + hpx::chrono::high_resolution_clock::now() -
+                    start_;
+            }
+
+            threads::thread_arg_type yield_function(
+                threads::thread_result_type state)
+            {
+                exec_time_ +=
+                    hpx::chrono::high_resolution_clock::now() - start_;
+
+                threads::thread_arg_type result = yield_decorator_.empty() ?
+                    threads::get_self().yield_impl(HPX_MOVE(state)) :
+                    yield_decorator_(HPX_MOVE(state));
+
+                start_ = hpx::chrono::high_resolution_clock::now();
+                return result;
+            }
+
+            std::uint64_t start_;
+            std::uint64_t exec_time_;
+            yield_decorator_type yield_decorator_;
+        };
+
+        // Execute the wrapped action while the component is pinned and
+        // account for the time it was running.
+        threads::thread_result_type thread_function(
+            threads::thread_function_type&& f, components::pinned_ptr,
+            threads::thread_restart_state state)
+        {
+            if (!load_.is_registered())
+            {
+                load_.register_component(this->get_unmanaged_id().get_gid());
+            }
+
+            exec_time_wrapper exec_time;
+            threads::thread_result_type result = f(state);
+
+            load_.add_invocation(exec_time.get_exec_time());
+
+            return result;
+        }
+
+    private:
+        static hpx::future<hpx::id_type> migrate_component(
+            hpx::id_type const& to_migrate, hpx::id_type const& target)
+        {
+            return components::migrate<this_component_type>(
+                to_migrate, target);
+        }
+
+        detail::component_load load_;
+    };
+}}    // namespace hpx::components
+#endif
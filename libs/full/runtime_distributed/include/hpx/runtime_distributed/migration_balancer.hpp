@@ -0,0 +1,157 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file migration_balancer.hpp
+
+#pragma once
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/functional/function.hpp>
+#include <hpx/futures/future.hpp>
+#include <hpx/naming_base/gid_type.hpp>
+#include <hpx/naming_base/id_type.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace components {
+
+    /// Parameters controlling the migration balancer.
+    ///
+    /// A locality is considered to be overloaded (underloaded) if the
+    /// execution time of the actions invoked on its components exceeds
+    /// (falls below) the average execution time of all localities by more
+    /// than \a imbalance_threshold (relative to the average). Components are
+    /// migrated away from a locality only if it has been overloaded for
+    /// \a rounds consecutive balancing rounds, and only components which
+    /// have been resident on their locality for at least \a rounds balancing
+    /// rounds are migrated.
+    struct migration_balancer_parameters
+    {
+        /// The time between two balancing rounds
+        std::chrono::milliseconds interval = std::chrono::milliseconds(1000);
+
+        /// The relative deviation from the average load which makes a
+        /// locality overloaded or underloaded
+        double imbalance_threshold = 0.2;
+
+        /// The number of consecutive rounds a locality has to be overloaded
+        /// before components are migrated away from it
+        std::size_t rounds = 2;
+
+        /// The maximal number of components migrated away from one locality
+        /// in one balancing round
+        std::size_t max_migrations = 8;
+    };
+
+    /// The type of the function which may veto the migration of a
+    /// component (see \a set_migration_veto_hook). It is invoked with the
+    /// (unmanaged) id of the component and the id of the target locality and
+    /// returns true if the component must not be migrated.
+    using migration_veto_hook_type =
+        hpx::function<bool(hpx::id_type const&, hpx::id_type const&)>;
+
+    /// Install a function which is invoked on this locality before any of
+    /// the components located here is migrated by the migration balancer.
+    /// The function may veto the migration by returning true.
+    ///
+    /// \returns The previously installed function.
+    HPX_EXPORT migration_veto_hook_type set_migration_veto_hook(
+        migration_veto_hook_type hook);
+
+    /// Perform one balancing round: collect the load of all localities and
+    /// migrate components from overloaded to underloaded localities. Only
+    /// components using \a load_balancing_support are taken into account.
+    ///
+    /// \note This function has to be invoked from an HPX thread, it returns
+    ///       after all migration operations have finished.
+    ///
+    /// \returns The number of migrated components.
+    HPX_EXPORT std::size_t balance_load(
+        migration_balancer_parameters const& params =
+            migration_balancer_parameters());
+
+    /// Start invoking \a balance_load periodically on this locality.
+    ///
+    /// \returns false if the migration balancer was already running.
+    HPX_EXPORT bool start_migration_balancer(
+        migration_balancer_parameters const& params =
+            migration_balancer_parameters());
+
+    /// Stop the periodic invocation of \a balance_load on this locality.
+    ///
+    /// \returns false if the migration balancer was not running.
+    HPX_EXPORT bool stop_migration_balancer();
+
+    namespace detail {
+
+        ///////////////////////////////////////////////////////////////////////
+        // The execution statistics of one component instance, maintained by
+        // load_balancing_support. The statistics are registered with the
+        // migration balancer of the locality on first use.
+        class HPX_EXPORT component_load
+        {
+        public:
+            using migrate_function_type = hpx::future<hpx::id_type> (*)(
+                hpx::id_type const&, hpx::id_type const&);
+
+            explicit component_load(migrate_function_type f) noexcept
+              : migrate_(f)
+            {
+            }
+
+            component_load(component_load const&) = delete;
+            component_load(component_load&&) = delete;
+            component_load& operator=(component_load const&) = delete;
+            component_load& operator=(component_load&&) = delete;
+
+            ~component_load();
+
+            bool is_registered() const noexcept
+            {
+                return registered_.load(std::memory_order_relaxed);
+            }
+
+            // Make the component with the given id known to the migration
+            // balancer
+            void register_component(naming::gid_type const& gid);
+
+            // Account for one action invocation which took the given time
+            // (in nanoseconds)
+            void add_invocation(std::uint64_t exec_time) noexcept
+            {
+                invocations_.fetch_add(1, std::memory_order_relaxed);
+                exec_time_.fetch_add(exec_time, std::memory_order_relaxed);
+            }
+
+        private:
+            friend class component_load_registry;
+
+            migrate_function_type const migrate_;
+
+            std::atomic<bool> registered_{false};
+            std::atomic<std::uint64_t> invocations_{0};
+            std::atomic<std::uint64_t> exec_time_{0};
+
+            // the members below are protected by the registry
+            naming::gid_type gid_;
+            std::uint64_t last_invocations_ = 0;
+            std::uint64_t last_exec_time_ = 0;
+            std::uint64_t invocation_rate_ = 0;    // during last round
+            std::uint64_t load_ = 0;               // during last round
+            std::size_t rounds_ = 0;
+        };
+    }    // namespace detail
+}}       // namespace hpx::components
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
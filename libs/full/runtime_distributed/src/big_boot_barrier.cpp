@@ -35,7 +35,9 @@
 #include <hpx/timing/high_resolution_clock.hpp>
 #include <hpx/topology/topology.hpp>
 #include <hpx/util/from_string.hpp>
+#include <hpx/util/get_entry_as.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -354,6 +356,11 @@ namespace hpx { namespace agas {
 
     // This structure is used in the response from node zero to the locality which
     // is trying to register (first roundtrip).
+    //
+    // If the notifications are sent through a tree, the endpoints of all
+    // localities are sent only once per message, and the notifications of
+    // the localities a locality has to notify in turn are embedded into its
+    // own notification (forward).
     struct notification_header
     {
         notification_header()
@@ -395,6 +402,7 @@ namespace hpx { namespace agas {
         parcelset::endpoints_type agas_endpoints;
         detail::assigned_id_sequence ids;
         std::vector<parcelset::endpoints_type> endpoints;
+        std::vector<forwarded_notification> forward;
 
         template <typename Archive>
         void serialize(Archive& ar, const unsigned int)
@@ -411,6 +419,39 @@ namespace hpx { namespace agas {
             ar & agas_endpoints;
             ar & ids;
             ar & endpoints;
+            ar & forward;
+            // clang-format on
+        }
+    };
+
+    // The notification of a locality which is sent by another locality
+    // (other than node zero) while bootstrapping.
+    struct forwarded_notification
+    {
+        forwarded_notification()
+          : locality_id(0)
+        {
+        }
+
+        forwarded_notification(std::uint32_t locality_id_,
+            parcelset::locality const& dest_, notification_header&& hdr_)
+          : locality_id(locality_id_)
+          , dest(dest_)
+          , hdr(HPX_MOVE(hdr_))
+        {
+        }
+
+        std::uint32_t locality_id;
+        parcelset::locality dest;
+        notification_header hdr;
+
+        template <typename Archive>
+        void serialize(Archive& ar, const unsigned int)
+        {
+            // clang-format off
+            ar & locality_id;
+            ar & dest;
+            ar & hdr;
             // clang-format on
         }
     };
@@ -540,7 +581,9 @@ namespace hpx { namespace agas {
                 notify_worker_action(), HPX_MOVE(hdr));
         }
 
-        else
+        else if (!bbb.add_pending_notification(
+                     naming::get_locality_id_from_gid(prefix), dest,
+                     HPX_MOVE(hdr)))
         {
             // AGAS is starting up; this locality is participating in startup
             // synchronization.
@@ -615,6 +658,20 @@ namespace hpx { namespace agas {
 
         // pre-cache all known locality endpoints in local AGAS
         agas_client.pre_cache_endpoints(header.endpoints);
+
+        // pass on the notifications this locality is responsible for
+        big_boot_barrier& bbb = get_big_boot_barrier();
+        std::uint32_t const locality_id =
+            naming::get_locality_id_from_gid(header.prefix);
+
+        for (forwarded_notification const& f : header.forward)
+        {
+            notification_header hdr(f.hdr);
+            hdr.endpoints = header.endpoints;
+
+            bbb.apply(locality_id, f.locality_id, f.dest,
+                notify_worker_action(), HPX_MOVE(hdr));
+        }
     }
     // }}}
 
@@ -627,6 +684,73 @@ namespace hpx { namespace agas {
             notify_worker_action(), HPX_MOVE(hdr));
     }
 
+    bool big_boot_barrier::add_pending_notification(std::uint32_t locality_id,
+        parcelset::locality const& dest, notification_header&& hdr)
+    {
+        if (!use_notification_tree)
+        {
+            return false;
+        }
+
+        pending_notifications.emplace_back(locality_id, dest, HPX_MOVE(hdr));
+        return true;
+    }
+
+    // The notifications are sent through a complete tree with a fan-out of
+    // bootstrap_fanout (ordered by locality id) rooted at node zero. This
+    // limits the number of messages sent by node zero to bootstrap_fanout,
+    // each of which carries the endpoints of all localities only once.
+    void big_boot_barrier::send_notification_tree()
+    {
+        std::vector<forwarded_notification> nodes;
+
+        {
+            std::lock_guard<std::mutex> l(mtx);
+            std::swap(nodes, pending_notifications);
+        }
+
+        if (nodes.empty())
+        {
+            return;
+        }
+
+        std::sort(nodes.begin(), nodes.end(),
+            [](forwarded_notification const& lhs,
+                forwarded_notification const& rhs) {
+                return lhs.locality_id < rhs.locality_id;
+            });
+
+        // node zero notifies nodes [0, k), node i notifies the nodes
+        // [(i + 1) * k, (i + 2) * k), build the subtrees bottom up
+        std::size_t const k = bootstrap_fanout;
+        for (std::size_t i = nodes.size(); i-- != 0;)
+        {
+            std::size_t const first = (i + 1) * k;
+            if (first >= nodes.size())
+            {
+                continue;
+            }
+
+            std::size_t const last = (std::min)(first + k, nodes.size());
+            std::vector<forwarded_notification>& forward = nodes[i].hdr.forward;
+
+            forward.reserve(last - first);
+            for (std::size_t c = first; c != last; ++c)
+            {
+                forward.push_back(HPX_MOVE(nodes[c]));
+            }
+        }
+
+        std::size_t const num_direct = (std::min)(k, nodes.size());
+        for (std::size_t i = 0; i != num_direct; ++i)
+        {
+            forwarded_notification& n = nodes[i];
+            n.hdr.endpoints = localities;
+            apply(0, n.locality_id, n.dest, notify_worker_action(),
+                HPX_MOVE(n.hdr));
+        }
+    }
+
     void big_boot_barrier::add_locality_endpoints(std::uint32_t locality_id,
         parcelset::endpoints_type const& endpoints_data)
     {
@@ -668,6 +792,17 @@ namespace hpx { namespace agas {
         return result;
     }
 
+    inline bool requires_notification_tree(
+        util::runtime_configuration const& ini, std::size_t fanout)
+    {
+        if (service_mode_bootstrap != ini.get_agas_service_mode() ||
+            fanout == 0)
+        {
+            return false;
+        }
+        return get_number_of_bootstrap_connections(ini) > fanout;
+    }
+
     big_boot_barrier::big_boot_barrier(parcelset::parcelport* pp_,
         parcelset::endpoints_type const& endpoints_,
         util::runtime_configuration const& ini_)
@@ -679,6 +814,10 @@ namespace hpx { namespace agas {
       , mtx()
       , connected(get_number_of_bootstrap_connections(ini_))
       , thunks(32)
+      , bootstrap_fanout(util::get_entry_as<std::size_t>(
+            ini_, "hpx.agas.bootstrap_fanout", 16))
+      , use_notification_tree(
+            requires_notification_tree(ini_, bootstrap_fanout))
     {
         // register all not registered typenames
         if (service_type == service_mode_bootstrap)
@@ -689,6 +828,13 @@ namespace hpx { namespace agas {
         }
     }
 
+    big_boot_barrier::~big_boot_barrier()
+    {
+        hpx::move_only_function<void()>* f;
+        while (thunks.pop(f))
+            delete f;
+    }
+
     void big_boot_barrier::wait_bootstrap()
     {    // {{{
         HPX_ASSERT(service_mode_bootstrap == service_type);
@@ -802,6 +948,8 @@ namespace hpx { namespace agas {
                 }
                 delete p;
             }
+
+            send_notification_tree();
         }
     }
 
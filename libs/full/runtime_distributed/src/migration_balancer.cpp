@@ -0,0 +1,431 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/actions_base/plain_action.hpp>
+#include <hpx/async_combinators/wait_all.hpp>
+#include <hpx/async_distributed/async.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/logging.hpp>
+#include <hpx/naming_base/gid_type.hpp>
+#include <hpx/naming_base/id_type.hpp>
+#include <hpx/runtime_distributed/find_all_localities.hpp>
+#include <hpx/runtime_distributed/migration_balancer.hpp>
+#include <hpx/runtime_local/interval_timer.hpp>
+#include <hpx/runtime_local/shutdown_function.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace components { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // All components located on this locality which are considered by the
+    // migration balancer
+    class component_load_registry
+    {
+        using mutex_type = hpx::spinlock;
+
+    public:
+        struct candidate
+        {
+            naming::gid_type gid;
+            component_load::migrate_function_type migrate;
+            std::uint64_t load;
+            std::uint64_t invocation_rate;
+        };
+
+        static component_load_registry& get()
+        {
+            static component_load_registry registry;
+            return registry;
+        }
+
+        void add(component_load& load, naming::gid_type const& gid)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            if (!load.registered_.load(std::memory_order_relaxed))
+            {
+                load.gid_ = naming::detail::get_stripped_gid(gid);
+                loads_.insert(&load);
+                load.registered_.store(true, std::memory_order_relaxed);
+            }
+        }
+
+        void remove(component_load& load)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            loads_.erase(&load);
+        }
+
+        // Update the statistics of all components, return the overall time
+        // spent executing actions on all components since the last call
+        std::uint64_t collect()
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            std::uint64_t result = 0;
+            for (component_load* load : loads_)
+            {
+                std::uint64_t const exec_time =
+                    load->exec_time_.load(std::memory_order_relaxed);
+                std::uint64_t const invocations =
+                    load->invocations_.load(std::memory_order_relaxed);
+
+                load->load_ = exec_time - load->last_exec_time_;
+                load->invocation_rate_ =
+                    invocations - load->last_invocations_;
+                load->last_exec_time_ = exec_time;
+                load->last_invocations_ = invocations;
+                ++load->rounds_;
+
+                result += load->load_;
+            }
+            return result;
+        }
+
+        // Return all components which have been resident for at least the
+        // given number of rounds, most loaded first
+        std::vector<candidate> get_candidates(std::size_t min_rounds)
+        {
+            std::vector<candidate> result;
+
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                result.reserve(loads_.size());
+                for (component_load* load : loads_)
+                {
+                    if (load->rounds_ >= min_rounds && load->load_ != 0)
+                    {
+                        result.push_back(candidate{load->gid_, load->migrate_,
+                            load->load_, load->invocation_rate_});
+                    }
+                }
+            }
+
+            std::sort(result.begin(), result.end(),
+                [](candidate const& lhs, candidate const& rhs) {
+                    if (lhs.load != rhs.load)
+                    {
+                        return lhs.load > rhs.load;
+                    }
+                    return lhs.invocation_rate > rhs.invocation_rate;
+                });
+
+            return result;
+        }
+
+        migration_veto_hook_type set_veto_hook(migration_veto_hook_type hook)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            std::swap(hook, veto_hook_);
+            return hook;
+        }
+
+        migration_veto_hook_type get_veto_hook()
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            return veto_hook_;
+        }
+
+    private:
+        mutex_type mtx_;
+        std::unordered_set<component_load*> loads_;
+        migration_veto_hook_type veto_hook_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    component_load::~component_load()
+    {
+        if (registered_.load(std::memory_order_relaxed))
+        {
+            component_load_registry::get().remove(*this);
+        }
+    }
+
+    void component_load::register_component(naming::gid_type const& gid)
+    {
+        component_load_registry::get().add(*this, gid);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::uint64_t collect_component_loads()
+    {
+        return component_load_registry::get().collect();
+    }
+
+    // Migrate components with an overall load of at most 'amount' to the
+    // given locality, return the number of migrated components
+    std::size_t shed_component_load(hpx::id_type const& target,
+        std::uint64_t amount, std::size_t min_rounds,
+        std::size_t max_migrations)
+    {
+        component_load_registry& registry = component_load_registry::get();
+
+        std::vector<component_load_registry::candidate> candidates =
+            registry.get_candidates(min_rounds);
+        migration_veto_hook_type hook = registry.get_veto_hook();
+
+        std::vector<hpx::future<hpx::id_type>> migrated;
+        for (auto const& c : candidates)
+        {
+            if (migrated.size() == max_migrations || amount == 0)
+            {
+                break;
+            }
+
+            if (c.load > amount)
+            {
+                continue;    // would overload the target
+            }
+
+            hpx::id_type id(c.gid, hpx::id_type::management_type::unmanaged);
+            if (hook && hook(id, target))
+            {
+                continue;    // vetoed by user
+            }
+
+            migrated.push_back(c.migrate(id, target));
+            amount -= c.load;
+        }
+
+        hpx::wait_all(migrated);
+
+        std::size_t result = 0;
+        for (hpx::future<hpx::id_type>& f : migrated)
+        {
+            if (f.has_exception())
+            {
+                // the component may have been deleted or migrated in the
+                // meantime
+                LRT_(warning).format("shed_component_load: failed to "
+                                     "migrate component: {}",
+                    hpx::diagnostic_information(f.get_exception_ptr()));
+                continue;
+            }
+            ++result;
+        }
+        return result;
+    }
+}}}    // namespace hpx::components::detail
+
+HPX_PLAIN_ACTION(hpx::components::detail::collect_component_loads,
+    collect_component_loads_action)
+HPX_PLAIN_ACTION(
+    hpx::components::detail::shed_component_load, shed_component_load_action)
+
+namespace hpx { namespace components {
+
+    namespace detail {
+
+        ///////////////////////////////////////////////////////////////////////
+        // The state of the balancer maintained on the locality running the
+        // balancing rounds
+        struct migration_balancer
+        {
+            using mutex_type = hpx::spinlock;
+
+            static migration_balancer& get()
+            {
+                static migration_balancer balancer;
+                return balancer;
+            }
+
+            // Update the number of consecutive rounds the given locality was
+            // overloaded, return whether it is overloaded for long enough
+            bool update_overloaded(std::uint32_t locality_id,
+                bool is_overloaded, std::size_t rounds)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (!is_overloaded)
+                {
+                    overloaded_rounds_.erase(locality_id);
+                    return false;
+                }
+                return ++overloaded_rounds_[locality_id] >= rounds;
+            }
+
+            mutex_type mtx_;
+            std::map<std::uint32_t, std::size_t> overloaded_rounds_;
+            std::unique_ptr<util::interval_timer> timer_;
+        };
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    migration_veto_hook_type set_migration_veto_hook(
+        migration_veto_hook_type hook)
+    {
+        return detail::component_load_registry::get().set_veto_hook(
+            HPX_MOVE(hook));
+    }
+
+    std::size_t balance_load(migration_balancer_parameters const& params)
+    {
+        std::vector<hpx::id_type> const localities = hpx::find_all_localities();
+        if (localities.size() < 2)
+        {
+            return 0;
+        }
+
+        std::vector<hpx::future<std::uint64_t>> lazy_loads;
+        lazy_loads.reserve(localities.size());
+        for (hpx::id_type const& loc : localities)
+        {
+            lazy_loads.push_back(
+                hpx::async(collect_component_loads_action(), loc));
+        }
+
+        std::vector<double> loads;
+        loads.reserve(localities.size());
+
+        double total = 0.0;
+        for (hpx::future<std::uint64_t>& f : lazy_loads)
+        {
+            loads.push_back(static_cast<double>(f.get()));
+            total += loads.back();
+        }
+
+        double const mean = total / static_cast<double>(loads.size());
+        double const upper = mean * (1.0 + params.imbalance_threshold);
+        double const lower = mean * (1.0 - params.imbalance_threshold);
+
+        detail::migration_balancer& balancer =
+            detail::migration_balancer::get();
+
+        std::vector<std::size_t> overloaded;
+        std::vector<std::size_t> underloaded;
+        for (std::size_t i = 0; i != localities.size(); ++i)
+        {
+            if (balancer.update_overloaded(
+                    naming::get_locality_id_from_id(localities[i]),
+                    mean != 0.0 && loads[i] > upper, params.rounds))
+            {
+                overloaded.push_back(i);
+            }
+            else if (loads[i] < lower)
+            {
+                underloaded.push_back(i);
+            }
+        }
+
+        if (overloaded.empty() || underloaded.empty())
+        {
+            return 0;
+        }
+
+        std::sort(overloaded.begin(), overloaded.end(),
+            [&](std::size_t lhs, std::size_t rhs) {
+                return loads[lhs] > loads[rhs];
+            });
+
+        // move the excess load of each overloaded locality to the currently
+        // least loaded locality
+        std::vector<hpx::future<std::size_t>> lazy_migrated;
+        for (std::size_t i : overloaded)
+        {
+            auto it = std::min_element(underloaded.begin(), underloaded.end(),
+                [&](std::size_t lhs, std::size_t rhs) {
+                    return loads[lhs] < loads[rhs];
+                });
+
+            std::size_t const target = *it;
+            if (loads[target] >= lower)
+            {
+                break;
+            }
+
+            double const amount =
+                (std::min)(loads[i] - mean, mean - loads[target]);
+            loads[i] -= amount;
+            loads[target] += amount;
+
+            lazy_migrated.push_back(hpx::async(shed_component_load_action(),
+                localities[i], localities[target],
+                static_cast<std::uint64_t>(amount), params.rounds,
+                params.max_migrations));
+        }
+
+        std::size_t result = 0;
+        for (hpx::future<std::size_t>& f : lazy_migrated)
+        {
+            result += f.get();
+        }
+        return result;
+    }
+
+    bool start_migration_balancer(migration_balancer_parameters const& params)
+    {
+        detail::migration_balancer& balancer =
+            detail::migration_balancer::get();
+
+        {
+            std::lock_guard<detail::migration_balancer::mutex_type> l(
+                balancer.mtx_);
+            if (balancer.timer_)
+            {
+                return false;
+            }
+
+            balancer.timer_ = std::make_unique<util::interval_timer>(
+                [params]() -> bool {
+                    try
+                    {
+                        balance_load(params);
+                    }
+                    catch (hpx::exception const& e)
+                    {
+                        LRT_(error).format(
+                            "migration balancer: balancing round failed: {}",
+                            e.what());
+                    }
+                    return true;
+                },
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    params.interval)
+                    .count(),
+                "migration_balancer", true);
+        }
+
+        // make sure no balancing rounds are run while the runtime is shutting
+        // down and the timer is not destroyed after the runtime is gone
+        register_pre_shutdown_function([]() { stop_migration_balancer(); });
+
+        std::lock_guard<detail::migration_balancer::mutex_type> l(
+            balancer.mtx_);
+        return balancer.timer_ && balancer.timer_->start(false);
+    }
+
+    bool stop_migration_balancer()
+    {
+        detail::migration_balancer& balancer =
+            detail::migration_balancer::get();
+
+        std::unique_ptr<util::interval_timer> timer;
+        {
+            std::lock_guard<detail::migration_balancer::mutex_type> l(
+                balancer.mtx_);
+            std::swap(timer, balancer.timer_);
+        }
+
+        if (!timer)
+        {
+            return false;
+        }
+
+        timer->stop(true);
+        return true;
+    }
+}}    // namespace hpx::components
@@ -35,6 +35,7 @@
 #include <hpx/performance_counters/manage_counter_type.hpp>
 #include <hpx/performance_counters/query_counters.hpp>
 #include <hpx/performance_counters/registry.hpp>
+#include <hpx/resiliency/async_replay_checkpoint.hpp>
 #include <hpx/runtime_components/components_fwd.hpp>
 #include <hpx/runtime_components/console_error_sink.hpp>
 #include <hpx/runtime_components/console_logging.hpp>
@@ -366,6 +367,9 @@ namespace hpx {
 
 #if defined(HPX_HAVE_NETWORKING)
             parcel_handler_.enable_alternative_parcelports();
+
+            // pre-establish connections to the other localities, if requested
+            parcel_handler_.warm_up_connections();
 #endif
             // reset all counters right before running main, if requested
             if (get_config_entry("hpx.print_counter.startup", "0") == "1")
@@ -1228,6 +1232,35 @@ namespace hpx {
         performance_counters::install_counter_types(arithmetic_counter_types,
             sizeof(arithmetic_counter_types) /
                 sizeof(arithmetic_counter_types[0]));
+
+        // counters related to the checkpointing replay
+        performance_counters::install_counter_type(
+            "/resiliency/count/checkpoints",
+            &resiliency::experimental::get_replay_checkpoint_count,
+            "returns the number of checkpoints taken by "
+            "async_replay_checkpoint on this locality");
+        performance_counters::install_counter_type(
+            "/resiliency/count/checkpoint-bytes",
+            &resiliency::experimental::get_replay_checkpoint_bytes,
+            "returns the accumulated size of all checkpoints taken by "
+            "async_replay_checkpoint on this locality",
+            "bytes");
+        performance_counters::install_counter_type(
+            "/resiliency/count/resumed-replays",
+            &resiliency::experimental::get_replay_resumed_count,
+            "returns the number of replays on this locality which resumed "
+            "from a checkpoint");
+        performance_counters::install_counter_type(
+            "/resiliency/count/restarted-replays",
+            &resiliency::experimental::get_replay_restarted_count,
+            "returns the number of replays on this locality which had to "
+            "restart from scratch as no checkpoint was available");
+        performance_counters::install_counter_type(
+            "/resiliency/count/work-saved",
+            &resiliency::experimental::get_replay_work_saved,
+            "returns the accumulated progress (as reported by the "
+            "checkpoints) which did not have to be recomputed because a "
+            "replay resumed from a checkpoint on this locality");
     }
 
     ///////////////////////////////////////////////////////////////////////////
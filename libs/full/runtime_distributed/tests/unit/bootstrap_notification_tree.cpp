@@ -0,0 +1,82 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that all localities are able to talk to each other if the
+// bootstrap notifications are sent through a tree.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::uint32_t get_id()
+{
+    return hpx::get_locality_id();
+}
+HPX_PLAIN_ACTION(get_id)
+
+// Call get_id on all localities, starting from the given locality
+std::vector<std::uint32_t> get_all_ids()
+{
+    std::vector<hpx::future<std::uint32_t>> ids;
+    for (hpx::id_type const& loc : hpx::find_all_localities())
+    {
+        ids.push_back(hpx::async(get_id_action(), loc));
+    }
+
+    std::vector<std::uint32_t> result;
+    for (hpx::future<std::uint32_t>& f : ids)
+    {
+        result.push_back(f.get());
+    }
+    return result;
+}
+HPX_PLAIN_ACTION(get_all_ids)
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    std::vector<hpx::id_type> const localities = hpx::find_all_localities();
+    HPX_TEST_EQ(localities.size(),
+        std::size_t(hpx::get_num_localities(hpx::launch::sync)));
+
+    for (hpx::id_type const& loc : localities)
+    {
+        std::vector<std::uint32_t> const ids =
+            hpx::async(get_all_ids_action(), loc).get();
+
+        HPX_TEST_EQ(ids.size(), localities.size());
+        for (std::size_t i = 0; i != ids.size(); ++i)
+        {
+            HPX_TEST_EQ(ids[i], hpx::naming::get_locality_id_from_id(
+                                    localities[i]));
+        }
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // force the notifications to be sent through a tree of depth two for
+    // four localities
+    std::vector<std::string> const cfg = {"hpx.agas.bootstrap_fanout!=2"};
+
+    hpx::init_params init_args;
+    init_args.cfg = cfg;
+
+    HPX_TEST_EQ(hpx::init(argc, argv, init_args), 0);
+    return hpx::util::report_errors();
+}
+#endif
@@ -0,0 +1,162 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the rate at which small managed components can be
+// created on the local locality. Components are created one by one from
+// several concurrently running HPX threads (hpx::new_) and in bulk
+// (hpx::new_<T[]>).
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/iostream.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/modules/timing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct small_server : hpx::components::managed_component_base<small_server>
+{
+    std::int64_t value = 0;
+};
+
+using small_server_type = hpx::components::managed_component<small_server>;
+HPX_REGISTER_COMPONENT(small_server_type, small_server)
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<hpx::id_type> create_components(std::size_t count)
+{
+    std::vector<hpx::id_type> ids;
+    ids.reserve(count);
+
+    hpx::id_type const here = hpx::find_here();
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        ids.push_back(hpx::new_<small_server>(here).get());
+    }
+    return ids;
+}
+
+double measure_individual_creation(std::size_t count, std::size_t tasks)
+{
+    std::vector<hpx::future<std::vector<hpx::id_type>>> results;
+    results.reserve(tasks);
+
+    hpx::chrono::high_resolution_timer t;
+
+    for (std::size_t i = 0; i != tasks; ++i)
+    {
+        results.push_back(hpx::async(&create_components, count / tasks));
+    }
+    hpx::wait_all(results);
+
+    double const elapsed = t.elapsed();
+
+    // release all components outside of the measured region
+    results.clear();
+    return elapsed;
+}
+
+double measure_bulk_creation(std::size_t count, std::size_t tasks)
+{
+    std::vector<hpx::future<std::vector<hpx::id_type>>> results;
+    results.reserve(tasks);
+
+    hpx::id_type const here = hpx::find_here();
+
+    hpx::chrono::high_resolution_timer t;
+
+    for (std::size_t i = 0; i != tasks; ++i)
+    {
+        results.push_back(hpx::new_<small_server[]>(here, count / tasks));
+    }
+    hpx::wait_all(results);
+
+    double const elapsed = t.elapsed();
+
+    results.clear();
+    return elapsed;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    std::size_t const count = vm["count"].as<std::size_t>();
+    std::size_t tasks = vm["tasks"].as<std::size_t>();
+    std::size_t const repetitions = vm["repetitions"].as<std::size_t>();
+
+    if (tasks == 0)
+    {
+        tasks = hpx::get_os_thread_count();
+    }
+
+    double individual = 0.0;
+    double bulk = 0.0;
+    for (std::size_t i = 0; i != repetitions; ++i)
+    {
+        individual += measure_individual_creation(count, tasks);
+        bulk += measure_bulk_creation(count, tasks);
+    }
+    individual /= repetitions;
+    bulk /= repetitions;
+
+    std::size_t const created = (count / tasks) * tasks;
+
+    if (vm.count("no-header") == 0)
+    {
+        hpx::cout << "mode,threads,tasks,components,time[s],rate[1/s]\n"
+                  << std::flush;
+    }
+
+    hpx::util::format_to(hpx::cout, "individual,{},{},{},{},{}\n",
+        hpx::get_os_thread_count(), tasks, created, individual,
+        created / individual)
+        << std::flush;
+    hpx::util::format_to(hpx::cout, "bulk,{},{},{},{},{}\n",
+        hpx::get_os_thread_count(), tasks, created, bulk, created / bulk)
+        << std::flush;
+
+    hpx::util::print_cdash_timing("ComponentCreationIndividual", individual);
+    hpx::util::print_cdash_timing("ComponentCreationBulk", bulk);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("count",
+            hpx::program_options::value<std::size_t>()->default_value(100000),
+            "number of components to create per repetition "
+            "(default: 100000)")
+        ("tasks",
+            hpx::program_options::value<std::size_t>()->default_value(0),
+            "number of concurrently creating HPX threads "
+            "(default: 0, i.e. number of worker threads)")
+        ("repetitions",
+            hpx::program_options::value<std::size_t>()->default_value(5),
+            "number of repetitions of the measurements (default: 5)")
+        ("no-header", "do not print out the csv header row")
+        ;
+    // clang-format on
+
+    hpx::init_params init_args;
+    init_args.desc_cmdline = cmdline;
+
+    return hpx::init(argc, argv, init_args);
+}
+#endif
@@ -0,0 +1,111 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This example benchmarks the time it takes to enter and exit a parallel
+// region using the fork_join_executor, once with the flat barrier and once
+// with the hierarchical (per NUMA domain) barrier. This is meant to be
+// compared to openmp_parallel_region.
+
+#include <hpx/local/chrono.hpp>
+#include <hpx/local/execution.hpp>
+#include <hpx/local/init.hpp>
+#include <hpx/local/runtime.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using hpx::execution::experimental::fork_join_executor;
+
+std::atomic<std::size_t> x(0);
+
+double benchmark_parallel_region(fork_join_executor::barrier_kind barrier,
+    fork_join_executor::loop_schedule schedule, std::uint64_t repetitions)
+{
+    fork_join_executor exec(barrier, hpx::threads::thread_priority::high,
+        hpx::threads::thread_stacksize::small_, schedule);
+
+    std::size_t const threads = hpx::get_num_worker_threads();
+    std::vector<std::size_t> const shape(threads);
+
+    // Do one warmup iteration
+    hpx::parallel::execution::bulk_sync_execute(
+        exec, [](std::size_t) { ++x; }, shape);
+
+    hpx::chrono::high_resolution_timer timer;
+    double total = 0.0;
+    double min_time = (std::numeric_limits<double>::max)();
+    double max_time = 0.0;
+
+    for (std::uint64_t i = 0; i < repetitions; ++i)
+    {
+        timer.restart();
+
+        hpx::parallel::execution::bulk_sync_execute(
+            exec, [](std::size_t) { ++x; }, shape);
+
+        double const t_parallel = timer.elapsed();
+        total += t_parallel;
+        min_time = (std::min)(min_time, t_parallel);
+        max_time = (std::max)(max_time, t_parallel);
+    }
+
+    std::cout << barrier << ", " << schedule << ", " << threads << ", "
+              << total / static_cast<double>(repetitions) << ", " << min_time
+              << ", " << max_time << '\n';
+
+    return total;
+}
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    std::uint64_t const repetitions = vm["repetitions"].as<std::uint64_t>();
+
+    std::cout << "barrier, schedule, threads, parallel region mean [s], "
+                 "min [s], max [s]\n";
+
+    for (auto const schedule : {
+             fork_join_executor::loop_schedule::static_,
+             fork_join_executor::loop_schedule::static_numa,
+         })
+    {
+        double const flat = benchmark_parallel_region(
+            fork_join_executor::barrier_kind::flat, schedule, repetitions);
+        double const hierarchical = benchmark_parallel_region(
+            fork_join_executor::barrier_kind::hierarchical, schedule,
+            repetitions);
+
+        std::string const suffix =
+            schedule == fork_join_executor::loop_schedule::static_ ?
+            "" :
+            "NUMA";
+        hpx::util::print_cdash_timing(
+            ("ForkJoinFlat" + suffix).c_str(), flat / repetitions);
+        hpx::util::print_cdash_timing(("ForkJoinHierarchical" + suffix).c_str(),
+            hierarchical / repetitions);
+    }
+
+    return hpx::local::finalize();
+}
+
+int main(int argc, char** argv)
+{
+    hpx::program_options::options_description desc_commandline;
+    desc_commandline.add_options()("repetitions",
+        hpx::program_options::value<std::uint64_t>()->default_value(100),
+        "Number of repetitions");
+
+    hpx::local::init_params init_args;
+    init_args.desc_cmdline = desc_commandline;
+
+    return hpx::local::init(hpx_main, argc, argv, init_args);
+}
@@ -40,8 +40,21 @@ std::vector<hpx::future<void>> create_tasks(
     return tasks;
 }
 
+template <typename Futures>
+void wait_for(Futures& futures, bool use_when_all)
+{
+    if (use_when_all)
+    {
+        hpx::when_all(futures).get();
+    }
+    else
+    {
+        hpx::wait_all(futures);
+    }
+}
+
 double wait_tasks(std::size_t num_samples, std::size_t num_tasks,
-    std::size_t num_chunks, std::size_t delay)
+    std::size_t num_chunks, std::size_t delay, bool use_when_all = false)
 {
     std::size_t num_chunk_tasks = ((num_tasks + num_chunks) / num_chunks) - 1;
     std::size_t last_num_chunk_tasks =
@@ -66,16 +79,18 @@ double wait_tasks(std::size_t num_samples, std::size_t num_tasks,
         hpx::chrono::high_resolution_timer t;
         if (num_chunks == 1)
         {
-            hpx::wait_all(chunks[0]);
+            wait_for(chunks[0], use_when_all);
         }
         else
         {
             for (std::size_t c = 0; c != num_chunks; ++c)
             {
                 chunk_results.push_back(
-                    hpx::async([&chunks, c]() { hpx::wait_all(chunks[c]); }));
+                    hpx::async([&chunks, c, use_when_all]() {
+                        wait_for(chunks[c], use_when_all);
+                    }));
             }
-            hpx::wait_all(chunk_results);
+            wait_for(chunk_results, use_when_all);
         }
         result += t.elapsed();
     }
@@ -114,6 +129,10 @@ int hpx_main(hpx::program_options::variables_map& vm)
     if (num_chunks != 1)
         elapsed_chunks = wait_tasks(num_samples, num_tasks, num_chunks, delay);
 
+    // fan-in all of the tasks using when_all
+    double elapsed_when_all =
+        wait_tasks(num_samples, num_tasks, 1, delay, true);
+
     if (header)
     {
         std::cout
@@ -131,6 +150,12 @@ int hpx_main(hpx::program_options::variables_map& vm)
         << std::endl;
     hpx::util::print_cdash_timing("WaitAll", elapsed_seq / num_tasks);
 
+    hpx::util::format_to(std::cout, "{:10},{:10},{:10},{:10},{:10.12}\n",
+        tasks_str, std::string("when_all"), delay_str, elapsed_when_all,
+        elapsed_when_all / num_tasks)
+        << std::endl;
+    hpx::util::print_cdash_timing("WhenAll", elapsed_when_all / num_tasks);
+
     if (num_chunks != 1)
     {
         hpx::util::format_to(std::cout,
@@ -0,0 +1,67 @@
+//  Copyright (c) 2022 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Convert binary log files written by the asynchronous logging backend
+// (hpx.logging.async.binary_file) into text.
+//
+// usage: hpxlogdecode <binary log file> [<output file>]
+
+#include <hpx/config.hpp>
+#include <hpx/modules/logging.hpp>
+
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char* argv[])
+{
+#if defined(HPX_HAVE_LOGGING)
+    if (argc < 2 || argc > 3)
+    {
+        std::cerr << "usage: hpxlogdecode <binary log file> [<output file>]\n";
+        return -1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in.is_open())
+    {
+        std::cerr << "hpxlogdecode: could not open input file: " << argv[1]
+                  << "\n";
+        return -1;
+    }
+
+    bool result = false;
+    if (argc == 3)
+    {
+        std::ofstream out(argv[2]);
+        if (!out.is_open())
+        {
+            std::cerr << "hpxlogdecode: could not open output file: "
+                      << argv[2] << "\n";
+            return -1;
+        }
+        result = hpx::util::logging::decode_binary_log(in, out);
+    }
+    else
+    {
+        result = hpx::util::logging::decode_binary_log(in, std::cout);
+    }
+
+    if (!result)
+    {
+        std::cerr << "hpxlogdecode: input is not a valid binary log file: "
+                  << argv[1] << "\n";
+        return -1;
+    }
+    return 0;
+#else
+    (void) argc;
+    (void) argv;
+
+    std::cerr << "hpxlogdecode: HPX was built without logging support (set "
+                 "HPX_WITH_LOGGING=ON)\n";
+    return -1;
+#endif
+}